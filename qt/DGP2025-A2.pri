@@ -18,12 +18,16 @@ WRL_DIR  = $$SOURCEDIR/wrl
 
 SOURCES += \
 	$$SOURCEDIR/core/Edges.cpp \
+	$$SOURCEDIR/core/ExternalHalfEdges.cpp \
 	$$SOURCEDIR/core/Faces.cpp \
 	$$SOURCEDIR/core/Graph.cpp \
+	$$SOURCEDIR/core/CsrGraph.cpp \
 	$$SOURCEDIR/core/HalfEdges.cpp \
 	$$SOURCEDIR/core/Partition.cpp \
+	$$SOURCEDIR/core/ConcurrentPartition.cpp \
 	$$SOURCEDIR/core/PolygonMesh.cpp \
 	$$SOURCEDIR/core/PolygonMeshTest.cpp \
+	$$SOURCEDIR/core/TriangleMesh.cpp \
 #
 	$$SOURCEDIR/gui/GuiAboutDialog.cpp \
 	$$SOURCEDIR/gui/GuiGLBuffer.cpp \
@@ -50,6 +54,9 @@ SOURCES += \
 #
 	$$SOURCEDIR/util/BBox.cpp \
 	$$SOURCEDIR/util/Endian.cpp \
+	$$SOURCEDIR/util/Hash.cpp \
+	$$SOURCEDIR/util/MappedFile.cpp \
+	$$SOURCEDIR/util/Parallel.cpp \
 	$$SOURCEDIR/util/StaticRotation.cpp \
 #
 	$$SOURCEDIR/wrl/Ply.cpp \
@@ -73,12 +80,16 @@ SOURCES += \
 
 HEADERS += \
 	$$SOURCEDIR/core/Edges.hpp \
+	$$SOURCEDIR/core/ExternalHalfEdges.hpp \
 	$$SOURCEDIR/core/Faces.hpp \
 	$$SOURCEDIR/core/Graph.hpp \
+	$$SOURCEDIR/core/CsrGraph.hpp \
 	$$SOURCEDIR/core/HalfEdges.hpp \
 	$$SOURCEDIR/core/Partition.hpp \
+	$$SOURCEDIR/core/ConcurrentPartition.hpp \
 	$$SOURCEDIR/core/PolygonMesh.hpp \
 	$$SOURCEDIR/core/PolygonMeshTest.hpp \
+	$$SOURCEDIR/core/TriangleMesh.hpp \
 #
 	$$SOURCEDIR/gui/GuiAboutDialog.hpp \
 	$$SOURCEDIR/gui/GuiGLBuffer.hpp \
@@ -109,6 +120,12 @@ HEADERS += \
 	$$SOURCEDIR/util/CastMacros.hpp \
 	$$SOURCEDIR/util/BBox.hpp \
 	$$SOURCEDIR/util/Endian.hpp \
+	$$SOURCEDIR/util/ExternalSort.hpp \
+	$$SOURCEDIR/util/Hash.hpp \
+	$$SOURCEDIR/util/Index.hpp \
+	$$SOURCEDIR/util/MappedFile.hpp \
+	$$SOURCEDIR/util/Parallel.hpp \
+	$$SOURCEDIR/util/SharedArray.hpp \
 	$$SOURCEDIR/util/StaticRotation.hpp \
 #
 	$$SOURCEDIR/wrl/Ply.hpp \
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// ConcurrentPartition.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#include "ConcurrentPartition.hpp"
+
+ConcurrentPartition::ConcurrentPartition(const Index nElements):
+  _nParts(0),
+  _parent()
+{
+  reset(nElements);
+}
+
+void ConcurrentPartition::reset(const Index nElements) {
+  Index n = (nElements>0)?nElements:0;
+  _nParts = n;
+  _parent = vector<atomic<Index>>(n);
+  for(Index i=0;i<n;i++)
+    _parent[i].store(i,memory_order_relaxed);
+}
+
+Index ConcurrentPartition::getNumberOfElements() const {
+  return static_cast<Index>(_parent.size());
+}
+
+Index ConcurrentPartition::getNumberOfParts() const {
+  return _nParts.load();
+}
+
+Index ConcurrentPartition::find(const Index i) {
+  if(i<0) return -1;
+  if(i>=getNumberOfElements()) return -1;
+  Index j = i;
+  for(;;) {
+    Index Pj  = _parent[j].load(memory_order_relaxed);
+    Index PPj = _parent[Pj].load(memory_order_relaxed);
+    if(Pj==PPj) return Pj;
+    // path halving : make j point to its grand parent
+    _parent[j].compare_exchange_weak(Pj,PPj,memory_order_relaxed);
+    j = PPj;
+  }
+}
+
+Index ConcurrentPartition::join(const Index i, const Index j) {
+  if(i<0 || i>=getNumberOfElements()) return -1;
+  if(j<0 || j>=getNumberOfElements()) return -1;
+  for(;;) {
+    Index Ri = find(i);
+    Index Rj = find(j);
+    if(Ri==Rj) return Ri;
+    // link the root with the larger index to the other one
+    if(Ri<Rj) { Index R=Ri; Ri=Rj; Rj=R; }
+    Index expected = Ri;
+    if(_parent[Ri].compare_exchange_strong(expected,Rj,memory_order_acq_rel)) {
+      _nParts.fetch_sub(1,memory_order_relaxed);
+      return Rj;
+    }
+    // Ri was linked by another thread; try again
+  }
+}
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// ConcurrentPartition.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#ifndef _CONCURRENT_PARTITION_HPP_
+#define _CONCURRENT_PARTITION_HPP_
+
+#include <vector>
+#include <atomic>
+#include "util/Index.hpp"
+
+using namespace std;
+
+class ConcurrentPartition {
+
+  // this class implements a concurrent version of the Union-Find data
+  // structure implemented by the Partition class; the find and join
+  // methods can be called from multiple threads at the same time
+  //
+  // - the parent of each element is stored in an atomic integer
+  // - find() uses path halving, where each node visited is made to
+  //   point to its grand parent with a compare and swap operation;
+  //   a failed compare and swap means that another thread has already
+  //   shortened the path, and it is ignored
+  // - join() links the root with the larger index to the root with
+  //   the smaller index, with a compare and swap operation which
+  //   fails if the root has been linked by another thread, in which
+  //   case the operation is retried
+  //
+  // since parents always have smaller indices than their children,
+  // no cycles can be created, and once all the join operations have
+  // been completed, the ID of each part is its smallest element,
+  // independently of the order in which the join operations were
+  // applied
+  //
+  // the roots are linked by index rather than by rank or size on
+  // purpose: callers rely on the ID being the smallest element, for
+  // example to visit each part once from its first corner, and the
+  // result does not depend on the scheduling of the threads; path
+  // halving alone keeps the amortized cost of find() logarithmic in
+  // the number of elements
+
+public:
+
+  // create a partition of the N elements {0,1,2,...,N-1} where
+  // every element is a singleton {0},{1},{2},...,{N-1}
+          ConcurrentPartition(const Index nElements);
+
+  // same as Partition::reset(); not thread safe
+  void    reset(const Index nElements);
+
+  // same as Partition::getNumberOfElements()
+  Index   getNumberOfElements()          const;
+
+  // same as Partition::getNumberOfParts(); the value is only
+  // meaningful when no join operations are in progress
+  Index   getNumberOfParts()             const;
+
+  // same as Partition::find(); thread safe
+  Index   find(const Index i);
+
+  // same as Partition::join(); thread safe
+  Index   join(const Index i, const Index j);
+
+private:
+
+  atomic<Index>       _nParts;
+  vector<atomic<Index>> _parent;
+
+};
+
+#endif /* _CONCURRENT_PARTITION_HPP_ */
@@ -0,0 +1,360 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// CsrGraph.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <algorithm>
+#include "CsrGraph.hpp"
+#include "Partition.hpp"
+#include "ConcurrentPartition.hpp"
+#include "util/Parallel.hpp"
+
+CsrGraph::CsrGraph():
+  _firstArc(1,0),
+  _arcNode(),
+  _arcEdge() {
+}
+
+void CsrGraph::clear() {
+  _firstArc.assign(1,0);
+  _arcNode.clear();
+  _arcEdge.clear();
+}
+
+void CsrGraph::_build(const Index nNodes, const ForEachArc& forEachArc) {
+  Index nN = (nNodes>0)?nNodes:0;
+
+  // 1) count the arcs leaving each node
+  vector<atomic<Index>> next(nN);
+  for(Index iN=0;iN<nN;iN++) next[iN].store(0,memory_order_relaxed);
+  forEachArc([&](Index iN, Index /*jN*/, Index /*iE*/) {
+    next[iN].fetch_add(1,memory_order_relaxed);
+  });
+
+  // 2) accumulate the counts into _firstArc, and reuse the counters
+  //    as the next free position in each list
+  _firstArc.assign(nN+1,0);
+  for(Index iN=0;iN<nN;iN++) {
+    _firstArc[iN+1] = _firstArc[iN]+next[iN].load(memory_order_relaxed);
+    next[iN].store(_firstArc[iN],memory_order_relaxed);
+  }
+  Index nA = _firstArc[nN];
+  _arcNode.assign(nA,-1);
+  _arcEdge.assign(nA,-1);
+
+  // 3) fill in the arcs
+  forEachArc([&](Index iN, Index jN, Index iE) {
+    Index iA = next[iN].fetch_add(1,memory_order_relaxed);
+    _arcNode[iA] = jN;
+    _arcEdge[iA] = iE;
+  });
+
+  // 4) the order of the arcs within each list depends on the order in
+  //    which the threads reached them; the (node,edge) pairs of each
+  //    list are sorted with std::sort, so that high valence nodes do
+  //    not make the build quadratic
+  Parallel::forRanges(nN,[&](Index /*iR*/, Index iN0, Index iN1) {
+    vector<pair<Index,Index>> arc;
+    for(Index iN=iN0;iN<iN1;iN++) {
+      Index iA0 = _firstArc[iN];
+      Index iA1 = _firstArc[iN+1];
+      if(iA1-iA0<2) continue;
+      arc.clear();
+      for(Index iA=iA0;iA<iA1;iA++)
+        arc.push_back(make_pair(_arcNode[iA],_arcEdge[iA]));
+      sort(arc.begin(),arc.end());
+      for(Index iA=iA0;iA<iA1;iA++) {
+        _arcNode[iA] = arc[iA-iA0].first;
+        _arcEdge[iA] = arc[iA-iA0].second;
+      }
+    }
+  });
+}
+
+void CsrGraph::buildGraph(const Edges& edges) {
+  Index nV = edges.getNumberOfVertices();
+  Index nE = edges.getNumberOfEdges();
+  _build(nV,[&](const function<void(Index,Index,Index)>& f) {
+    Parallel::forRanges(nE,[&](Index /*iR*/, Index iE0, Index iE1) {
+      for(Index iE=iE0;iE<iE1;iE++) {
+        Index iV0 = edges.getVertex0(iE);
+        Index iV1 = edges.getVertex1(iE);
+        // removed edges have negative vertex indices
+        if(iV0<0 || iV1<0) continue;
+        f(iV0,iV1,iE);
+        f(iV1,iV0,iE);
+      }
+    });
+  });
+}
+
+void CsrGraph::buildDualGraph(const HalfEdges& halfEdges) {
+  Index nE = halfEdges.getNumberOfEdges();
+  Index nC = halfEdges.getNumberOfCorners();
+
+  // the faces are numbered consecutively, so that the number of faces
+  // is one more than the face of the last corner
+  Index nF = 0;
+  for(Index iC=nC-1;iC>=0 && nF==0;iC--)
+    nF = halfEdges.getFace(iC)+1;
+
+  // visits the pairs of different faces incident to each edge
+  _build(nF,[&](const function<void(Index,Index,Index)>& f) {
+    Parallel::forRanges(nE,[&](Index /*iR*/, Index iE0, Index iE1) {
+      for(Index iE=iE0;iE<iE1;iE++) {
+        Index k = halfEdges.getNumberOfEdgeHalfEdges(iE);
+        if(k<2) continue;
+        for(Index a=0;a<k;a++) {
+          Index iF = halfEdges.getFace(halfEdges.getEdgeHalfEdge(iE,a));
+          for(Index b=0;b<k;b++) {
+            Index jF = halfEdges.getFace(halfEdges.getEdgeHalfEdge(iE,b));
+            if(a!=b && iF!=jF && iF>=0 && jF>=0) f(iF,jF,iE);
+          }
+        }
+      }
+    });
+  });
+}
+
+Index CsrGraph::getNumberOfNodes() const {
+  return static_cast<Index>(_firstArc.size())-1;
+}
+
+Index CsrGraph::getNumberOfArcs() const {
+  return static_cast<Index>(_arcNode.size());
+}
+
+Index CsrGraph::getNumberOfNeighbors(const Index iN) const {
+  if(iN<0 || iN>=getNumberOfNodes()) return 0;
+  return _firstArc[iN+1]-_firstArc[iN];
+}
+
+Index CsrGraph::getNeighbor(const Index iN, const Index j) const {
+  if(j<0 || j>=getNumberOfNeighbors(iN)) return -1;
+  return _arcNode[_firstArc[iN]+j];
+}
+
+Index CsrGraph::getArcEdge(const Index iN, const Index j) const {
+  if(j<0 || j>=getNumberOfNeighbors(iN)) return -1;
+  return _arcEdge[_firstArc[iN]+j];
+}
+
+const vector<Index>& CsrGraph::getFirstArc() const {
+  return _firstArc;
+}
+
+const vector<Index>& CsrGraph::getArcNode() const {
+  return _arcNode;
+}
+
+const vector<Index>& CsrGraph::getArcEdge() const {
+  return _arcEdge;
+}
+
+size_t CsrGraph::getMemoryUsage() const {
+  return sizeof(Index)*
+    (_firstArc.capacity()+_arcNode.capacity()+_arcEdge.capacity());
+}
+
+// algorithms
+
+void CsrGraph::getEdgeLengths
+(const Edges& edges, const vector<float>& coord, vector<double>& edgeLength) {
+  Index nE = edges.getNumberOfEdges();
+  Index nV = static_cast<Index>(coord.size()/3);
+  edgeLength.assign(nE,0.0);
+  Parallel::forRanges(nE,[&](Index /*iR*/, Index iE0, Index iE1) {
+    for(Index iE=iE0;iE<iE1;iE++) {
+      Index iV0 = edges.getVertex0(iE);
+      Index iV1 = edges.getVertex1(iE);
+      if(iV0<0 || iV0>=nV || iV1<0 || iV1>=nV) continue;
+      double dx = coord[3*iV1  ]-coord[3*iV0  ];
+      double dy = coord[3*iV1+1]-coord[3*iV0+1];
+      double dz = coord[3*iV1+2]-coord[3*iV0+2];
+      edgeLength[iE] = sqrt(dx*dx+dy*dy+dz*dz);
+    }
+  });
+}
+
+Index CsrGraph::getBreadthFirstLevels
+(const vector<Index>& sources, vector<Index>& level) const {
+  Index nN = getNumberOfNodes();
+
+  // the level of each node is set once, by the first thread which
+  // reaches it
+  vector<atomic<Index>> nodeLevel(nN);
+  for(Index iN=0;iN<nN;iN++) nodeLevel[iN].store(-1,memory_order_relaxed);
+
+  vector<Index> frontier;
+  for(Index iN : sources)
+    if(0<=iN && iN<nN && nodeLevel[iN].load(memory_order_relaxed)<0) {
+      nodeLevel[iN].store(0,memory_order_relaxed);
+      frontier.push_back(iN);
+    }
+
+  // level synchronous search; the nodes of each level are split into
+  // ranges, and each range produces its own part of the next level
+  Index nReached = static_cast<Index>(frontier.size());
+  for(Index d=1;frontier.empty()==false;d++) {
+    Index nFrontier = static_cast<Index>(frontier.size());
+    vector<vector<Index>> next(Parallel::getNumberOfRanges(nFrontier,1024));
+    Parallel::forRanges(nFrontier,[&](Index iR, Index i0, Index i1) {
+      for(Index i=i0;i<i1;i++) {
+        Index iN = frontier[i];
+        for(Index iA=_firstArc[iN];iA<_firstArc[iN+1];iA++) {
+          Index jN = _arcNode[iA];
+          Index expected = -1;
+          if(nodeLevel[jN].compare_exchange_strong(expected,d,memory_order_relaxed))
+            next[iR].push_back(jN);
+        }
+      }
+    },1024);
+    frontier.clear();
+    for(auto& nextR : next)
+      frontier.insert(frontier.end(),nextR.begin(),nextR.end());
+    nReached += static_cast<Index>(frontier.size());
+  }
+
+  level.resize(nN);
+  for(Index iN=0;iN<nN;iN++)
+    level[iN] = nodeLevel[iN].load(memory_order_relaxed);
+  return nReached;
+}
+
+Index CsrGraph::getConnectedComponents(vector<Index>& component) const {
+  Index nN = getNumberOfNodes();
+
+  // 1) join the two ends of every arc, from multiple threads; each
+  //    edge is joined once, from its lower node
+  ConcurrentPartition partition(nN);
+  Parallel::forRanges(nN,[&](Index /*iR*/, Index iN0, Index iN1) {
+    for(Index iN=iN0;iN<iN1;iN++)
+      for(Index iA=_firstArc[iN];iA<_firstArc[iN+1];iA++)
+        if(_arcNode[iA]>iN) partition.join(iN,_arcNode[iA]);
+  });
+
+  // 2) the representative of each part is its lowest node; number the
+  //    representatives in increasing order
+  component.resize(nN);
+  Parallel::forRanges(nN,[&](Index /*iR*/, Index iN0, Index iN1) {
+    for(Index iN=iN0;iN<iN1;iN++)
+      component[iN] = partition.find(iN);
+  });
+  Index nComponents = 0;
+  for(Index iN=0;iN<nN;iN++)
+    component[iN] = (component[iN]==iN)?nComponents++:component[component[iN]];
+  return nComponents;
+}
+
+double CsrGraph::getMinimumSpanningForest
+(const vector<double>& edgeLength, vector<Index>& forestEdges) const {
+  Index nN = getNumberOfNodes();
+  Index nL = static_cast<Index>(edgeLength.size());
+
+  // 1) one candidate (iN,iA) per edge, with iN<_arcNode[iA]
+  vector<pair<Index,Index>> candidate;
+  for(Index iN=0;iN<nN;iN++)
+    for(Index iA=_firstArc[iN];iA<_firstArc[iN+1];iA++)
+      if(_arcNode[iA]>iN && 0<=_arcEdge[iA] && _arcEdge[iA]<nL)
+        candidate.push_back(make_pair(iN,iA));
+
+  // 2) Kruskal : visit the candidates in increasing order of length,
+  //    and keep those which join two different parts
+  sort(candidate.begin(),candidate.end(),
+       [&](const pair<Index,Index>& a, const pair<Index,Index>& b) {
+         double la = edgeLength[_arcEdge[a.second]];
+         double lb = edgeLength[_arcEdge[b.second]];
+         return (la<lb || (la==lb && a.second<b.second));
+       });
+  Partition partition(nN);
+  forestEdges.clear();
+  double length = 0.0;
+  for(auto& c : candidate) {
+    Index iN = c.first;
+    Index jN = _arcNode[c.second];
+    if(partition.find(iN)==partition.find(jN)) continue;
+    partition.join(iN,jN);
+    forestEdges.push_back(_arcEdge[c.second]);
+    length += edgeLength[_arcEdge[c.second]];
+  }
+  return length;
+}
+
+Index CsrGraph::getShortestPaths
+(const vector<double>& edgeLength, const vector<Index>& sources,
+ vector<double>& distance, vector<Index>& parent) const {
+  Index nN = getNumberOfNodes();
+  Index nL = static_cast<Index>(edgeLength.size());
+  distance.assign(nN,numeric_limits<double>::infinity());
+  parent.assign(nN,-1);
+
+  // Dijkstra with a binary heap; nodes are pushed again when their
+  // distance decreases, and old entries are skipped when popped
+  typedef pair<double,Index> Entry;
+  priority_queue<Entry,vector<Entry>,greater<Entry>> queue;
+  for(Index iN : sources)
+    if(0<=iN && iN<nN && distance[iN]>0.0) {
+      distance[iN] = 0.0;
+      queue.push(Entry(0.0,iN));
+    }
+  Index nReached = 0;
+  while(queue.empty()==false) {
+    Entry e = queue.top();
+    queue.pop();
+    Index iN = e.second;
+    if(e.first>distance[iN]) continue;
+    nReached++;
+    for(Index iA=_firstArc[iN];iA<_firstArc[iN+1];iA++) {
+      Index iE = _arcEdge[iA];
+      if(iE<0 || iE>=nL) continue;
+      Index jN = _arcNode[iA];
+      double d = distance[iN]+edgeLength[iE];
+      if(d<distance[jN]) {
+        distance[jN] = d;
+        parent[jN] = iN;
+        queue.push(Entry(d,jN));
+      }
+    }
+  }
+  return nReached;
+}
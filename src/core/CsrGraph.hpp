@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// CsrGraph.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#ifndef _CSR_GRAPH_HPP_
+#define _CSR_GRAPH_HPP_
+
+#include <vector>
+#include <functional>
+#include "HalfEdges.hpp"
+
+using namespace std;
+
+class CsrGraph {
+
+  // - a static graph stored in compressed sparse row format: the
+  //   arcs leaving each node are stored consecutively, the arcs
+  //   leaving node iN being _firstArc[iN]<=iA<_firstArc[iN+1]
+  // - every undirected edge is stored as two arcs, one in each
+  //   direction, and each arc records the index of the edge of the
+  //   original structure from which it was derived
+  // - the arcs leaving each node are sorted by destination node, and
+  //   then by edge index, so that the result does not depend on the
+  //   number of threads used to build it
+
+public:
+
+  // create an empty graph with no nodes
+          CsrGraph();
+
+  // removes all the nodes and arcs
+  void    clear();
+
+  // snapshot of the edges, for example of a Graph; one node per
+  // vertex, and two arcs per edge; removed edges are skipped; built
+  // in parallel as buildDualGraph()
+  void    buildGraph(const Edges& edges);
+
+  // dual graph of the half edges; one node per face, and two arcs per
+  // pair of faces incident to the same edge; regular edges contribute
+  // one pair of arcs; the k half edges of a singular edge are found
+  // in the half edge to edge incidence list of the edge, and connect
+  // every pair of the k faces; arcs from a face to itself are not
+  // created; faces which share several edges are connected by
+  // several arcs, one per edge; the graph is built in parallel, from
+  // one traversal of the edges to count the arcs of each face, and a
+  // second one to fill them in
+  void    buildDualGraph(const HalfEdges& halfEdges);
+
+  Index   getNumberOfNodes()                        const;
+  Index   getNumberOfArcs()                         const;
+
+  // if the node index iN is in range, returns the number of arcs
+  // leaving the node; otherwise returns 0
+  Index   getNumberOfNeighbors(const Index iN)      const;
+
+  // if 0<=j<getNumberOfNeighbors(iN), return the destination node,
+  // and the edge index, of the j-th arc leaving the node iN;
+  // otherwise return -1
+  Index   getNeighbor(const Index iN, const Index j) const;
+  Index   getArcEdge(const Index iN, const Index j) const;
+
+  // direct access to the arrays, for algorithms which traverse the
+  // whole graph
+  const vector<Index>& getFirstArc()                const;
+  const vector<Index>& getArcNode()                 const;
+  const vector<Index>& getArcEdge()                 const;
+
+  // returns the number of bytes allocated by the internal arrays
+  size_t  getMemoryUsage()                          const;
+
+  // algorithms; the arc lengths used by the weighted algorithms are
+  // given per edge index, i.e. the length of the arc iA is
+  // edgeLength[getArcEdge()[iA]], and arcs with edge indices out of
+  // range are ignored
+
+  // fills edgeLength with the Euclidean length of each edge, computed
+  // from the vertex coordinates coord, stored as (x,y,z) triples, as
+  // in the IndexedFaceSet coord field; edges with vertices out of
+  // range have length 0
+  static void getEdgeLengths(const Edges& edges, const vector<float>& coord,
+                             vector<double>& edgeLength);
+
+  // breadth first search from all the source nodes at the same time;
+  // level[iN] is the number of arcs in the shortest path from a source
+  // to iN, or -1 if iN cannot be reached; the nodes of each level are
+  // visited in parallel; returns the number of nodes reached
+  Index   getBreadthFirstLevels(const vector<Index>& sources,
+                                vector<Index>& level) const;
+
+  // component[iN] is the connected component of the node iN;
+  // components are numbered in increasing order of their lowest node;
+  // the nodes are joined in parallel in a ConcurrentPartition;
+  // returns the number of components
+  Index   getConnectedComponents(vector<Index>& component) const;
+
+  // Kruskal's algorithm; fills forestEdges with the edge indices of a
+  // minimum spanning forest, in increasing order of length, and
+  // returns the total length of the forest
+  double  getMinimumSpanningForest(const vector<double>& edgeLength,
+                                   vector<Index>& forestEdges) const;
+
+  // Dijkstra's algorithm from all the source nodes at the same time;
+  // distance[iN] is the length of the shortest path from any source
+  // to iN, or infinity if iN cannot be reached, and parent[iN] is the
+  // previous node in that path, or -1 for sources and unreached
+  // nodes; returns the number of nodes reached
+  Index   getShortestPaths(const vector<double>& edgeLength,
+                           const vector<Index>& sources,
+                           vector<double>& distance,
+                           vector<Index>& parent) const;
+
+protected:
+
+  // calls f(iN,jN,iE) once for every arc from node iN to node jN
+  // derived from edge iE, possibly from several threads at the same
+  // time
+  typedef function<void(const function<void(Index,Index,Index)>&)> ForEachArc;
+
+  // builds the arrays; forEachArc is called twice, once to count the
+  // arcs leaving each node, and once to fill them in
+  void    _build(const Index nNodes, const ForEachArc& forEachArc);
+
+  // the array of arrays; _firstArc has getNumberOfNodes()+1 elements
+  vector<Index> _firstArc;
+  vector<Index> _arcNode;
+  vector<Index> _arcEdge;
+
+};
+
+#endif /* _CSR_GRAPH_HPP_ */
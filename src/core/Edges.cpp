@@ -40,85 +40,271 @@
 // DAMAGE.
 
 #include <math.h>
+#include <cstdint>
 #include "Edges.hpp"
 
+// static
+
+Edges::IndexType Edges::_defaultIndexType = Edges::HASH_TABLE;
+
+void Edges::setIndexType(const IndexType it) {
+  _defaultIndexType = it;
+}
+
+Edges::IndexType Edges::getIndexType() {
+  return _defaultIndexType;
+}
+
 // public methods
 
-Edges::Edges(const int nV):
+Edges::Edges(const Index nV):
+  _indexType(_defaultIndexType),
+  _nV(0),
+  _edge(),
   _first(),
-  _edge() {
+  _next(),
+  _table(),
+  _shift(64) {
   _reset(nV);
 }
 
-int Edges::getNumberOfVertices() const {
-  return static_cast<int>(_first.size());
+Index Edges::getNumberOfVertices() const {
+  return _nV;
 }
 
-// the _edge array contains a triple (iV0,iV1,next) for inserted edge
-int Edges::getNumberOfEdges() const {
-  return static_cast<int>(_edge.size()/3);
+// the _edge array contains a pair (iV0,iV1) for each inserted edge
+Index Edges::getNumberOfEdges() const {
+  return static_cast<Index>(_edge.size()/2);
 }
 
-int Edges::getEdge(int iV0, int iV1) const {
+Index Edges::getEdge(Index iV0, Index iV1) const {
   // edges with the same ends are not allowed
   if(iV0==iV1) return -1;
   // check that vertices are not out of range
-  int nV = getNumberOfVertices();
+  Index nV = getNumberOfVertices();
   if(iV0<0 || nV<=iV0) return -1;
   if(iV1<0 || nV<=iV1) return -1;
   // make sure that iV0<iV1
-  if(iV0>iV1) { int iV=iV0; iV0=iV1; iV1=iV; }
+  if(iV0>iV1) { Index iV=iV0; iV0=iV1; iV1=iV; }
+  if(_indexType==HASH_TABLE) {
+    // the slot is either empty, or it contains the edge
+    return _table[_findSlot(iV0,iV1)];
+  }
   // look for iV1 in the list of iV0
-  for(int j=_first[iV0];j>=0;j=/*next*/_edge[j+2])
-    if(/* _edge[j]==iV0 && */ _edge[j+1]==iV1)
-      // edge index is location of triple (iV0,iV1,next) in _edge
-      // array, regarded as an array of triples
-      return (j/3);
+  for(Index iE=_first[iV0];iE>=0;iE=_next[iE])
+    if(/* _edge[2*iE]==iV0 && */ _edge[2*iE+1]==iV1)
+      return iE;
   return -1;
 }
 
-int Edges::getVertex0(const int iE) const {
-  int nE = getNumberOfEdges();
+Index Edges::getVertex0(const Index iE) const {
+  Index nE = getNumberOfEdges();
   if(iE<0 || iE>=nE) return -1;
-  return _edge[3*iE  ];
+  return _edge[2*iE  ];
 }
 
-int Edges::getVertex1(const int iE) const {
-  int nE = getNumberOfEdges();
+Index Edges::getVertex1(const Index iE) const {
+  Index nE = getNumberOfEdges();
   if(iE<0 || iE>=nE) return -1;
-  return _edge[3*iE+1];
+  return _edge[2*iE+1];
 }
 
+size_t Edges::getMemoryUsage() const {
+  return sizeof(Index)*
+    (_edge.capacity()+_first.capacity()+_next.capacity()+_table.capacity());
+}
+
 // protected methods
 
-void Edges::_reset(const int nV) {
+void Edges::_reset(const Index nV) {
+  _nV = (nV>0)?nV:0;
   _edge.clear();
   _first.clear();
-  for(int iV=0;iV<nV;iV++)
-    _first.push_back(-1);
+  _next.clear();
+  _table.clear();
+  if(_indexType==HASH_TABLE) {
+    // the number of edges of a typical mesh is about three times the
+    // number of vertices; the table grows as needed
+    _rehash(16);
+  } else {
+    _first.assign(_nV,-1);
+  }
+}
+
+void Edges::_reserveEdges(const Index nE) {
+  if(_indexType!=HASH_TABLE) return;
+  _edge.reserve(2*static_cast<size_t>(nE));
+  Index tableSize = static_cast<Index>(_table.size());
+  while(tableSize<2*nE) tableSize *= 2;
+  if(tableSize>static_cast<Index>(_table.size()))
+    _rehash(tableSize);
 }
 
-int Edges::_insertEdge(int iV0, int iV1) {
+Index Edges::_insertEdge(Index iV0, Index iV1) {
   // edges with the same ends are not allowed
   if(iV0==iV1) return -1;
   // check that vertices are not out of range
-  int nV = getNumberOfVertices();
+  Index nV = getNumberOfVertices();
   if(iV0<0 || nV<=iV0) return -1;
   if(iV1<0 || nV<=iV1) return -1;
   // make sure that iV0<iV1
-  if(iV0>iV1) { int iV=iV0; iV0=iV1; iV1=iV; }
-  // if the edges has already been inserted, return the previously
-  // assigned edge index
-  int iE = getEdge(iV0,iV1); if(iE>=0) return iE;
+  if(iV0>iV1) { Index iV=iV0; iV0=iV1; iV1=iV; }
   // get the index of the next edge to be created
-  int j = static_cast<int>(_edge.size()); iE = j/3;
-  // append a new triple (iV0,iV1,*) to the _edge array 
-  // and link it to the list of iV0 as the first node
+  Index iE = getNumberOfEdges();
+  if(_indexType==HASH_TABLE) {
+    Index slot = _findSlot(iV0,iV1);
+    // if the edges has already been inserted, return the previously
+    // assigned edge index
+    if(_table[slot]>=0) return _table[slot];
+    _table[slot] = iE;
+  } else {
+    // if the edges has already been inserted, return the previously
+    // assigned edge index
+    Index iE0 = getEdge(iV0,iV1); if(iE0>=0) return iE0;
+    // link the new edge to the list of iV0 as the first node
+    _next.push_back(_first[iV0]);
+    _first[iV0] = iE;
+  }
+  // append a new pair (iV0,iV1) to the _edge array 
   _edge.push_back(iV0);
   _edge.push_back(iV1);
-  _edge.push_back(_first[iV0]);
-  // _first[iV0] ->  ... (.,.,-1)
-  _first[iV0] = j;
+  // keep the table at most half full; the new edge has to be in the
+  // _edge array before rehashing
+  if(_indexType==HASH_TABLE && 2*(iE+1)>static_cast<Index>(_table.size()))
+    _rehash(2*static_cast<Index>(_table.size()));
   // return the index of the new edge
   return iE;
 }
+
+Index Edges::_insertVertex() {
+  if(_indexType==LINKED_LISTS) _first.push_back(-1);
+  return _nV++;
+}
+
+void Edges::_removeEdge(const Index iE) {
+  if(iE<0 || iE>=getNumberOfEdges() || _edge[2*iE]<0) return;
+  if(_indexType==HASH_TABLE) {
+    _eraseSlot(_findSlot(_edge[2*iE],_edge[2*iE+1]));
+  } else {
+    _unlinkEdge(iE);
+  }
+  _edge[2*iE] = _edge[2*iE+1] = -1;
+}
+
+Index Edges::_moveEdge(const Index iE, Index iV0, Index iV1) {
+  if(iE<0 || iE>=getNumberOfEdges() || _edge[2*iE]<0) return -1;
+  if(getEdge(iV0,iV1)>=0) return -1;
+  if(iV0==iV1) return -1;
+  Index nV = getNumberOfVertices();
+  if(iV0<0 || nV<=iV0) return -1;
+  if(iV1<0 || nV<=iV1) return -1;
+  if(iV0>iV1) { Index iV=iV0; iV0=iV1; iV1=iV; }
+  _removeEdge(iE);
+  _edge[2*iE  ] = iV0;
+  _edge[2*iE+1] = iV1;
+  if(_indexType==HASH_TABLE) {
+    _table[_findSlot(iV0,iV1)] = iE;
+  } else {
+    _next[iE] = _first[iV0];
+    _first[iV0] = iE;
+  }
+  return iE;
+}
+
+bool Edges::_writeEdges(FILE* fp) const {
+  int64_t header[2] = { _indexType, _nV };
+  if(fwrite(header,sizeof(header),1,fp)<1) return false;
+  return
+    MappedFile::writeArray(fp,_edge) &&
+    MappedFile::writeArray(fp,_first) &&
+    MappedFile::writeArray(fp,_next) &&
+    MappedFile::writeArray(fp,_table);
+}
+
+bool Edges::_readEdges(MappedFile& file) {
+  int64_t header[2];
+  if(file.read(header,sizeof(header))==false) return false;
+  if(header[0]!=_indexType || header[1]<0) return false;
+  _nV = static_cast<Index>(header[1]);
+  if(file.readArray(_edge)==false || file.readArray(_first)==false ||
+     file.readArray(_next)==false || file.readArray(_table)==false)
+    return false;
+  // only the sizes of the arrays are verified here
+  size_t nE = _edge.size()/2;
+  size_t tableSize = _table.size();
+  if(_edge.size()%2!=0) return false;
+  if(_indexType==HASH_TABLE) {
+    // an open addressing table needs at least one empty slot
+    if(tableSize<=nE || (tableSize&(tableSize-1))!=0)
+      return false;
+    for(_shift=64;tableSize>(static_cast<size_t>(1)<<(64-_shift));_shift--);
+  } else {
+    if(_first.size()!=static_cast<size_t>(_nV) || _next.size()!=nE) return false;
+  }
+  return true;
+}
+
+// private methods
+
+Index Edges::_findSlot(const Index iV0, const Index iV1) const {
+  Index mask = static_cast<Index>(_table.size())-1;
+  Index slot = _homeSlot(iV0,iV1);
+  Index iE;
+  while((iE=_table[slot])>=0) {
+    if(_edge[2*iE]==iV0 && _edge[2*iE+1]==iV1) break;
+    slot = (slot+1)&mask;
+  }
+  return slot;
+}
+
+Index Edges::_homeSlot(const Index iV0, const Index iV1) const {
+  uint64_t key =
+    (static_cast<uint64_t>(iV0)<<32)^static_cast<uint64_t>(iV1);
+  return static_cast<Index>((key*0x9E3779B97F4A7C15ULL)>>_shift);
+}
+
+void Edges::_eraseSlot(Index slot) {
+  Index mask = static_cast<Index>(_table.size())-1;
+  _table[slot] = -1;
+  Index j = slot;
+  for(;;) {
+    j = (j+1)&mask;
+    Index iE = _table[j];
+    if(iE<0) break;
+    // the entry in slot j can be moved back to the empty slot only if
+    // its home slot is not cyclically within (slot,j]
+    Index k = _homeSlot(_edge[2*iE],_edge[2*iE+1]);
+    bool stays = (slot<=j)?(slot<k && k<=j):(slot<k || k<=j);
+    if(stays) continue;
+    _table[slot] = iE;
+    _table[j]    = -1;
+    slot = j;
+  }
+}
+
+void Edges::_unlinkEdge(const Index iE) {
+  Index iV0 = _edge[2*iE];
+  if(_first[iV0]==iE) {
+    _first[iV0] = _next[iE];
+  } else {
+    Index jE = _first[iV0];
+    while(_next[jE]!=iE) jE = _next[jE];
+    _next[jE] = _next[iE];
+  }
+  _next[iE] = -1;
+}
+
+void Edges::_rehash(const Index tableSize) {
+  // tableSize is a power of 2
+  _table.assign(tableSize,-1);
+  for(_shift=64;
+      static_cast<uint64_t>(tableSize)>(static_cast<uint64_t>(1)<<(64-_shift));
+      _shift--);
+  Index nE = getNumberOfEdges();
+  for(Index iE=0;iE<nE;iE++) {
+    // removed edges are not indexed
+    if(_edge[2*iE]<0) continue;
+    // edges already in the table are all different
+    _table[_findSlot(_edge[2*iE],_edge[2*iE+1])] = iE;
+  }
+}
@@ -43,6 +43,9 @@
 #define _EDGES_HPP_
 
 #include <vector>
+#include <cstdio>
+#include "util/Index.hpp"
+#include "util/MappedFile.hpp"
 
 using namespace std;
 
@@ -57,34 +60,55 @@ class Edges {
   
 public:
 
+  // two different representations are available to locate an edge
+  // from its two vertex indices
+  // - LINKED_LISTS : one single-linked list of edges per vertex;
+  //   getEdge(iV0,iV1) is linear in the number of edges incident to
+  //   iV0, which makes the construction of meshes with high valence
+  //   vertices quadratic in the valence
+  // - HASH_TABLE : open addressing hash table keyed on the pair
+  //   (iV0,iV1); getEdge(iV0,iV1) takes constant expected time
+  enum IndexType {
+    LINKED_LISTS = 0,
+    HASH_TABLE
+  };
+
+  // the index type used by all the Edges instances created after the
+  // call; the default value is HASH_TABLE
+  static void setIndexType(const IndexType it);
+  static IndexType getIndexType();
+
   // create a graph with nV vertices and no edges;
   // the range of valid vertex indices is 0<=iV<nV
-          Edges(const int nV);
+          Edges(const Index nV);
 
   // returns the number of vertices
-  int     getNumberOfVertices()                     const;
+  Index   getNumberOfVertices()                     const;
 
   // returns the number of edges nE at the time of the call;
   // at any particular time, the range of valid vertex indices is
   // 0<=iE<getNumberOfEdges()
-  int     getNumberOfEdges()                        const;
+  Index   getNumberOfEdges()                        const;
 
   // returns -1 if iV0==iV1 or one of the vertex indices is out of
   // range; also returns -1 if the edge (iV0,iV1) has not been
   // inserted into the Edges yet; otherwise it returns the edge index iE
   // assigned to the edge when inserted
-  int     getEdge(const int iV0, const int iV1)     const;
+  Index   getEdge(const Index iV0, const Index iV1) const;
 
   // an edge is stored internally as a pair of vertex indices
   // (iV0,iV1) so that iV0<iV1; getVertex0(iE) returns iV0, and
   // getVertex1(iE) returns iV1.
-  int     getVertex0(const int iE)                  const;
-  int     getVertex1(const int iE)                  const;
+  Index   getVertex0(const Index iE)                const;
+  Index   getVertex1(const Index iE)                const;
+
+  // returns the number of bytes allocated by the internal arrays
+  size_t  getMemoryUsage()                          const;
 
   // Edges Traversal sample code
   //
-  // int nE = edges.getNumberOfEdges();
-  // int iE,iV0,iV1;
+  // Index nE = edges.getNumberOfEdges();
+  // Index iE,iV0,iV1;
   // for(iE=0;iE<nE;iE++) {
   //   iV0 = edges.getVertex0(iE);
   //   iV1 = edges.getVertex0(iE);
@@ -94,7 +118,13 @@ public:
 protected:
 
   // remove all the edges, and change the number of vertices
-  void    _reset(const int nV);
+  void    _reset(const Index nV);
+
+  // if the number of edges to be inserted is known in advance, or
+  // it can be estimated, calling this method before inserting the
+  // edges avoids growing the hash table during the insertions; it has
+  // no effect with the LINKED_LISTS index
+  void    _reserveEdges(const Index nE);
 
   // - if iV0==iV1 or one of the two vertex indices is out of range,
   //   _insertEdge() returns -1 ;
@@ -102,21 +132,78 @@ protected:
   //   _insertEdge() returns iE;
   // - otherwise a new edge index iE is assigned to the edge, and
   //   _isertEdge() returns the new index iE
-  int     _insertEdge(const int iV0, const int iV1);
+  Index   _insertEdge(const Index iV0, const Index iV1);
+
+  // methods used by subclasses which support local edits
+
+  // adds one isolated vertex, and returns its index
+  Index   _insertVertex();
+
+  // removes the edge iE from the index; the edge index is not
+  // reused, and getVertex0(iE) and getVertex1(iE) return -1
+  // afterwards; edge indices are not changed
+  void    _removeEdge(const Index iE);
+
+  // changes the vertices of the edge iE to (iV0,iV1), keeping the
+  // edge index; returns iE on success, and -1 if iE is not a valid
+  // edge, if iV0==iV1, if one of the vertex indices is out of range,
+  // or if the edge (iV0,iV1) already exists
+  Index   _moveEdge(const Index iE, Index iV0, Index iV1);
+
+  // methods used by subclasses which cache their topology in a file
+
+  // appends the index type, the number of vertices, and the edge
+  // arrays to the file; returns false on error
+  bool    _writeEdges(FILE* fp) const;
+
+  // reads the data written by _writeEdges(); returns false if the
+  // file is too short, or it was written with a different index type,
+  // in which case _reset() should be called before using the edges
+  bool    _readEdges(MappedFile& file);
 
 private:
 
-  // representation: array of single-linked lists
-
-  // _first[iV0] is the index into _edge array corresponding to first
-  // edge (iV0,iV1) so that iV0<iV1; _first[iV0]==-1 if the list is
-  // empty
-  vector<int> _first;
-  // stores triples (iV0,iV1,next), where the next value is an index
-  // into _edge array corresponding to next edge (iV0,iV1) so that
-  // iV0<iV1; next==-1 indicates the end of the list; the order of the
-  // triples in each list is not specified
-  vector<int> _edge;
+  static IndexType _defaultIndexType; // default : HASH_TABLE
+
+  IndexType   _indexType;
+
+  Index       _nV;
+
+  // stores pairs (iV0,iV1) so that iV0<iV1; the edge index iE is the
+  // location of the pair in the _edge array, regarded as an array of
+  // pairs
+  vector<Index> _edge;
+
+  // LINKED_LISTS representation: array of single-linked lists
+
+  // _first[iV0] is the index of the first edge (iV0,iV1) so that
+  // iV0<iV1; _first[iV0]==-1 if the list is empty
+  vector<Index> _first;
+  // _next[iE] is the index of the next edge (iV0,iV1) in the list of
+  // iV0; _next[iE]==-1 indicates the end of the list; the order of
+  // the edges in each list is not specified
+  vector<Index> _next;
+
+  // HASH_TABLE representation: open addressing with linear probing
+
+  // each slot contains an edge index, or -1 if empty; the size of the
+  // table is a power of 2, and the table is never more than half full
+  vector<Index> _table;
+  // the hash function maps the 64 bit key (iV0,iV1) to a slot number
+  // using the top bits of the product with a large odd constant
+  Index       _shift;
+
+  // returns the slot where the edge (iV0,iV1) is stored, or the empty
+  // slot where it should be inserted; assumes that iV0<iV1
+  Index   _findSlot(const Index iV0, const Index iV1) const;
+  // returns the first slot probed for the edge (iV0,iV1)
+  Index   _homeSlot(const Index iV0, const Index iV1) const;
+  // removes the edge stored in the given slot from the hash table,
+  // shifting back the following entries of the probe sequence
+  void    _eraseSlot(Index slot);
+  // removes the edge iE from the list of _edge[2*iE]
+  void    _unlinkEdge(const Index iE);
+  void    _rehash(const Index tableSize);
 
 };
 
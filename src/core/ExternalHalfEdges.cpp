@@ -0,0 +1,364 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// ExternalHalfEdges.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#include <cstdio>
+#include "ExternalHalfEdges.hpp"
+#include "util/ExternalSort.hpp"
+
+// sort key of a half edge
+struct HalfEdgeKey {
+  Index iV0,iV1,iC;
+  bool operator<(const HalfEdgeKey& k) const {
+    if(iV0!=k.iV0) return (iV0<k.iV0);
+    if(iV1!=k.iV1) return (iV1<k.iV1);
+    return (iC<k.iC);
+  }
+};
+
+// twin and edge of a half edge, sorted by corner
+struct CornerRecord {
+  Index iC,iTwin,iE;
+  bool operator<(const CornerRecord& r) const {
+    return (iC<r.iC);
+  }
+};
+
+size_t ExternalHalfEdges::_memoryBudget = static_cast<size_t>(256)<<20;
+
+void ExternalHalfEdges::setMemoryBudget(const size_t bytes) {
+  _memoryBudget = bytes;
+}
+
+size_t ExternalHalfEdges::getMemoryBudget() {
+  return _memoryBudget;
+}
+
+bool ExternalHalfEdges::writeCoordIndex
+(const string& filename, const vector<int>& coordIndex) {
+  FILE* fp = fopen(filename.c_str(),"wb");
+  if(fp==(FILE*)0) return false;
+  bool success =
+    (fwrite(coordIndex.data(),sizeof(int),coordIndex.size(),fp)==coordIndex.size());
+  return (fclose(fp)==0) && success;
+}
+
+static const char* _tableSuffix[5] = {
+  ".face", ".twin", ".cornerEdge", ".edge", ".edgeHalfEdges"
+};
+
+void ExternalHalfEdges::removeTables(const string& tablePrefix) {
+  for(int i=0;i<5;i++)
+    remove((tablePrefix+_tableSuffix[i]).c_str());
+}
+
+ExternalHalfEdges::ExternalHalfEdges
+(const string& coordIndexFile, const string& tablePrefix):
+  _nV(0),
+  _nC(0),
+  _nF(0),
+  _nE(0),
+  _nBoundaryEdges(0),
+  _nRegularEdges(0),
+  _nSingularEdges(0),
+  _nRuns(0),
+  _valid(false),
+  _isBoundaryVertex(),
+  _file(),
+  _coordIndex((const int*)0),
+  _face((const Index*)0),
+  _twin((const Index*)0),
+  _cornerEdge((const Index*)0),
+  _edge((const Index*)0),
+  _edgeHalfEdges((const Index*)0) {
+  _valid = _build(coordIndexFile,tablePrefix) && _map(coordIndexFile,tablePrefix);
+  if(_valid) return;
+  // back to an empty mesh; the run files have already been removed by
+  // the ExternalSort destructors, and the partial tables are removed
+  // after they are unmapped
+  _nV = _nC = _nF = _nE = 0;
+  _nBoundaryEdges = _nRegularEdges = _nSingularEdges = 0;
+  _isBoundaryVertex.clear();
+  _file.clear();
+  removeTables(tablePrefix);
+}
+
+bool ExternalHalfEdges::_build
+(const string& coordIndexFile, const string& tablePrefix) {
+  // each of the two sorts gets half of the memory budget, since the
+  // second one is filled while the first one is being merged
+  ExternalSort<HalfEdgeKey>  keySort(tablePrefix+".keys",_memoryBudget/2);
+  ExternalSort<CornerRecord> cornerSort(tablePrefix+".corners",_memoryBudget/2);
+
+  FILE* fp[5];
+  for(int i=0;i<5;i++) fp[i] = (FILE*)0;
+  FILE* fpIn = fopen(coordIndexFile.c_str(),"rb");
+  bool success = (fpIn!=(FILE*)0);
+  for(int i=0;i<5 && success;i++)
+    success = ((fp[i]=fopen((tablePrefix+_tableSuffix[i]).c_str(),"wb"))!=(FILE*)0);
+  FILE* fpFace = fp[0];
+  FILE* fpTwin = fp[1];
+  FILE* fpCornerEdge = fp[2];
+  FILE* fpEdge = fp[3];
+  FILE* fpEdgeHalfEdges = fp[4];
+  auto write = [&](FILE* f, const Index value) {
+    if(fwrite(&value,sizeof(Index),1,f)<1) success = false;
+  };
+
+  // 1) stream the coordIndex file; the face of each corner is written
+  //    as soon as the face separator is found, and one key is added
+  //    per half edge with two different vertices
+  vector<int> block(1<<16);
+  vector<int> faceVertex;
+  Index iC = 0;
+  while(success) {
+    size_t n = fread(block.data(),sizeof(int),block.size(),fpIn);
+    for(size_t i=0;i<n;i++,iC++) {
+      int iV = block[i];
+      if(iV>=0) {
+        faceVertex.push_back(iV);
+        if(iV>=_nV) _nV = iV+1;
+        continue;
+      }
+      Index nCF = static_cast<Index>(faceVertex.size());
+      Index iC0 = iC-nCF;
+      for(Index k=0;k<nCF;k++) {
+        Index iV0 = faceVertex[k];
+        Index iV1 = faceVertex[(k+1)%nCF];
+        if(iV0!=iV1)
+          success = keySort.add(HalfEdgeKey{min(iV0,iV1),max(iV0,iV1),iC0+k}) && success;
+        write(fpFace,_nF);
+      }
+      write(fpFace,-1);
+      faceVertex.clear();
+      _nF++;
+    }
+    if(n<block.size()) {
+      if(ferror(fpIn)) success = false;
+      break;
+    }
+  }
+  // corners after the last separator do not belong to any face
+  for(size_t k=0;k<faceVertex.size();k++)
+    write(fpFace,-1);
+  _nC = iC;
+  _isBoundaryVertex.assign(_nV,false);
+
+  // 2) group the sorted keys by edge, and add the twin and edge of
+  //    each half edge to the second sort
+  vector<Index> edgeCorner;
+  Index iV0 = -1, iV1 = -1;
+  auto endEdge = [&]() {
+    Index nH = static_cast<Index>(edgeCorner.size());
+    if(nH==0) return;
+    write(fpEdge,iV0);
+    write(fpEdge,iV1);
+    write(fpEdgeHalfEdges,nH);
+    if(nH==1) {
+      _nBoundaryEdges++;
+      _isBoundaryVertex[iV0] = _isBoundaryVertex[iV1] = true;
+    } else if(nH==2) {
+      _nRegularEdges++;
+    } else {
+      _nSingularEdges++;
+    }
+    for(Index h=0;h<nH;h++) {
+      Index iTwin = (nH==2)?edgeCorner[1-h]:-1;
+      success = cornerSort.add(CornerRecord{edgeCorner[h],iTwin,_nE}) && success;
+    }
+    edgeCorner.clear();
+    _nE++;
+  };
+  if(success) {
+    success = keySort.finish([&](const HalfEdgeKey& k) {
+      if(k.iV0!=iV0 || k.iV1!=iV1) {
+        endEdge();
+        iV0 = k.iV0;
+        iV1 = k.iV1;
+      }
+      edgeCorner.push_back(k.iC);
+    }) && success;
+    endEdge();
+  }
+
+  // 3) write the twin and edge of every corner, in corner order; the
+  //    corners without a key are face separators, or degenerate half
+  //    edges
+  Index nextC = 0;
+  if(success) {
+    success = cornerSort.finish([&](const CornerRecord& r) {
+      for(;nextC<r.iC;nextC++) {
+        write(fpTwin,-1);
+        write(fpCornerEdge,-1);
+      }
+      write(fpTwin,r.iTwin);
+      write(fpCornerEdge,r.iE);
+      nextC++;
+    }) && success;
+    for(;nextC<_nC;nextC++) {
+      write(fpTwin,-1);
+      write(fpCornerEdge,-1);
+    }
+  }
+  _nRuns = keySort.getNumberOfRuns()+cornerSort.getNumberOfRuns();
+
+  if(fpIn!=(FILE*)0) fclose(fpIn);
+  for(int i=0;i<5;i++)
+    if(fp[i]!=(FILE*)0 && fclose(fp[i])!=0) success = false;
+  return success;
+}
+
+bool ExternalHalfEdges::_map
+(const string& coordIndexFile, const string& tablePrefix) {
+  string filename[6] = { coordIndexFile };
+  size_t size[6] = {
+    sizeof(int)*_nC,
+    sizeof(Index)*_nC, sizeof(Index)*_nC, sizeof(Index)*_nC,
+    sizeof(Index)*2*_nE, sizeof(Index)*_nE
+  };
+  const char* data[6];
+  for(int i=0;i<6;i++) {
+    if(i>0) filename[i] = tablePrefix+_tableSuffix[i-1];
+    data[i] = (const char*)0;
+    // empty files cannot be mapped
+    if(size[i]==0) continue;
+    _file.push_back(unique_ptr<MappedFile>(new MappedFile(filename[i])));
+    if(_file.back()->getSize()<size[i]) return false;
+    data[i] = _file.back()->getData();
+  }
+  _coordIndex    = reinterpret_cast<const int*>(data[0]);
+  _face          = reinterpret_cast<const Index*>(data[1]);
+  _twin          = reinterpret_cast<const Index*>(data[2]);
+  _cornerEdge    = reinterpret_cast<const Index*>(data[3]);
+  _edge          = reinterpret_cast<const Index*>(data[4]);
+  _edgeHalfEdges = reinterpret_cast<const Index*>(data[5]);
+  return true;
+}
+
+bool ExternalHalfEdges::isValid() const {
+  return _valid;
+}
+
+Index ExternalHalfEdges::getNumberOfVertices() const {
+  return _nV;
+}
+
+Index ExternalHalfEdges::getNumberOfCorners() const {
+  return _nC;
+}
+
+Index ExternalHalfEdges::getNumberOfFaces() const {
+  return _nF;
+}
+
+Index ExternalHalfEdges::getNumberOfEdges() const {
+  return _nE;
+}
+
+Index ExternalHalfEdges::getSrc(const Index iC) const {
+  if(iC<0 || iC>=_nC) return -1;
+  return (_coordIndex[iC]>=0)?_coordIndex[iC]:-1;
+}
+
+Index ExternalHalfEdges::getFace(const Index iC) const {
+  if(iC<0 || iC>=_nC) return -1;
+  return _face[iC];
+}
+
+Index ExternalHalfEdges::getTwin(const Index iC) const {
+  if(iC<0 || iC>=_nC) return -1;
+  return _twin[iC];
+}
+
+Index ExternalHalfEdges::getCornerEdge(const Index iC) const {
+  if(iC<0 || iC>=_nC) return -1;
+  return _cornerEdge[iC];
+}
+
+Index ExternalHalfEdges::getVertex0(const Index iE) const {
+  if(iE<0 || iE>=_nE) return -1;
+  return _edge[2*iE];
+}
+
+Index ExternalHalfEdges::getVertex1(const Index iE) const {
+  if(iE<0 || iE>=_nE) return -1;
+  return _edge[2*iE+1];
+}
+
+Index ExternalHalfEdges::getNumberOfEdgeHalfEdges(const Index iE) const {
+  if(iE<0 || iE>=_nE) return 0;
+  return _edgeHalfEdges[iE];
+}
+
+bool ExternalHalfEdges::isBoundaryEdge(const Index iE) const {
+  return (getNumberOfEdgeHalfEdges(iE)==1);
+}
+
+bool ExternalHalfEdges::isRegularEdge(const Index iE) const {
+  return (getNumberOfEdgeHalfEdges(iE)==2);
+}
+
+bool ExternalHalfEdges::isSingularEdge(const Index iE) const {
+  return (getNumberOfEdgeHalfEdges(iE)>=3);
+}
+
+bool ExternalHalfEdges::isBoundaryVertex(const Index iV) const {
+  return (0<=iV && iV<_nV)?_isBoundaryVertex[iV]:false;
+}
+
+bool ExternalHalfEdges::hasBoundary() const {
+  return (_nBoundaryEdges>0);
+}
+
+Index ExternalHalfEdges::getNumberOfBoundaryEdges() const {
+  return _nBoundaryEdges;
+}
+
+Index ExternalHalfEdges::getNumberOfRegularEdges() const {
+  return _nRegularEdges;
+}
+
+Index ExternalHalfEdges::getNumberOfSingularEdges() const {
+  return _nSingularEdges;
+}
+
+size_t ExternalHalfEdges::getNumberOfRuns() const {
+  return _nRuns;
+}
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// ExternalHalfEdges.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#ifndef _EXTERNAL_HALF_EDGES_HPP_
+#define _EXTERNAL_HALF_EDGES_HPP_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "util/Index.hpp"
+#include "util/MappedFile.hpp"
+
+using namespace std;
+
+class ExternalHalfEdges {
+
+  // - out of core version of the HalfEdges construction, for meshes
+  //   whose topology tables do not fit in memory
+  // - the coordIndex array is read from a binary file, which contains
+  //   the elements of the array as 32 bit integers in the byte order
+  //   of the machine, as written by writeCoordIndex()
+  // - the file is streamed once, and one key (iV0,iV1,iC) with
+  //   iV0<iV1 is generated per half edge; the keys are sorted with an
+  //   ExternalSort, which uses at most getMemoryBudget() bytes; the
+  //   sorted keys are grouped by edge, which assigns the edge
+  //   indices in lexicographic order of their vertex index pairs, as
+  //   the SORT build method of HalfEdges does; the twin and edge of
+  //   each corner are then sorted back in corner order with a second
+  //   ExternalSort
+  // - all the tables are written sequentially to files named
+  //   tablePrefix+".face", ".twin", ".cornerEdge", ".edge", and
+  //   ".edgeHalfEdges", which are then mapped into memory, so that
+  //   the operating system keeps in memory only the pages in use; the
+  //   coordIndex file is mapped as well
+  // - the files are not removed by the destructor; removeTables() can
+  //   be used to remove them
+  // - the vertex classification is limited to boundary vertices,
+  //   which requires one bit per vertex; the singular vertices
+  //   require a partition of the corners, and are not computed
+
+public:
+
+  // number of bytes used by each of the sorts; the default value is
+  // 256MB
+  static void   setMemoryBudget(const size_t bytes);
+  static size_t getMemoryBudget();
+
+  // writes the coordIndex array to a file in the format expected by
+  // the constructor; returns false on error
+  static bool   writeCoordIndex(const string& filename, const vector<int>& coordIndex);
+
+  // removes the table files
+  static void   removeTables(const string& tablePrefix);
+
+                ExternalHalfEdges(const string& coordIndexFile,
+                                  const string& tablePrefix);
+
+  // returns false if one of the files could not be read or written,
+  // in which case the mesh has no vertices, corners, or edges, and
+  // the table files have been removed
+  bool          isValid()                                 const;
+
+  // the number of vertices is one more than the largest vertex index
+  Index         getNumberOfVertices()                     const;
+  Index         getNumberOfCorners()                      const;
+  Index         getNumberOfFaces()                        const;
+  Index         getNumberOfEdges()                        const;
+
+  // same as the HalfEdges methods; getTwin() returns -1 unless the
+  // edge of the half edge is regular; getCornerEdge() returns the edge
+  // of the half edge iC, or -1 for face separators
+  Index         getSrc(const Index iC)                    const;
+  Index         getFace(const Index iC)                   const;
+  Index         getTwin(const Index iC)                   const;
+  Index         getCornerEdge(const Index iC)             const;
+  Index         getVertex0(const Index iE)                const;
+  Index         getVertex1(const Index iE)                const;
+  Index         getNumberOfEdgeHalfEdges(const Index iE)  const;
+
+  // same as the PolygonMesh methods
+  bool          isBoundaryEdge(const Index iE)            const;
+  bool          isRegularEdge(const Index iE)             const;
+  bool          isSingularEdge(const Index iE)            const;
+  bool          isBoundaryVertex(const Index iV)          const;
+  bool          hasBoundary()                             const;
+
+  // number of edges of each type
+  Index         getNumberOfBoundaryEdges()                const;
+  Index         getNumberOfRegularEdges()                 const;
+  Index         getNumberOfSingularEdges()                const;
+
+  // number of run files written by the two sorts; 0 if everything
+  // fit in memory
+  size_t        getNumberOfRuns()                         const;
+
+private:
+
+  static size_t _memoryBudget; // default : 256MB
+
+  bool          _build(const string& coordIndexFile, const string& tablePrefix);
+  bool          _map(const string& coordIndexFile, const string& tablePrefix);
+
+  Index         _nV;
+  Index         _nC;
+  Index         _nF;
+  Index         _nE;
+  Index         _nBoundaryEdges;
+  Index         _nRegularEdges;
+  Index         _nSingularEdges;
+  size_t        _nRuns;
+  bool          _valid;
+  vector<bool>  _isBoundaryVertex;
+
+  // mapped files, and the arrays they contain
+  vector<unique_ptr<MappedFile>> _file;
+  const int*    _coordIndex;
+  const Index*  _face;
+  const Index*  _twin;
+  const Index*  _cornerEdge;
+  const Index*  _edge;
+  const Index*  _edgeHalfEdges;
+
+};
+
+#endif /* _EXTERNAL_HALF_EDGES_HPP_ */
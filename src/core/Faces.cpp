@@ -35,14 +35,15 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <math.h>
+#include <algorithm>
 #include "Faces.hpp"
 #include "io/StrException.hpp"
   
-Faces::Faces(const int nV, const vector<int>& coordIndex) {
+Faces::Faces(const Index nV, const vector<int>& coordIndex) {
   try{
       if(nV<=0) throw new StrException("Cantidad incorrecta de vértices");
 
-      int faceNumber = 1;
+      Index faceNumber = 1;
       _faceIndex = {};
       vector<int> newCoordIndex = {};
 
@@ -67,26 +68,55 @@ Faces::Faces(const int nV, const vector<int>& coordIndex) {
   }
 }
 
-int Faces::getNumberOfVertices() const {
+Faces::Faces(const Index nV, const vector<int>& coordIndex,
+             const vector<Index>& faceOffsets) {
+  try{
+      if(nV<=0) throw new StrException("Cantidad incorrecta de vértices");
+
+      Index nF = static_cast<Index>(faceOffsets.size())-1;
+      Index nC = (nF>=0)?faceOffsets[nF]:0;
+
+      // single pass without branches over the vertex indices
+      int iVmin = -1, iVmax = -1;
+      for(Index i=0; i<nC; i++){
+          iVmin = min(iVmin,coordIndex[i]);
+          iVmax = max(iVmax,coordIndex[i]);
+      }
+      if(iVmin < -1 || iVmax >= nV) throw new StrException("Índice de vértice incorrecto");
+
+      _nV = nV;
+      _coordIndex.assign(coordIndex.begin(),coordIndex.begin()+nC);
+      _faceIndex.assign(faceOffsets.begin(),faceOffsets.end());
+      if(nF<0) _faceIndex.push_back(0);
+      for(Index iF=0; iF<nF; iF++)
+          _coordIndex[_faceIndex[iF+1]-1] = static_cast<int>(-(iF+1));
+
+  } catch(StrException* e) { 
+      fprintf(stderr,"Faces | ERROR | %s\n",e->what());
+      delete e;
+  }
+}
+
+Index Faces::getNumberOfVertices() const {
   return _nV;
 }
 
-int Faces::getNumberOfFaces() const {
+Index Faces::getNumberOfFaces() const {
     return _faceIndex.size()-1; //Le resto 1 ya que la última posición no apunta a una cara real
 }
 
-int Faces::getNumberOfCorners() const {
+Index Faces::getNumberOfCorners() const {
     return _coordIndex.size();
 }
 
-int Faces::getFaceSize(const int iF) const {
-  int result = -1;
+Index Faces::getFaceSize(const Index iF) const {
+  Index result = -1;
   try{
       if(iF < 0 || iF >= getNumberOfFaces()){
           throw new StrException("Índice de cara incorrecto");
       }
-      int firstIndexFace = getFaceFirstCorner(iF);
-      int indexFaceSeparator = -1;
+      Index firstIndexFace = getFaceFirstCorner(iF);
+      Index indexFaceSeparator = -1;
       if(iF == getNumberOfFaces() - 1){
           indexFaceSeparator = getNumberOfCorners() - 1;
       } else {
@@ -102,8 +132,8 @@ int Faces::getFaceSize(const int iF) const {
   return result;
 }
 
-int Faces::getFaceFirstCorner(const int iF) const {
-  int result = -1;
+Index Faces::getFaceFirstCorner(const Index iF) const {
+  Index result = -1;
   try{
       if(iF < 0 || iF >= getNumberOfFaces()){
           throw new StrException("Índice de cara incorrecto");
@@ -118,8 +148,8 @@ int Faces::getFaceFirstCorner(const int iF) const {
   return result;
 }
 
-int Faces::getFaceVertex(const int iF, const int j) const {
-  int result = -1;
+Index Faces::getFaceVertex(const Index iF, const Index j) const {
+  Index result = -1;
   try{
       if(iF < 0 || iF >= getNumberOfFaces()){
           throw new StrException("Índice de cara incorrecto");
@@ -127,7 +157,7 @@ int Faces::getFaceVertex(const int iF, const int j) const {
       if(j < 0 || j >= getFaceSize(iF)){
           throw new StrException("Número de esquina fuera del tamaño de la cara");
       }
-      int vertexIndex = getFaceFirstCorner(iF) + j;
+      Index vertexIndex = getFaceFirstCorner(iF) + j;
       result = _coordIndex[vertexIndex];
 
   } catch(StrException* e) { 
@@ -138,14 +168,14 @@ int Faces::getFaceVertex(const int iF, const int j) const {
   return result;
 }
 
-int Faces::getCornerFace(const int iC) const {
-  int result = -1;
+Index Faces::getCornerFace(const Index iC) const {
+  Index result = -1;
   try{
       if(iC < 0 || iC >= getNumberOfCorners()){
           throw new StrException("Índice de esquina incorrecto");
       }
       if(_coordIndex[iC] >= 0){
-          int i = iC+1;
+          Index i = iC+1;
           while(_coordIndex[i] >= 0){i++;}
           result = -_coordIndex[i] - 1;
       }
@@ -157,14 +187,14 @@ int Faces::getCornerFace(const int iC) const {
   return result;
 }
 
-int Faces::getNextCorner(const int iC) const {
-  int result = -1;
+Index Faces::getNextCorner(const Index iC) const {
+  Index result = -1;
   try{
       if(iC < 0 || iC >= getNumberOfCorners()){
           throw new StrException("Índice de esquina incorrecto");
       }
       if(_coordIndex[iC] >= 0){
-          int cornerFace = getCornerFace(iC);
+          Index cornerFace = getCornerFace(iC);
           if(_coordIndex[iC+1] >= 0){
               result = iC+1;
           } else {
@@ -38,61 +38,71 @@
 #define _FACES_HPP_
 
 #include <vector>
+#include "util/Index.hpp"
 
 using namespace std;
 
 class Faces {
   
 public:
-          Faces(const int nV, const vector<int>& coordIndex);
+          Faces(const Index nV, const vector<int>& coordIndex);
+
+  // Same as the previous constructor, but the index of the first
+  // corner of each face, followed by the position after the last face
+  // separator, is passed in the faceOffsets array, as returned by
+  // IndexedFaceSet::getFaceOffsets(), so that the coordIndex array
+  // does not have to be searched for the face separators. Corners
+  // after the last face separator are ignored.
+          Faces(const Index nV, const vector<int>& coordIndex,
+                const vector<Index>& faceOffsets);
 
   // The constructor should compare the nV value passed as a parameter
   // with the non-negative values in stored in the coordIndex index
   // array, and update the value of nV stored internally if
   // necessary. This value returns the updated value;
-  int     getNumberOfVertices()                    const;
+  Index   getNumberOfVertices()                    const;
 
   // The faces are conted in the constructor by counting the number of
   // -1's in the coordIndex array. If coordIndex is not empty, the
   // last value of coordIndex should be -1.
-  int     getNumberOfFaces()                       const;
+  Index   getNumberOfFaces()                       const;
 
   // The number of corners is defined as the size of the coordIndex
   // array.  Including the -1 face separators as corners simplify many
   // of the algorithms.
-  int     getNumberOfCorners()                     const;
+  Index   getNumberOfCorners()                     const;
 
   // If iF is a valid face index, this method returns the number of
   // corners of the face iF. Otherwise it returns 0.
-  int     getFaceSize(const int iF)                const;
+  Index   getFaceSize(const Index iF)              const;
 
   // If iF is a valid face index, this method returns the index of the
   // coordIndex entry corresponding to the first corner of the face
   // iF. Otherwise it returns -1.
-  int     getFaceFirstCorner(const int iF)         const;
+  Index   getFaceFirstCorner(const Index iF)       const;
 
   // If iF is a valid face index, and j is a valid corner index for
   // face iF, this method returns the value stored in the
   // corresponding coordIndex entry.
-  int     getFaceVertex(const int iF, const int j) const;
+  Index   getFaceVertex(const Index iF, const Index j) const;
 
   // If iC is a valid corner index, and it does not correspond to a -1
   // separator, this method returns the index of the face which
   // contains the given corner. Otherwise it returns -1.
-  int     getCornerFace(const int iC)              const;
+  Index   getCornerFace(const Index iC)            const;
 
   // If iC is a valid corner index, and it does not correspond to a -1
   // separator, this method returns the next corner index within the
   // cyclical order of the face which contains the given
   // corner. Otherwise it returns -1.
-  int     getNextCorner(const int iC)              const;
+  Index   getNextCorner(const Index iC)            const;
 
 private:
 
   // TODO
-    int _nV; //Cantidad de vértices pasada al constructor
+    Index _nV; //Cantidad de vértices pasada al constructor
     vector<int> _coordIndex; //Vector coordIndex pasado al constructor
-    vector<int> _faceIndex; //Vector de índices de las caras en el coordIndex, para acceso eficiente
+    vector<Index> _faceIndex; //Vector de índices de las caras en el coordIndex, para acceso eficiente
 
 };
 
@@ -42,13 +42,13 @@
 #include <math.h>
 #include "Graph.hpp"
 
-Graph::Graph(const int nV):Edges(nV) {
+Graph::Graph(const Index nV):Edges(nV) {
 }
 
-void Graph::reset(const int nV) {
+void Graph::reset(const Index nV) {
   _reset(nV);
 }
 
-int Graph::insertEdge(int iV0, int iV1) {
+Index Graph::insertEdge(Index iV0, Index iV1) {
   return _insertEdge(iV0,iV1);
 }
@@ -56,17 +56,17 @@ public:
 
   // inherited from Edges
   //
-  // int     getNumberOfVertices()                     const;
-  // int     getNumberOfEdges()                        const;
-  // int     getEdge(const int iV0, const int iV1)     const;
-  // int     getVertex0(const int iE)                  const;
-  // int     getVertex1(const int iE)                  const;
+  // Index   getNumberOfVertices()                     const;
+  // Index   getNumberOfEdges()                        const;
+  // Index   getEdge(const Index iV0, const Index iV1) const;
+  // Index   getVertex0(const Index iE)                const;
+  // Index   getVertex1(const Index iE)                const;
 
-          Graph(const int nV);
+          Graph(const Index nV);
 
-  void    reset(const int nV);
+  void    reset(const Index nV);
 
-  int     insertEdge(const int iV0, const int iV1);
+  Index   insertEdge(const Index iV0, const Index iV1);
 
 };
 
@@ -42,21 +42,57 @@
 // DAMAGE.
 
 #include <math.h>
+#include <cstdint>
+#include <algorithm>
 #include "HalfEdges.hpp"
 #include "Graph.hpp"
 #include "io/StrException.hpp"
+#include "util/Parallel.hpp"
+
+// static
+
+HalfEdges::BuildMethod HalfEdges::_buildMethod = HalfEdges::INCREMENTAL;
+
+void HalfEdges::setBuildMethod(const BuildMethod bm) {
+  _buildMethod = bm;
+}
+
+HalfEdges::BuildMethod HalfEdges::getBuildMethod() {
+  return _buildMethod;
+}
+
+HalfEdges::Layout HalfEdges::_layout = HalfEdges::COMPACT;
+
+void HalfEdges::setLayout(const Layout layout) {
+  _layout = layout;
+}
+
+HalfEdges::Layout HalfEdges::getLayout() {
+  return _layout;
+}
 
 // 1) all half edges corresponding to regular mesh edges are made twins
 // 2) all the other edges are made boundary half edges (twin==-1)
 
-HalfEdges::HalfEdges(const int nVertices, const vector<int>&  coordIndex):
+HalfEdges::HalfEdges(const Index nVertices, const vector<int>&  coordIndex):
+  HalfEdges(nVertices,coordIndex,true) {
+}
+
+HalfEdges::HalfEdges
+(const Index nVertices, const vector<int>& coordIndex, const bool build):
   Edges(nVertices), // a graph with no edges is created here
   _coordIndex(coordIndex),
   _twin(),
   _face(),
   _firstCornerEdge(),
-  _cornerEdge()
+  _cornerEdge(),
+  _faceFirstCorner(),
+  _nextPrev()
 {
+  if(build) _build();
+}
+
+void HalfEdges::_build() {
   // TODO
 
   // - both the _twin array and the _face array should end up being of
@@ -72,41 +108,66 @@ HalfEdges::HalfEdges(const int nVertices, const vector<int>&  coordIndex):
   //   if _coordIndex[iC]<0 then
   //   _face[
   
-  int nV = nVertices;
-  int nC = static_cast<int>(_coordIndex.size()); // number of corners
+  const vector<int>& coordIndex = _coordIndex;
+  Index nV = getNumberOfVertices();
+  Index nC = static_cast<Index>(_coordIndex.size()); // number of corners
 
   // 0) just to be safe, verify that for each corner iC that
   //    -1<=iV && iV<nV, where iV=coordIndex[iC]
   //
-  //    if you find a violation, you can increment and the variable
-  //    nV, and then use the method Edges::_reset() to adjust the
-  //    number of vertices of the graph, if necessary; or you can
-  //    abort throwing an StrException
+  //    the largest vertex index is found with a parallel reduction;
+  //    if it is out of range, the number of vertices of the graph is
+  //    increased once with Edges::_reset(); input cleaned with
+  //    SceneGraphProcessor::compact() never needs it
+  Index nRanges = Parallel::getNumberOfRanges(nC);
+  vector<Index> maxVertex(nRanges,-1);
+  vector<char>  invalidRange(nRanges,0);
+  Parallel::forRanges(nC,[&](Index iR, Index i0, Index i1) {
+    Index iVmax = -1;
+    for(Index iC=i0;iC<i1;iC++) {
+      Index iV = coordIndex[iC];
+      if(iV>iVmax) iVmax = iV;
+      if(iV<-1) invalidRange[iR] = 1;
+    }
+    maxVertex[iR] = iVmax;
+  });
+  Index iVmax = -1;
+  bool  invalid = false;
+  for(Index iR=0;iR<nRanges;iR++) {
+    if(maxVertex[iR]>iVmax) iVmax = maxVertex[iR];
+    if(invalidRange[iR]) invalid = true;
+  }
+  if(iVmax>=nV) {
+    nV = iVmax+1;
+    _reset(nV);
+  }
   try{
-      for(int iC=0; iC < nC; iC++){
-          int iV = coordIndex[iC];
-          if(iV < -1) throw new StrException("Índice de vértice inválido en coordIndex");
-          if(iV >= nV) {
-              nV = iV;
-              _reset(nV);
-          }
-      }
-
+    if(invalid) throw new StrException("Índice de vértice inválido en coordIndex");
   } catch(StrException* e) {
-      fprintf(stderr,"Faces | ERROR | %s\n",e->what());
-      delete e;
+    fprintf(stderr,"Faces | ERROR | %s\n",e->what());
+    delete e;
+  }
+
+  if(_buildMethod==SORT) {
+    _buildSorted();
+    if(_layout==FAST) _buildFastLayout();
+    return;
   }
   
-  // 1) create an empty vector<int> to count the number of incident
+  // 1) create an empty vector<Index> to count the number of incident
   //    faces per edge; size is not known at this point because the
   //    edges have not been created yet
-  vector<int> nFacesEdge;
+  vector<Index> nFacesEdge;
+
+  // most edges are shared by two faces; pre-sizing the edge index
+  // avoids growing it while the edges are inserted
+  _reserveEdges(nC/2);
 
   // 2) insert all the edges in the graph; at the same time initialize
   //    the _twin array so that all the half edges are boundary, count
   //    the number of incident faces per edge, fill the _face
   //    array, and count the number of faces incident to each edge
-  int iV0,iV1,iF,iE,iC,iC0,iC1;
+  Index iV0,iV1,iF,iE,iC,iC0,iC1;
   for(iF=iC0=iC1=0;iC1<nC;iC1++) {
     if(_coordIndex[iC1]>=0) continue;
     // face iF comprises corners iC0<=iC<iC1
@@ -144,14 +205,14 @@ HalfEdges::HalfEdges(const int nVertices, const vector<int>&  coordIndex):
     iC0 = iC1+1; iF++;
   }
 
-  int nF = iF;
-  int nE = getNumberOfEdges();
+  Index nF = iF;
+  Index nE = getNumberOfEdges();
   
   // 3) create an array to hold the first twin corner for each edge
-  vector<int> twinCorner;
+  vector<Index> twinCorner;
   // - the size of this array should be equal to the number of edges
   // - initialize it with -1's
-  for(int i=0; i<nE; i++){
+  for(Index i=0; i<nE; i++){
       twinCorner.push_back(-1);
   }
 
@@ -163,12 +224,12 @@ HalfEdges::HalfEdges(const int nVertices, const vector<int>&  coordIndex):
   //   otherwise save the value stored in twinCorner[iE] in _twin[iC]
   //   and iC in _twin[_twin[iC]]
 
-  for(int i=0; i<nC; i++){
+  for(Index i=0; i<nC; i++){
       _twin.push_back(-1);
   }
 
-  int iVsrc;
-  int iVdst;
+  Index iVsrc;
+  Index iVdst;
   for(iC0=iC1=0;iC1<nC;iC1++) {
       if(_coordIndex[iC1]>=0) continue;
       for(iC=iC0; iC<iC1; iC++){
@@ -232,7 +293,7 @@ HalfEdges::HalfEdges(const int nVertices, const vector<int>&  coordIndex):
   //      _firstCornerEdge[iE+1] = _firstCornerEdge[iE]+nFacesEdge[iE] (1<=iE<nE)
   _firstCornerEdge.push_back(0);
   for(iE=0; iE<nE; iE++){
-      int nextEdgePosition = _firstCornerEdge[iE] + nFacesEdge[iE];
+      Index nextEdgePosition = _firstCornerEdge[iE] + nFacesEdge[iE];
       _firstCornerEdge.push_back(nextEdgePosition);
   }
 
@@ -241,10 +302,15 @@ HalfEdges::HalfEdges(const int nVertices, const vector<int>&  coordIndex):
   //    be stored consecutively in _cornerEdge starting at the
   //    location _firstCornerEdge[iE]
 
-  for(int i=0; i<nC-nF; i++){
+  for(Index i=0; i<nC-nF; i++){
       _cornerEdge.push_back(-1);
   }
 
+  // next free position in the list of each edge; the corners are
+  // appended in increasing order, so that all the half edges of a
+  // singular edge are stored, and not only the first two
+  vector<Index> nextCornerEdge(_firstCornerEdge.begin(),_firstCornerEdge.end()-1);
+
   for(iC0=iC1=0;iC1<nC;iC1++) {
       if(_coordIndex[iC1]>=0) continue;
       for(iC=iC0; iC<iC1; iC++){
@@ -259,64 +325,295 @@ HalfEdges::HalfEdges(const int nVertices, const vector<int>&  coordIndex):
           } else {
               iE = getEdge(iVdst, iVsrc);
           }
-          int firstCornerIndex = _firstCornerEdge[iE];
-          if(_cornerEdge[firstCornerIndex] == -1){
-              _cornerEdge[firstCornerIndex] = iC;
-              if(_twin[iC] != -1){
-                  _cornerEdge[firstCornerIndex + 1] = _twin[iC];
-              }
-          }
+          _cornerEdge[nextCornerEdge[iE]++] = iC;
       }
       iC0 = iC1+1;
   }
+
+  if(_layout==FAST) _buildFastLayout();
+}
+
+void HalfEdges::_buildFastLayout() {
+  Index nC = getNumberOfCorners();
+  _faceFirstCorner.clear();
+  _faceFirstCorner.push_back(0);
+  _nextPrev.assign(2*static_cast<size_t>(nC),-1);
+  Index iC,iC0,iC1;
+  for(iC0=iC1=0;iC1<nC;iC1++) {
+    if(_coordIndex[iC1]>=0) continue;
+    // face comprises corners iC0<=iC<iC1
+    for(iC=iC0;iC<iC1;iC++) {
+      _nextPrev[2*iC  ] = (iC+1<iC1)?iC+1:iC0;
+      _nextPrev[2*iC+1] = (iC>iC0)?iC-1:iC1-1;
+    }
+    iC0 = iC1+1;
+    _faceFirstCorner.push_back(iC0);
+  }
 }
 
-int HalfEdges::getNumberOfCorners() const {     //Hago a la función const para que pueda ser usada por las otras funciones, sabiendo que no modifica el half-edge
-  return static_cast<int>(_coordIndex.size());
+// parallel LSD radix sort of the pairs (key[i],value[i]) by key;
+// only the lowest nBits of the keys are used; the sort is stable
+static void _radixSort(vector<uint64_t>& key, vector<Index>& value, const Index nBits) {
+  const Index digitBits = 11;
+  const Index nDigits = 1<<digitBits;
+  Index n = static_cast<Index>(key.size());
+  Index nRanges = Parallel::getNumberOfRanges(n);
+  vector<uint64_t> keyTmp(n);
+  vector<Index>    valueTmp(n);
+  vector<Index>    offset(nRanges*nDigits);
+  for(Index shift=0;shift<nBits;shift+=digitBits) {
+    // count the digits in each range
+    Parallel::forRanges(n,[&](Index iR, Index i0, Index i1) {
+      Index* count = &offset[iR*nDigits];
+      for(Index d=0;d<nDigits;d++) count[d] = 0;
+      for(Index i=i0;i<i1;i++) count[(key[i]>>shift)&(nDigits-1)]++;
+    });
+    // skip the pass if all the keys have the same digit
+    bool skip = false;
+    for(Index d=0;d<nDigits && skip==false;d++) {
+      Index nd = 0;
+      for(Index iR=0;iR<nRanges;iR++) nd += offset[iR*nDigits+d];
+      if(nd==n) skip = true;
+    }
+    if(skip) continue;
+    // convert the counts into starting positions, ordered by digit
+    // first and by range second, so that the sort is stable
+    Index pos = 0;
+    for(Index d=0;d<nDigits;d++) {
+      for(Index iR=0;iR<nRanges;iR++) {
+        Index nd = offset[iR*nDigits+d];
+        offset[iR*nDigits+d] = pos;
+        pos += nd;
+      }
+    }
+    // scatter
+    Parallel::forRanges(n,[&](Index iR, Index i0, Index i1) {
+      Index* next = &offset[iR*nDigits];
+      for(Index i=i0;i<i1;i++) {
+        Index j = next[(key[i]>>shift)&(nDigits-1)]++;
+        keyTmp[j]   = key[i];
+        valueTmp[j] = value[i];
+      }
+    });
+    key.swap(keyTmp);
+    value.swap(valueTmp);
+  }
+}
+
+void HalfEdges::_buildSorted() {
+  Index nV = getNumberOfVertices();
+  Index nC = getNumberOfCorners();
+  const vector<int>& coordIndex = _coordIndex;
+
+  _twin.assign(nC,-1);
+  _face.assign(nC,-1);
+
+  // each key is (iV0<<nBits)|iV1, with iV0<iV1<nV<=2^nBits; keys of
+  // invalid half edges are set to a value larger than all the valid
+  // keys, so that they end up at the end of the sorted array
+  Index nBits = 1;
+  while(nBits<31 && (1<<nBits)<nV) nBits++;
+  const uint64_t invalidKey = (static_cast<uint64_t>(1)<<(2*nBits))-1;
+
+  // 1) count the faces and the half edges in each range of corners,
+  //    to determine the index of the first face and of the first half
+  //    edge within each range
+  Index nRanges = Parallel::getNumberOfRanges(nC);
+  vector<Index> firstFace(nRanges+1,0);
+  vector<Index> firstHalfEdge(nRanges+1,0);
+  Parallel::forRanges(nC,[&](Index iR, Index i0, Index i1) {
+    Index nF = 0;
+    for(Index iC=i0;iC<i1;iC++) if(coordIndex[iC]<0) nF++;
+    firstFace[iR+1]     = nF;
+    firstHalfEdge[iR+1] = (i1-i0)-nF;
+  });
+  for(Index iR=0;iR<nRanges;iR++) {
+    firstFace[iR+1]     += firstFace[iR];
+    firstHalfEdge[iR+1] += firstHalfEdge[iR];
+  }
+  Index nF = firstFace[nRanges];
+
+  // 2) fill the _face array, store the face sizes in the _twin array
+  //    at the face separators, and generate one key per half edge
+  vector<uint64_t> key(firstHalfEdge[nRanges]);
+  vector<Index>    corner(firstHalfEdge[nRanges]);
+  Parallel::forRanges(nC,[&](Index iR, Index i0, Index i1) {
+    Index iF = firstFace[iR];
+    Index iH = firstHalfEdge[iR];
+    for(Index iC=i0;iC<i1;iC++) {
+      Index iV0 = coordIndex[iC];
+      if(iV0<0) {
+        // empty face; otherwise the face size is set by its last corner
+        if(iC==0 || coordIndex[iC-1]<0) _twin[iC] = 0;
+        iF++;
+        continue;
+      }
+      corner[iH] = iC;
+      key[iH]    = invalidKey;
+      iH++;
+      // corners after the last face separator do not belong to any face
+      if(iF>=nF) continue;
+      _face[iC] = iF;
+      Index iCn = iC+1;
+      if(coordIndex[iCn]<0) {
+        // last corner of the face : search back for the first one
+        Index iC0 = iC;
+        while(iC0>0 && coordIndex[iC0-1]>=0) iC0--;
+        _twin[iCn] = -(iCn-iC0);
+        iCn = iC0;
+      }
+      Index iV1 = coordIndex[iCn];
+      if(iV0==iV1 || nV<=iV0 || nV<=iV1) continue;
+      if(iV0>iV1) { Index iV=iV0; iV0=iV1; iV1=iV; }
+      key[iH-1] = (static_cast<uint64_t>(iV0)<<nBits)|static_cast<uint64_t>(iV1);
+    }
+  });
+
+  // 3) sort the keys; within each run of equal keys the corners
+  //    remain sorted in increasing order
+  _radixSort(key,corner,2*nBits);
+  Index nH = static_cast<Index>
+    (lower_bound(key.begin(),key.end(),invalidKey)-key.begin());
+
+  // 4) each run of equal keys corresponds to one edge; count the runs
+  //    starting in each range of half edges
+  nRanges = Parallel::getNumberOfRanges(nH);
+  vector<Index> firstEdge(nRanges+1,0);
+  Parallel::forRanges(nH,[&](Index iR, Index i0, Index i1) {
+    Index nE = 0;
+    for(Index i=i0;i<i1;i++) if(i==0 || key[i]!=key[i-1]) nE++;
+    firstEdge[iR+1] = nE;
+  });
+  for(Index iR=0;iR<nRanges;iR++) firstEdge[iR+1] += firstEdge[iR];
+  Index nE = firstEdge[nRanges];
+
+  // 5) one sweep over the runs fills the half edge to edge incidence
+  //    lists, and makes twins the two half edges of regular edges
+  _firstCornerEdge.assign(nE+1,nH);
+  corner.resize(nH);
+  _cornerEdge.swap(corner);
+  Parallel::forRanges(nH,[&](Index iR, Index i0, Index i1) {
+    Index iE = firstEdge[iR];
+    for(Index i=i0;i<i1;i++) {
+      if(i>0 && key[i]==key[i-1]) continue;
+      _firstCornerEdge[iE++] = i;
+      if(i+1<nH && key[i+1]==key[i] && (i+2==nH || key[i+2]!=key[i])) {
+        Index iC0 = _cornerEdge[i];
+        Index iC1 = _cornerEdge[i+1];
+        _twin[iC0] = iC1;
+        _twin[iC1] = iC0;
+      }
+    }
+  });
+
+  // 6) insert the edges in the graph; since the runs are sorted, the
+  //    edge indices assigned by _insertEdge are the run indices
+  uint64_t mask = (static_cast<uint64_t>(1)<<nBits)-1;
+  _reserveEdges(nE);
+  for(Index iE=0;iE<nE;iE++) {
+    uint64_t k = key[_firstCornerEdge[iE]];
+    _insertEdge(static_cast<Index>(k>>nBits),static_cast<Index>(k&mask));
+  }
+}
+
+void HalfEdges::_resetHalfEdges(const Index nV) {
+  _reset(nV);
+  _twin.clear();
+  _face.clear();
+  _firstCornerEdge.clear();
+  _cornerEdge.clear();
+  _faceFirstCorner.clear();
+  _nextPrev.clear();
+}
+
+bool HalfEdges::_writeHalfEdges(FILE* fp) const {
+  return
+    _writeEdges(fp) &&
+    MappedFile::writeArray(fp,_twin) &&
+    MappedFile::writeArray(fp,_face) &&
+    MappedFile::writeArray(fp,_firstCornerEdge) &&
+    MappedFile::writeArray(fp,_cornerEdge) &&
+    MappedFile::writeArray(fp,_faceFirstCorner) &&
+    MappedFile::writeArray(fp,_nextPrev);
+}
+
+bool HalfEdges::_readHalfEdges(MappedFile& file) {
+  Index nV = getNumberOfVertices();
+  bool success =
+    _readEdges(file) &&
+    file.readArray(_twin) &&
+    file.readArray(_face) &&
+    file.readArray(_firstCornerEdge) &&
+    file.readArray(_cornerEdge) &&
+    file.readArray(_faceFirstCorner) &&
+    file.readArray(_nextPrev);
+  if(success) {
+    // only the sizes of the arrays are verified here
+    size_t nC = _coordIndex.size();
+    size_t nE = static_cast<size_t>(getNumberOfEdges());
+    success =
+      _twin.size()==nC && _face.size()==nC &&
+      _firstCornerEdge.size()==nE+1 &&
+      static_cast<size_t>(_firstCornerEdge[nE])==_cornerEdge.size() &&
+      ((_layout==FAST)?
+       (_faceFirstCorner.empty()==false && _nextPrev.size()==2*nC):
+       (_faceFirstCorner.empty() && _nextPrev.empty()));
+  }
+  if(success==false) {
+    // back to the state before the call
+    _resetHalfEdges(nV);
+    return false;
+  }
+  return true;
+}
+
+Index HalfEdges::getNumberOfCorners() const {   //Hago a la función const para que pueda ser usada por las otras funciones, sabiendo que no modifica el half-edge
+  return static_cast<Index>(_coordIndex.size());
 }
 
 // in all subsequent methods check that the arguments are valid, and
 // return -1 if any argument is out of range
 
 // half-edge method srcVertex()
-int HalfEdges::getFace(const int iC) const {
+Index HalfEdges::getFace(const Index iC) const {
   // TODO
   if(iC < 0 || iC >= getNumberOfCorners()) return -1;
   return _face[iC];
 }
 
 // half-edge method srcVertex()
-int HalfEdges::getSrc(const int iC) const {
+Index HalfEdges::getSrc(const Index iC) const {
   // TODO
   if(iC < 0 || iC >= getNumberOfCorners() || _coordIndex[iC] == -1) return -1;
   return _coordIndex[iC];
 }
 
 // half-edge method dstVertex()
-int HalfEdges::getDst(const int iC) const {
+Index HalfEdges::getDst(const Index iC) const {
   // TODO
   if(iC < 0 || iC >= getNumberOfCorners() || _coordIndex[iC] == -1) return -1;
   return _coordIndex[getNext(iC)];
 }
 
 // half-edge method next()
-int HalfEdges::getNext(const int iC) const {
+Index HalfEdges::getNext(const Index iC) const {
   // TODO
   // if iC is the last corner of its face, use the face size
   // stored in _twin[iC+1] to locate the first corner of the face
   if(iC < 0 || iC >= getNumberOfCorners() || _coordIndex[iC] == -1) return -1;
-  int next;
+  if(!_nextPrev.empty()) return _nextPrev[2*iC];
+  Index next;
   if(_coordIndex[iC+1]>=0){
       next = iC+1;
   } else {
-      int faceSize = -(_twin[iC+1]);
+      Index faceSize = -(_twin[iC+1]);
       next = iC - faceSize + 1;
   }
   return next;
 }
 
 // half-edge method prev()
-int HalfEdges::getPrev(const int iC) const {
+Index HalfEdges::getPrev(const Index iC) const {
   // TODO
   
   // if iC is the first corner of its face, since the face size is
@@ -325,17 +622,18 @@ int HalfEdges::getPrev(const int iC) const {
   // the fact that all the faces have at least 3 corners to start the
   // search for the face separator at iC+3
   if(iC < 0 || iC >= getNumberOfCorners() || _coordIndex[iC] == -1) return -1;
-  int prev = -1;
+  if(!_nextPrev.empty()) return _nextPrev[2*iC+1];
+  Index prev = -1;
   if(iC == 0 || _coordIndex[iC-1] < 0){
       prev = iC+2;
       while(_coordIndex[prev+1]>=0) prev++;
   } else {
-      prev = _coordIndex[iC-1];
+      prev = iC-1;
   }
   return prev;
 }
 
-int HalfEdges::getTwin(const int iC) const {
+Index HalfEdges::getTwin(const Index iC) const {
   // TODO
   if(iC < 0 || iC >= getNumberOfCorners() || _coordIndex[iC] == -1) return -1;
   return _twin[iC];
@@ -345,16 +643,33 @@ int HalfEdges::getTwin(const int iC) const {
 // associated with each edge
 
 
-int HalfEdges::getNumberOfEdgeHalfEdges(const int iE) const {
+Index HalfEdges::getNumberOfEdgeHalfEdges(const Index iE) const {
   // TODO
   if(iE < 0 || iE >= getNumberOfEdges()) return 0;
   return (_firstCornerEdge[iE+1] - _firstCornerEdge[iE]);
 }
 
-int HalfEdges::getEdgeHalfEdge(const int iE, const int j) const {
+Index HalfEdges::getEdgeHalfEdge(const Index iE, const Index j) const {
   // TODO
   if(iE < 0 || iE >= getNumberOfEdges()) return -1;
-  int targetIndex = _firstCornerEdge[iE]+j;
+  Index targetIndex = _firstCornerEdge[iE]+j;
   if(targetIndex >= _firstCornerEdge[iE+1]) return -1; //Si la arista iE no tiene j half-edges incidentes, devuelvo -1
   return _cornerEdge[targetIndex];
 }
+
+HalfEdges::Layout HalfEdges::getInstanceLayout() const {
+  return (_faceFirstCorner.empty())?COMPACT:FAST;
+}
+
+Index HalfEdges::getFaceFirstCorner(const Index iF) const {
+  Index nF = static_cast<Index>(_faceFirstCorner.size())-1;
+  if(iF<0 || iF>=nF) return -1;
+  return _faceFirstCorner[iF];
+}
+
+size_t HalfEdges::getMemoryUsage() const {
+  return Edges::getMemoryUsage()+sizeof(Index)*
+    (_twin.capacity()+_face.capacity()+
+     _firstCornerEdge.capacity()+_cornerEdge.capacity()+
+     _faceFirstCorner.capacity()+_nextPrev.capacity());
+}
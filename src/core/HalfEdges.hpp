@@ -55,26 +55,67 @@ public:
 
   // methods inherited from Edges
   //
-  // int     getNumberOfVertices()                     const;
-  // int     getNumberOfEdges()                        const;
-  // int     getEdge(const int iV0, const int iV1)     const;
-  // int     getVertex0(const int iE)                  const;
-  // int     getVertex1(const int iE)                  const;
+  // Index   getNumberOfVertices()                     const;
+  // Index   getNumberOfEdges()                        const;
+  // Index   getEdge(const Index iV0, const Index iV1) const;
+  // Index   getVertex0(const Index iE)                const;
+  // Index   getVertex1(const Index iE)                const;
+
+  // two different methods are available to construct the half edges
+  // - INCREMENTAL : the edges are inserted one corner at a time, and
+  //   the coordIndex array is traversed once to insert the edges, once
+  //   to pair the twin half edges, and once more to fill the half edge
+  //   to edge incidence lists; edges are numbered in the order in
+  //   which they are first found
+  // - SORT : one key (min(iV0,iV1),max(iV0,iV1),iC) is generated for
+  //   each half edge, the keys are radix sorted in parallel, and all
+  //   the data structures are derived in one sweep over the runs of
+  //   equal keys; edges are numbered in lexicographic order of their
+  //   vertex index pairs
+  enum BuildMethod {
+    INCREMENTAL = 0,
+    SORT
+  };
+
+  // the build method used by all the HalfEdges instances created
+  // after the call; the default value is INCREMENTAL
+  static void setBuildMethod(const BuildMethod bm);
+  static BuildMethod getBuildMethod();
+
+  // two different layouts are available to store the half edges
+  // - COMPACT : only the _twin and _face arrays are stored per corner;
+  //   getNext() has to read the face size stored in the _twin array
+  //   at the face separator, and getPrev() has to search forward for
+  //   the face separator, which takes time proportional to the face
+  //   size for the first corner of each face
+  // - FAST : in addition, the first corner of each face, and the
+  //   next and prev corners of each corner are stored, so that
+  //   getNext(), getPrev() and getFaceFirstCorner() take constant
+  //   time; this requires (2*nC+nF+1) additional Index values
+  enum Layout {
+    COMPACT = 0,
+    FAST
+  };
+
+  // the layout used by all the HalfEdges instances created after the
+  // call; the default value is COMPACT
+  static void setLayout(const Layout layout);
+  static Layout getLayout();
 
   // constructor performs most of the work
 
-          HalfEdges(const int nV, const vector<int>& coordIndex);
+          HalfEdges(const Index nV, const vector<int>& coordIndex);
 
   // returns the number of elements of the coordIndex array
 
-  int     getNumberOfCorners() const; //Hago a la función const para que pueda ser usada por las otras funciones, sabiendo que no modifica el half-edge
+  Index   getNumberOfCorners() const; //Hago a la función const para que pueda ser usada por las otras funciones, sabiendo que no modifica el half-edge
 
   // returns the index of the face containing the half edge
   // corresponding to the corner index iC; if the corner index is out
   // of range, or it corresponds to a face separator, this method
   // returns -1;
 
-  int     getFace(const int iC) const;
+  Index   getFace(const Index iC) const;
 
   // half-edges are in one-to-one correspondence with the corners of a
   // mesh, i.e., with the indices of the coordIndex array which do not
@@ -82,35 +123,85 @@ public:
   // the range 0<=iC<coordIndex.size(), or coordIndex[iC]<0, these
   // methods return -1;
 
-  int     getSrc(const int iC) const;
-  int     getDst(const int iC) const;
+  Index   getSrc(const Index iC) const;
+  Index   getDst(const Index iC) const;
 
   // the mesh faces define loops of half edges; these two methods can
   // be used to move back and forth along these loops;
 
-  int     getNext(const int iC) const;
-  int     getPrev(const int iC) const;
+  Index   getNext(const Index iC) const;
+  Index   getPrev(const Index iC) const;
 
   // a regular edge of a mesh has exactly two incident half-edges; if
   // the half-edge associated with corner iC corresponds to a regular
   // edge of the mesh, this methods returns the other half edge;
   // otherwie it returns -1
 
-  int     getTwin(const int iC) const;
+  Index   getTwin(const Index iC) const;
 
   // if the edge index iE is in range, this method returns the number
   // of half edges incident to the given edge; otherwise it returns 0
                                    
-  int     getNumberOfEdgeHalfEdges(const int iE) const;
+  Index   getNumberOfEdgeHalfEdges(const Index iE) const;
 
   // if the edge index iE is in range, and
   // 0<=j<getNumberOfEdgeHalfEdges(iE), this method returns the j-th
   // corner corresponding to a half edge incident to the given edge
 
-  int     getEdgeHalfEdge(const int iE, const int j) const;
+  Index   getEdgeHalfEdge(const Index iE, const Index j) const;
+
+  // returns the layout used by this instance
+  Layout  getInstanceLayout() const;
+
+  // with the FAST layout, if the face index iF is in range, returns
+  // the index of the first corner of the face; otherwise, or with the
+  // COMPACT layout, returns -1
+
+  Index   getFaceFirstCorner(const Index iF) const;
+
+  // returns the number of bytes allocated by the internal arrays,
+  // including those inherited from Edges; the coordIndex array is not
+  // included, since it is not owned by this class
+
+  size_t  getMemoryUsage() const;
 
 protected:
 
+  static BuildMethod _buildMethod; // default : INCREMENTAL
+  static Layout      _layout;      // default : COMPACT
+
+  // used by subclasses which may obtain the half edges by other
+  // means; if build is false the half edges are not built, and the
+  // subclass has to call _build() or _readHalfEdges()
+          HalfEdges(const Index nV, const vector<int>& coordIndex,
+                    const bool build);
+
+  // builds the half edges from the coordIndex array, using the
+  // current build method and layout
+  void    _build();
+
+  // removes all the half edges and edges, and changes the number of
+  // vertices; _build() can be called again afterwards
+  void    _resetHalfEdges(const Index nV);
+
+  // appends the half edge arrays, including those inherited from
+  // Edges, to the file; returns false on error
+  bool    _writeHalfEdges(FILE* fp) const;
+
+  // reads the arrays written by _writeHalfEdges() with the current
+  // layout; returns false if the file is too short, or the sizes of
+  // the arrays are not consistent with the coordIndex array and the
+  // layout, in which case the half edges are left empty, as before
+  // the call
+  bool    _readHalfEdges(MappedFile& file);
+
+  // SORT build method; half edges with repeated or out of range
+  // vertex indices are not associated with any edge
+  void    _buildSorted();
+
+  // FAST layout; fills the _faceFirstCorner and _nextPrev arrays
+  void    _buildFastLayout();
+
   // reference to the coordIndex passed as argument
   const vector<int>& _coordIndex;
 
@@ -118,15 +209,23 @@ protected:
   // - feel free to use different private variables
 
   // array of twin corners
-        vector<int>  _twin;
+        vector<Index>  _twin;
 
   // mapping from corners to faces
-        vector<int> _face;
+        vector<Index> _face;
 
   // the half-edge to edge incidence relations is represented as an
   // arrray of arrays
-        vector<int> _firstCornerEdge;
-        vector<int> _cornerEdge;
+        vector<Index> _firstCornerEdge;
+        vector<Index> _cornerEdge;
+
+  // FAST layout only; otherwise these arrays are empty
+  // - the corners of face iF are _faceFirstCorner[iF]<=iC<_faceFirstCorner[iF+1]-1
+  // - _nextPrev[2*iC] and _nextPrev[2*iC+1] are the next and prev
+  //   corners of iC, stored next to each other so that both are
+  //   loaded together
+        vector<Index> _faceFirstCorner;
+        vector<Index> _nextPrev;
 
 };
 
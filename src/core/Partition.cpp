@@ -41,7 +41,7 @@
 
 #include "Partition.hpp"
 
-Partition::Partition(const int nElements):
+Partition::Partition(const Index nElements):
   _nParts(0),
   _parent(),
   _size()
@@ -49,31 +49,31 @@ Partition::Partition(const int nElements):
   reset(nElements);
 }
 
-void Partition::reset(const int nElements) {
+void Partition::reset(const Index nElements) {
   _nParts = 0;
   _parent.clear();
   _size.clear();
   if(nElements>0) {
     _nParts = nElements;
-    for(int i=0;i<nElements;i++) {
+    for(Index i=0;i<nElements;i++) {
       _parent.push_back(i);
       _size.push_back(1);
     }
   }
 }
 
-int Partition::getNumberOfElements() const {
-  return static_cast<int>(_parent.size());
+Index Partition::getNumberOfElements() const {
+  return static_cast<Index>(_parent.size());
 }
 
-int Partition::getNumberOfParts() const {
+Index Partition::getNumberOfParts() const {
   return _nParts;
 }
 
-int Partition::find(const int i) {
+Index Partition::find(const Index i) {
   if(i<0) return -1;
   if(i>=getNumberOfElements()) return -1;
-  int Ri,Pj,j;
+  Index Ri,Pj,j;
   // traverse path and find root node
   for(Ri=i;_parent[Ri]!=Ri;Ri=_parent[Ri]);
   // compress the path:
@@ -83,10 +83,10 @@ int Partition::find(const int i) {
   return Ri;
 }
 
-int Partition::join(const int i, const int j) {
-  int Rij = -1;
-  int Ri = find(i);
-  int Rj = find(j);
+Index Partition::join(const Index i, const Index j) {
+  Index Rij = -1;
+  Index Ri = find(i);
+  Index Rj = find(j);
   if(Ri>=0 && Rj>=0 && (Rij=Ri)!=Rj) {
     _nParts--;
     if(_size[Ri]>=_size[Rj]) {
@@ -100,7 +100,7 @@ int Partition::join(const int i, const int j) {
   return Rij;
 }
 
-int Partition::getSize(const int i) const {
-  return (i<0 || i>=static_cast<int>(_parent.size()))?0:_size[i];
+Index Partition::getSize(const Index i) const {
+  return (i<0 || i>=static_cast<Index>(_parent.size()))?0:_size[i];
 
 }
@@ -40,60 +40,261 @@
 // DAMAGE.
 
 #include <iostream>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <functional>
 #include "PolygonMesh.hpp"
-#include "Partition.hpp"
+#include "ConcurrentPartition.hpp"
+#include "util/Parallel.hpp"
+#include "util/Hash.hpp"
 
-PolygonMesh::PolygonMesh(const int nVertices, const vector<int>& coordIndex):
-  HalfEdges(nVertices,coordIndex),
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// the topology cache files start with 8 bytes "DGPTOPO" followed by
+// a version number, which has to be incremented every time the
+// contents of the files change
+static const char     _topologyMagic[8] = "DGPTOPO";
+static const uint64_t _topologyVersion  = 3;
+
+string PolygonMesh::_cacheDirectory = "";
+
+void PolygonMesh::setCacheDirectory(const string& dir) {
+  _cacheDirectory = dir;
+}
+
+const string& PolygonMesh::getCacheDirectory() {
+  return _cacheDirectory;
+}
+
+// the hash of the constructor arguments names the cache file, and is
+// stored in its header
+static uint64_t _topologyHash(const Index nV, const vector<int>& coordIndex) {
+  return Hash::hash64(coordIndex.data(),coordIndex.size()*sizeof(int),
+                      static_cast<uint64_t>(nV));
+}
+
+string PolygonMesh::getCacheFilename
+(const Index nV, const vector<int>& coordIndex) {
+  return _cacheFilename(_topologyHash(nV,coordIndex));
+}
+
+string PolygonMesh::_cacheFilename(const uint64_t hash) {
+  char name[32];
+  snprintf(name,sizeof(name),"%016llx.topo",
+           static_cast<unsigned long long>(hash));
+  if(_cacheDirectory.empty()) return string(name);
+  return _cacheDirectory+"/"+name;
+}
+
+PolygonMesh::PolygonMesh(const Index nVertices, const vector<int>& coordIndex):
+  HalfEdges(nVertices,coordIndex,false),
   _nPartsVertex(),
-  _isBoundaryVertex()
+  _isBoundaryVertex(),
+  _firstCornerVertex(),
+  _cornerVertex(),
+  _nFaces(-1),
+  _nComponents(-1),
+  _faceComponent(),
+  _isOrientableComponent(),
+  _isReversedFace(),
+  _firstBoundaryLoop(),
+  _boundaryLoopCorner(),
+  _boundaryLoopVertex(),
+  _nextBoundaryHalfEdge(),
+  _fromCache(false)
 {
-  int nV = getNumberOfVertices();
-  int nE = getNumberOfEdges(); // Edges method
-  // int nF = getNumberOfFaces();
-  int nC = getNumberOfCorners();
+  // the vertices are classified on demand
+  if(_cacheDirectory.empty()) {
+    HalfEdges::_build();
+    return;
+  }
+  uint64_t hash = _topologyHash(nVertices,coordIndex);
+  string filename = _cacheFilename(hash);
+  if(_readTopology(filename,nVertices,hash)) {
+    _fromCache = true;
+    return;
+  }
+  // the classification is stored in the cache as well
+  HalfEdges::_build();
+  _buildBoundaryVertices();
+  _buildVertexParts();
+  // a cache which cannot be written is not an error
+  _writeTopology(filename,nVertices,hash);
+}
+
+bool PolygonMesh::isFromCache() const {
+  return _fromCache;
+}
+
+// the file contains a header, followed by the HalfEdges arrays and
+// the PolygonMesh arrays; the header contains the magic string, the
+// version, the size of the Index type, the nV argument of the
+// constructor, the size of the coordIndex array, the hash of the
+// arguments, and the HalfEdges build method and layout, which are
+// compared with those of this mesh before reading the rest of the
+// file, followed by the hash of the rest of the file, which detects
+// truncated or corrupted arrays
+static const int _topologyHeaderSize = 9;
+static const int _topologyChecksum   = 8;
+
+static void _topologyHeader
+(const Index nV, const vector<int>& coordIndex, const uint64_t hash,
+ uint64_t header[_topologyHeaderSize]) {
+  memcpy(&header[0],_topologyMagic,8);
+  header[1] = _topologyVersion;
+  header[2] = sizeof(Index);
+  header[3] = static_cast<uint64_t>(nV);
+  header[4] = static_cast<uint64_t>(coordIndex.size());
+  header[5] = hash;
+  header[6] = static_cast<uint64_t>(HalfEdges::getBuildMethod());
+  header[7] = static_cast<uint64_t>(HalfEdges::getLayout());
+  header[_topologyChecksum] = 0;
+}
+
+// hash of the bytes which follow the header
+static uint64_t _topologyChecksumOf(const MappedFile& file) {
+  size_t offset = _topologyHeaderSize*sizeof(uint64_t);
+  if(file.getSize()<offset) return 0;
+  return Hash::hash64(file.getData()+offset,file.getSize()-offset);
+}
+
+// the name of the temporary file is unique across processes and
+// threads writing the same cache file
+static string _topologyTmpFilename(const string& filename) {
+  static atomic<uint64_t> counter(0);
+  char suffix[64];
+  snprintf(suffix,sizeof(suffix),".%ld.%llx.%llu.tmp",
+           static_cast<long>(getpid()),
+           static_cast<unsigned long long>
+           (hash<thread::id>()(this_thread::get_id())),
+           static_cast<unsigned long long>(counter++));
+  return filename+suffix;
+}
+
+bool PolygonMesh::_writeTopology
+(const string& filename, const Index nV, const uint64_t hash) const {
+  uint64_t header[_topologyHeaderSize];
+  _topologyHeader(nV,_coordIndex,hash,header);
+  vector<char> isBoundaryVertex(_isBoundaryVertex.begin(),_isBoundaryVertex.end());
+  // written to a temporary file first, and then renamed, so that a
+  // concurrent reader never finds a partially written file
+  string tmpFilename = _topologyTmpFilename(filename);
+  FILE* fp = fopen(tmpFilename.c_str(),"wb");
+  if(fp==(FILE*)0) return false;
+  bool success =
+    fwrite(header,sizeof(header),1,fp)==1 &&
+    _writeHalfEdges(fp) &&
+    MappedFile::writeArray(fp,_nPartsVertex) &&
+    MappedFile::writeArray(fp,isBoundaryVertex);
+  success = (fclose(fp)==0) && success;
+  // the checksum of the arrays is written into the header last
+  if(success) {
+    uint64_t checksum;
+    {
+      MappedFile file(tmpFilename);
+      success = file.isMapped();
+      checksum = _topologyChecksumOf(file);
+    }
+    fp = (success)?fopen(tmpFilename.c_str(),"r+b"):(FILE*)0;
+    success =
+      fp!=(FILE*)0 &&
+      fseek(fp,_topologyChecksum*sizeof(uint64_t),SEEK_SET)==0 &&
+      fwrite(&checksum,sizeof(checksum),1,fp)==1;
+    if(fp!=(FILE*)0) success = (fclose(fp)==0) && success;
+  }
+  if(success) success = (rename(tmpFilename.c_str(),filename.c_str())==0);
+  if(success==false) remove(tmpFilename.c_str());
+  return success;
+}
+
+bool PolygonMesh::_readTopology
+(const string& filename, const Index nV, const uint64_t hash) {
+  MappedFile file(filename);
+  if(file.isMapped()==false) return false;
+  uint64_t header[_topologyHeaderSize],fileHeader[_topologyHeaderSize];
+  _topologyHeader(nV,_coordIndex,hash,header);
+  if(file.read(fileHeader,sizeof(fileHeader))==false ||
+     memcmp(header,fileHeader,_topologyChecksum*sizeof(uint64_t))!=0 ||
+     fileHeader[_topologyChecksum]!=_topologyChecksumOf(file))
+    return false;
+  if(_readHalfEdges(file)==false) return false;
+  vector<char> isBoundaryVertex;
+  size_t nVmesh = static_cast<size_t>(getNumberOfVertices());
+  if(file.readArray(_nPartsVertex)==false ||
+     file.readArray(isBoundaryVertex)==false ||
+     _nPartsVertex.size()!=nVmesh || isBoundaryVertex.size()!=nVmesh) {
+    _resetHalfEdges(nV);
+    _nPartsVertex.clear();
+    return false;
+  }
+  _isBoundaryVertex.assign(isBoundaryVertex.begin(),isBoundaryVertex.end());
+  return true;
+}
+
+void PolygonMesh::_buildBoundaryVertices() const {
+  Index nV = getNumberOfVertices();
+  Index nE = getNumberOfEdges(); // Edges method
 
   // 1) classify the vertices as boundary or internal
-  int iV;
+  Index iV;
+  _isBoundaryVertex.clear();
   for(iV=0;iV<nV;iV++)
     _isBoundaryVertex.push_back(false);
   // TODO
   // - for edge boundary iE label its two end vertices as boundary
-  for(int iE=0; iE<nE; iE++){
-      int nIncidentFaces = getNumberOfEdgeHalfEdges(iE);
+  for(Index iE=0; iE<nE; iE++){
+      Index nIncidentFaces = getNumberOfEdgeHalfEdges(iE);
       if(nIncidentFaces == 1){      //La arista es borde sii tiene una sola cara incidente (i.e., un solo half-edge incidente)
-          int V0 = getVertex0(iE);
-          int V1 = getVertex1(iE);
+          Index V0 = getVertex0(iE);
+          Index V1 = getVertex1(iE);
           _isBoundaryVertex[V0] = true;
           _isBoundaryVertex[V1] = true;
       }
   }
-  
-  // 2) create a partition of the corners in the stack
-  Partition partition(nC);
+}
+
+void PolygonMesh::_buildVertexParts() const {
+  const vector<int>& coordIndex = _coordIndex;
+  Index nV = getNumberOfVertices();
+  Index nE = getNumberOfEdges(); // Edges method
+  Index nC = getNumberOfCorners();
+
+  // 2) create a partition of the corners in the stack; the
+  //    ConcurrentPartition allows the join operations of the next
+  //    step to be applied from multiple threads
+  ConcurrentPartition partition(nC);
   // 3) for each regular edge
   //    - get the two half edges incident to the edge
   //    - join the two pairs of corresponding corners accross the edge
   //    - you need to take into account the relative orientation of
   //      the two incident half edges
 
-  for(int iE=0; iE<nE; iE++){
-      int nIncidentFaces = getNumberOfEdgeHalfEdges(iE);
-      if(nIncidentFaces == 2){      //La arista es regular sii tiene dos caras incidentes
-          int C0 = getEdgeHalfEdge(iE, 0);
-          int C1 = getEdgeHalfEdge(iE, 1);
-          if(coordIndex[C0] == coordIndex[getNext(C1)]){
-              // Las esquinas incidentes a iE, C0 y C1, estan consistentemente orientadas
-              partition.join(C0, getNext(C1));
-              partition.join(C1, getNext(C0));
-          } else {
-              //Las esquinas incidentes a iE, c0 y c1, no están consistentemente orientadas
-              partition.join(C0, C1);
-              partition.join(getNext(C0), getNext(C1));
-          }
+  Parallel::forRanges(nE,[&](Index /*iR*/, Index iE0, Index iE1) {
+    for(Index iE=iE0; iE<iE1; iE++){
+        Index nIncidentFaces = getNumberOfEdgeHalfEdges(iE);
+        if(nIncidentFaces == 2){      //La arista es regular sii tiene dos caras incidentes
+            Index C0 = getEdgeHalfEdge(iE, 0);
+            Index C1 = getEdgeHalfEdge(iE, 1);
+            if(coordIndex[C0] == coordIndex[getNext(C1)]){
+                // Las esquinas incidentes a iE, C0 y C1, estan consistentemente orientadas
+                partition.join(C0, getNext(C1));
+                partition.join(C1, getNext(C0));
+            } else {
+                //Las esquinas incidentes a iE, c0 y c1, no están consistentemente orientadas
+                partition.join(C0, C1);
+                partition.join(getNext(C0), getNext(C1));
+            }
 
-      }
-  }
+        }
+    }
+  });
 
   // consistently oriented
   /* \                  / */
@@ -126,42 +327,86 @@ PolygonMesh::PolygonMesh(const int nVertices, const vector<int>& coordIndex):
   //    - note that all the corners in each subset share a common
   //      vertex index, but multiple subsets may correspond to the
   //      same vertex index, indicating that the vertex is singular
-  for(int i=0; i<nV; i++){
-      _nPartsVertex.push_back(0);
-  }
-  for(int iC=0; iC<nC; iC++){
-      if(partition.find(iC)==iC && coordIndex[iC]>=0){
-          iV = coordIndex[iC];
-          _nPartsVertex[iV]++;
+  //    - the count is a parallel reduction, without atomic operations:
+  //      a) each range of corners marks its representatives, and
+  //         counts them per bucket of vertices, where vertex iV
+  //         belongs to bucket (iV*nB)/nV
+  //      b) a prefix sum of the counts, bucket major, gives each range
+  //         the position of its representatives within each bucket
+  //      c) each range scatters the vertex indices of its
+  //         representatives to those positions
+  //      d) each bucket is merged into _nPartsVertex by one thread, so
+  //         that no two threads increment the same element
+  _nPartsVertex.assign(nV,0);
+  if(nC==0 || nV==0) return;
+  Index nR = Parallel::getNumberOfRanges(nC);
+  Index nB = nR;
+  auto bucket = [nV,nB](const Index iV) {
+    return static_cast<Index>((static_cast<long long>(iV)*nB)/nV);
+  };
+  vector<char>  isRepresentative(nC,0);
+  vector<Index> nBucketRange(nR*nB,0); // [iR*nB+b]
+  Parallel::forRanges(nC,[&](Index iR, Index iC0, Index iC1) {
+    Index* nBucket = nBucketRange.data()+iR*nB;
+    for(Index iC=iC0; iC<iC1; iC++) {
+      Index iV = coordIndex[iC];
+      if(iV>=0 && iV<nV && partition.find(iC)==iC) {
+        isRepresentative[iC] = 1;
+        nBucket[bucket(iV)]++;
       }
-  }
+    }
+  });
+  vector<Index> firstBucketRange(nB*nR+1); // [b*nR+iR]
+  Index nParts = 0;
+  for(Index b=0; b<nB; b++)
+    for(Index iR=0; iR<nR; iR++) {
+      firstBucketRange[b*nR+iR] = nParts;
+      nParts += nBucketRange[iR*nB+b];
+    }
+  firstBucketRange[nB*nR] = nParts;
+  vector<Index> partVertex(nParts);
+  Parallel::forRanges(nC,[&](Index iR, Index iC0, Index iC1) {
+    vector<Index> next(nB);
+    for(Index b=0; b<nB; b++)
+      next[b] = firstBucketRange[b*nR+iR];
+    for(Index iC=iC0; iC<iC1; iC++)
+      if(isRepresentative[iC]) {
+        Index iV = coordIndex[iC];
+        partVertex[next[bucket(iV)]++] = iV;
+      }
+  });
+  Parallel::forRanges(nB,[&](Index /*iR*/, Index b0, Index b1) {
+    for(Index i=firstBucketRange[b0*nR]; i<firstBucketRange[b1*nR]; i++)
+      _nPartsVertex[partVertex[i]]++;
+  },1);
 }
 
-int PolygonMesh::getNumberOfFaces() const {
+Index PolygonMesh::getNumberOfFaces() const {
   // TODO
-  int nF = 0;
-  for(int i=0; i<getNumberOfCorners(); i++){
+  if(_nFaces>=0) return _nFaces;
+  Index nF = 0;
+  for(Index i=0; i<getNumberOfCorners(); i++){
       if(_coordIndex[i]<0) nF++;
   }
-  return nF;
+  return (_nFaces = nF);
 }
 
-int PolygonMesh::getNumberOfEdgeFaces(const int iE) const {
+Index PolygonMesh::getNumberOfEdgeFaces(const Index iE) const {
   return getNumberOfEdgeHalfEdges(iE);
 }
 
-int PolygonMesh::getEdgeFace(const int iE, const int j) const {
+Index PolygonMesh::getEdgeFace(const Index iE, const Index j) const {
   // TODO
-  int iC = getEdgeHalfEdge(iE, j);
+  Index iC = getEdgeHalfEdge(iE, j);
   return getFace(iC);               //Si los parámetros son inválidos, getEdgeHalfEdge retorna -1 y getFace(-1) retorna -1
 }
 
-bool PolygonMesh::isEdgeFace(const int iE, const int iF) const {
+bool PolygonMesh::isEdgeFace(const Index iE, const Index iF) const {
   // TODO
   bool result = false;
-  int nHE = getNumberOfEdgeHalfEdges(iE);
-  for(int i=0; i<nHE; i++){
-      int iC = getEdgeHalfEdge(iE, i);
+  Index nHE = getNumberOfEdgeHalfEdges(iE);
+  for(Index i=0; i<nHE; i++){
+      Index iC = getEdgeHalfEdge(iE, i);
       if(getFace(iC)==iF){
           result = true;
           break;
@@ -172,36 +417,40 @@ bool PolygonMesh::isEdgeFace(const int iE, const int iF) const {
 
 // classification of edges
 
-bool PolygonMesh::isBoundaryEdge(const int iE) const {
+bool PolygonMesh::isBoundaryEdge(const Index iE) const {
   // TODO
   return (getNumberOfEdgeFaces(iE)==1);
 }
 
-bool PolygonMesh::isRegularEdge(const int iE) const {
+bool PolygonMesh::isRegularEdge(const Index iE) const {
   // TODO
   return (getNumberOfEdgeFaces(iE)==2);
 }
 
-bool PolygonMesh::isSingularEdge(const int iE) const {
+bool PolygonMesh::isSingularEdge(const Index iE) const {
   // TODO
   return (getNumberOfEdgeFaces(iE)>=3);
 }
 
 // classification of vertices
 
-bool PolygonMesh::isBoundaryVertex(const int iV) const {
-  int nV = getNumberOfVertices();
-  return (0<=iV && iV<nV)?_isBoundaryVertex[iV]:false;
+bool PolygonMesh::isBoundaryVertex(const Index iV) const {
+  Index nV = getNumberOfVertices();
+  if(iV<0 || iV>=nV) return false;
+  if(_isBoundaryVertex.empty()) _buildBoundaryVertices();
+  return _isBoundaryVertex[iV];
 }
 
-bool PolygonMesh::isInternalVertex(const int iV) const{
-  int nV = getNumberOfVertices();
+bool PolygonMesh::isInternalVertex(const Index iV) const{
+  Index nV = getNumberOfVertices();
   return (0<=iV && iV<nV)?(!isBoundaryVertex(iV)):false;
 }
 
-bool PolygonMesh::isSingularVertex(const int iV) const {
-  int nV = getNumberOfVertices();
-  return ((0<=iV && iV<nV) && _nPartsVertex[iV]>1);
+bool PolygonMesh::isSingularVertex(const Index iV) const {
+  Index nV = getNumberOfVertices();
+  if(iV<0 || iV>=nV) return false;
+  if(_nPartsVertex.empty()) _buildVertexParts();
+  return (_nPartsVertex[iV]>1);
 }
 
 // properties of the whole mesh
@@ -209,16 +458,16 @@ bool PolygonMesh::isSingularVertex(const int iV) const {
 bool PolygonMesh::isRegular() const {
   // TODO
   bool result = true;
-  int nE = getNumberOfEdges();
-  int nV = getNumberOfVertices();
-  for(int iE=0; iE<nE; iE++){
+  Index nE = getNumberOfEdges();
+  Index nV = getNumberOfVertices();
+  for(Index iE=0; iE<nE; iE++){
       if(isSingularEdge(iE)){
           result = false;
           break;
       }
   }
   if(result){
-      for(int iV=0; iV<nV; iV++){
+      for(Index iV=0; iV<nV; iV++){
           if(isSingularVertex(iV)){
               result = false;
               break;
@@ -231,8 +480,8 @@ bool PolygonMesh::isRegular() const {
 bool PolygonMesh::hasBoundary() const {
   // TODO
   bool result = false;
-  int nE = getNumberOfEdges();
-  for(int iE=0; iE<nE; iE++){
+  Index nE = getNumberOfEdges();
+  for(Index iE=0; iE<nE; iE++){
       if(isBoundaryEdge(iE)){
           result = true;
           break;
@@ -240,3 +489,392 @@ bool PolygonMesh::hasBoundary() const {
   }
   return result;
 }
+
+size_t PolygonMesh::getMemoryUsage() const {
+  return HalfEdges::getMemoryUsage()+
+    sizeof(Index)*(_nPartsVertex.capacity()+
+                   _firstCornerVertex.capacity()+_cornerVertex.capacity()+
+                   _faceComponent.capacity()+
+                   _firstBoundaryLoop.capacity()+
+                   _boundaryLoopCorner.capacity()+
+                   _boundaryLoopVertex.capacity()+
+                   _nextBoundaryHalfEdge.capacity())+
+    _isOrientableComponent.capacity()+_isReversedFace.capacity()+
+    _isBoundaryVertex.capacity()/8;
+}
+
+// vertex one-rings
+
+void PolygonMesh::_buildVertexCorners() const {
+  Index nV = getNumberOfVertices();
+  Index nC = getNumberOfCorners();
+  // count the corners of each vertex in _firstCornerVertex[iV+1]
+  _firstCornerVertex.assign(nV+1,0);
+  Index iC,iV;
+  for(iC=0;iC<nC;iC++)
+    if(0<=(iV=_coordIndex[iC]) && iV<nV)
+      _firstCornerVertex[iV+1]++;
+  for(iV=0;iV<nV;iV++)
+    _firstCornerVertex[iV+1] += _firstCornerVertex[iV];
+  // fill the lists in increasing order of corner index
+  _cornerVertex.resize(_firstCornerVertex[nV]);
+  vector<Index> next(_firstCornerVertex.begin(),_firstCornerVertex.end()-1);
+  for(iC=0;iC<nC;iC++)
+    if(0<=(iV=_coordIndex[iC]) && iV<nV)
+      _cornerVertex[next[iV]++] = iC;
+}
+
+Index PolygonMesh::getNumberOfVertexCorners(const Index iV) const {
+  if(iV<0 || iV>=getNumberOfVertices()) return 0;
+  if(_firstCornerVertex.empty()) _buildVertexCorners();
+  return _firstCornerVertex[iV+1]-_firstCornerVertex[iV];
+}
+
+Index PolygonMesh::getVertexCorner(const Index iV, const Index j) const {
+  if(j<0 || j>=getNumberOfVertexCorners(iV)) return -1;
+  return _cornerVertex[_firstCornerVertex[iV]+j];
+}
+
+bool PolygonMesh::getVertexOneRing(const Index iV, vector<Index>& corners) const {
+  corners.clear();
+  Index n = getNumberOfVertexCorners(iV);
+  if(n==0) return true;
+  const Index* vertexCorner = &_cornerVertex[_firstCornerVertex[iV]];
+
+  if(isSingularVertex(iV)==false) {
+    // each corner iC of the vertex is incident to two half edges
+    // containing the vertex : the outgoing half edge iC, and the
+    // incoming half edge getPrev(iC); the walk arrives to each corner
+    // through one of them, and leaves through the other one, to the
+    // twin half edge, which can have either orientation
+    //
+    // - returns the corner of the vertex in the face of the twin of
+    //   the half edge iH, or -1 if there is no twin; sets out to true
+    //   if the walk should leave the new corner through its outgoing
+    //   half edge
+    auto cross = [this,iV](const Index iH, bool& out) -> Index {
+      Index iT = getTwin(iH);
+      if(iT<0) return -1;
+      if(_coordIndex[iT]==iV) { out = false; return iT; }
+      out = true;
+      return getNext(iT);
+    };
+
+    // 1) walk leaving through the outgoing half edges until a
+    //    boundary half edge is found, or the walk returns to the
+    //    first corner
+    Index iC0 = vertexCorner[0];
+    Index iC  = iC0;
+    bool out = true;
+    Index nSteps = 0;
+    for(;;) {
+      bool nextOut;
+      Index iCn = cross(out?iC:getPrev(iC),nextOut);
+      if(iCn<0 || iCn==iC0 || ++nSteps>n) break;
+      iC = iCn; out = nextOut;
+    }
+
+    // 2) walk in the opposite direction from the last corner found,
+    //    collecting the corners; if the walk returned to the first
+    //    corner the ring is closed, and the walk starts there
+    if(nSteps<=n) {
+      if(getTwin(out?iC:getPrev(iC))>=0) {
+        iC  = iC0;
+        out = false;
+      } else {
+        out = !out;
+      }
+      iC0 = iC;
+      do {
+        corners.push_back(iC);
+        bool nextOut;
+        iC = cross(out?iC:getPrev(iC),nextOut);
+        out = nextOut;
+      } while(iC>=0 && iC!=iC0 &&
+              static_cast<Index>(corners.size())<=n);
+    }
+
+    if(static_cast<Index>(corners.size())==n) return true;
+    corners.clear();
+  }
+
+  // fall back to the incidence list
+  corners.assign(vertexCorner,vertexCorner+n);
+  return false;
+}
+
+// components and orientation
+
+void PolygonMesh::_buildComponents() const {
+  Index nE = getNumberOfEdges();
+  Index nF = getNumberOfFaces();
+
+  // 1) join the two faces incident to each regular edge; the faces
+  //    are joined from multiple threads
+  ConcurrentPartition partition(nF);
+  Parallel::forRanges(nE,[&](Index /*iR*/, Index iE0, Index iE1) {
+    for(Index iE=iE0;iE<iE1;iE++)
+      if(getNumberOfEdgeHalfEdges(iE)==2)
+        partition.join(getFace(getEdgeHalfEdge(iE,0)),
+                       getFace(getEdgeHalfEdge(iE,1)));
+  });
+
+  // 2) the representative of each part is its lowest face; mark the
+  //    representatives in parallel, and number them serially
+  _faceComponent.assign(nF,-1);
+  Parallel::forRanges(nF,[&](Index /*iR*/, Index iF0, Index iF1) {
+    for(Index iF=iF0;iF<iF1;iF++)
+      _faceComponent[iF] = partition.find(iF);
+  });
+  vector<Index> component(nF,-1);
+  _nComponents = 0;
+  for(Index iF=0;iF<nF;iF++)
+    if(_faceComponent[iF]==iF)
+      component[iF] = _nComponents++;
+
+  // 3) replace the representatives by the component numbers
+  Parallel::forRanges(nF,[&](Index /*iR*/, Index iF0, Index iF1) {
+    for(Index iF=iF0;iF<iF1;iF++)
+      _faceComponent[iF] = component[_faceComponent[iF]];
+  });
+}
+
+Index PolygonMesh::getNumberOfComponents() const {
+  if(_nComponents<0) _buildComponents();
+  return _nComponents;
+}
+
+Index PolygonMesh::getFaceComponent(const Index iF) const {
+  if(iF<0 || iF>=getNumberOfFaces()) return -1;
+  if(_nComponents<0) _buildComponents();
+  return _faceComponent[iF];
+}
+
+bool PolygonMesh::isConsistentlyOrientedEdge(const Index iE) const {
+  if(getNumberOfEdgeHalfEdges(iE)!=2) return false;
+  Index iC0 = getEdgeHalfEdge(iE,0);
+  Index iC1 = getEdgeHalfEdge(iE,1);
+  // opposite directions : the src of iC0 is the dst of iC1
+  return (_coordIndex[iC0]==_coordIndex[getNext(iC1)]);
+}
+
+void PolygonMesh::_buildOrientation() const {
+  Index nF = getNumberOfFaces();
+  Index nC = getNumberOfCorners();
+  Index nComp = getNumberOfComponents();
+
+  // first corner of each face
+  vector<Index> faceFirstCorner(nF+1,0);
+  for(Index iF=0,iC=0;iC<nC;iC++)
+    if(_coordIndex[iC]<0) faceFirstCorner[++iF] = iC+1;
+
+  // state of each face : 0=not visited, 1=kept, 2=reversed; the state
+  // of a face is set once, by the first thread which reaches it
+  vector<atomic<char>> state(nF);
+  vector<atomic<char>> conflict(nComp);
+  for(Index iF=0;iF<nF;iF++) state[iF].store(0,memory_order_relaxed);
+  for(Index iK=0;iK<nComp;iK++) conflict[iK].store(0,memory_order_relaxed);
+
+  // 1) the search starts at the lowest face of every component
+  vector<Index> frontier;
+  for(Index iF=0,iK=0;iF<nF && iK<nComp;iF++)
+    if(_faceComponent[iF]==iK) {
+      state[iF].store(1,memory_order_relaxed);
+      frontier.push_back(iF);
+      iK++;
+    }
+
+  // 2) level synchronous breadth first search; the faces of each
+  //    level are split into ranges, and each range produces its own
+  //    part of the next level
+  while(frontier.empty()==false) {
+    Index nFrontier = static_cast<Index>(frontier.size());
+    vector<vector<Index>> next(Parallel::getNumberOfRanges(nFrontier,1024));
+    Parallel::forRanges(nFrontier,[&](Index iR, Index i0, Index i1) {
+      for(Index i=i0;i<i1;i++) {
+        Index iF = frontier[i];
+        char stateF = state[iF].load(memory_order_relaxed);
+        for(Index iC=faceFirstCorner[iF];iC<faceFirstCorner[iF+1]-1;iC++) {
+          Index iE = getEdge(_coordIndex[iC],getDst(iC));
+          if(getNumberOfEdgeHalfEdges(iE)!=2) continue;
+          Index jC = getEdgeHalfEdge(iE,0);
+          if(jC==iC) jC = getEdgeHalfEdge(iE,1);
+          Index jF = getFace(jC);
+          // the neighbor keeps the state of iF if the two half edges
+          // have opposite directions
+          char stateJ = stateF;
+          if(_coordIndex[iC]!=_coordIndex[getNext(jC)])
+            stateJ = (stateF==1)?2:1;
+          char expected = 0;
+          if(state[jF].compare_exchange_strong(expected,stateJ,memory_order_relaxed))
+            next[iR].push_back(jF);
+          else if(expected!=stateJ)
+            conflict[_faceComponent[iF]].store(1,memory_order_relaxed);
+        }
+      }
+    },1024);
+    frontier.clear();
+    for(auto& nextR : next)
+      frontier.insert(frontier.end(),nextR.begin(),nextR.end());
+  }
+
+  // 3) faces of non orientable components are not reversed
+  _isOrientableComponent.assign(nComp,1);
+  for(Index iK=0;iK<nComp;iK++)
+    if(conflict[iK].load(memory_order_relaxed)) _isOrientableComponent[iK] = 0;
+  _isReversedFace.assign(nF,0);
+  for(Index iF=0;iF<nF;iF++)
+    _isReversedFace[iF] =
+      (state[iF].load(memory_order_relaxed)==2 &&
+       _isOrientableComponent[_faceComponent[iF]]);
+}
+
+bool PolygonMesh::isOrientableComponent(const Index iComp) const {
+  if(iComp<0 || iComp>=getNumberOfComponents()) return false;
+  if(_isOrientableComponent.empty()) _buildOrientation();
+  return (_isOrientableComponent[iComp]!=0);
+}
+
+bool PolygonMesh::isReversedFace(const Index iF) const {
+  if(iF<0 || iF>=getNumberOfFaces()) return false;
+  if(_isReversedFace.empty()) _buildOrientation();
+  return (_isReversedFace[iF]!=0);
+}
+
+Index PolygonMesh::getOrientedCoordIndex(vector<int>& coordIndex) const {
+  Index nC = getNumberOfCorners();
+  coordIndex.assign(_coordIndex.begin(),_coordIndex.end());
+  if(getNumberOfFaces()>0 && _isReversedFace.empty()) _buildOrientation();
+  Index nReversed = 0;
+  for(Index iF=0,iC0=0,iC1=0;iC1<nC;iC1++) {
+    if(_coordIndex[iC1]>=0) continue;
+    if(_isReversedFace[iF]) {
+      reverse(coordIndex.begin()+iC0,coordIndex.begin()+iC1);
+      nReversed++;
+    }
+    iC0 = iC1+1; iF++;
+  }
+  return nReversed;
+}
+
+// boundary loops
+
+void PolygonMesh::_buildBoundaryLoops() const {
+  Index nV = getNumberOfVertices();
+  Index nE = getNumberOfEdges();
+  Index nC = getNumberOfCorners();
+  Index iV,iE,iC,jC,k;
+
+  // 1) the boundary half edges, in edge order
+  vector<Index> boundaryCorner;
+  for(iE=0;iE<nE;iE++)
+    if(getNumberOfEdgeHalfEdges(iE)==1)
+      boundaryCorner.push_back(getEdgeHalfEdge(iE,0));
+  Index nB = static_cast<Index>(boundaryCorner.size());
+
+  // 2) boundary half edges incident to each vertex, at either end, as
+  //    an array of arrays filled with a counting sort
+  vector<Index> firstVertex(nV+1,0);
+  for(Index b=0;b<nB;b++) {
+    iC = boundaryCorner[b];
+    firstVertex[getSrc(iC)+1]++;
+    firstVertex[getDst(iC)+1]++;
+  }
+  for(iV=0;iV<nV;iV++)
+    firstVertex[iV+1] += firstVertex[iV];
+  vector<Index> vertexCorner(firstVertex[nV]);
+  vector<Index> next(firstVertex.begin(),firstVertex.end()-1);
+  for(Index b=0;b<nB;b++) {
+    iC = boundaryCorner[b];
+    vertexCorner[next[getSrc(iC)]++] = iC;
+    vertexCorner[next[getDst(iC)]++] = iC;
+  }
+
+  // 3) walk the loops; at each vertex the walk continues along the
+  //    first boundary half edge not used yet, which is unique for a
+  //    regular boundary vertex; each vertex keeps a cursor into its
+  //    list, which only moves forward, so that the whole walk is
+  //    linear in the number of boundary half edges; half edges
+  //    traversed from dst to src, because of inconsistently oriented
+  //    faces, are handled by keeping track of the current vertex
+  _nextBoundaryHalfEdge.assign(nC,-1);
+  _firstBoundaryLoop.assign(1,0);
+  _boundaryLoopCorner.clear();
+  _boundaryLoopVertex.clear();
+  vector<char> used(nC,0);
+  vector<Index>& cursor = next;
+  // number of boundary half edges incident to each vertex not used yet
+  vector<Index> nFree(nV);
+  for(iV=0;iV<nV;iV++) {
+    cursor[iV] = firstVertex[iV];
+    nFree[iV]  = firstVertex[iV+1]-firstVertex[iV];
+  }
+  auto firstFree = [&](const Index jV) {
+    for(k=cursor[jV];k<firstVertex[jV+1] && used[vertexCorner[k]];k++);
+    cursor[jV] = k;
+    return (k<firstVertex[jV+1])?vertexCorner[k]:-1;
+  };
+  // walks a loop starting at the vertex iV0 along the half edge iC0;
+  // an open chain is never closed, since it cannot return to iV0
+  // with no free half edges left
+  auto walk = [&](const Index iC0, const Index iV0, const bool open) {
+    iC = iC0;
+    iV = iV0;
+    for(;;) {
+      used[iC] = 1;
+      nFree[getSrc(iC)]--;
+      nFree[getDst(iC)]--;
+      _boundaryLoopCorner.push_back(iC);
+      _boundaryLoopVertex.push_back(iV);
+      iV = (getSrc(iC)==iV)?getDst(iC):getSrc(iC);
+      // close the loop as soon as it returns to the first vertex
+      if(open==false && iV==iV0) {
+        _nextBoundaryHalfEdge[iC] = iC0;
+        break;
+      }
+      jC = firstFree(iV);
+      if(jC<0) break;
+      _nextBoundaryHalfEdge[iC] = jC;
+      iC = jC;
+    }
+    _firstBoundaryLoop.push_back(static_cast<Index>(_boundaryLoopCorner.size()));
+  };
+  // a walk can only stop at a vertex with an odd number of free half
+  // edges, so the open chains, which end at singular edges, are
+  // walked first from one of their ends, and are not split into
+  // fragments; the free half edges of every vertex are even afterwards
+  for(Index iV0=0;iV0<nV;iV0++)
+    while(nFree[iV0]%2!=0)
+      walk(firstFree(iV0),iV0,true);
+  // and the rest are closed loops
+  for(Index b=0;b<nB;b++) {
+    iC = boundaryCorner[b];
+    if(used[iC]==0) walk(iC,getSrc(iC),false);
+  }
+}
+
+Index PolygonMesh::getNumberOfBoundaryLoops() const {
+  if(_firstBoundaryLoop.empty()) _buildBoundaryLoops();
+  return static_cast<Index>(_firstBoundaryLoop.size())-1;
+}
+
+Index PolygonMesh::getBoundaryLoopSize(const Index iL) const {
+  if(iL<0 || iL>=getNumberOfBoundaryLoops()) return 0;
+  return _firstBoundaryLoop[iL+1]-_firstBoundaryLoop[iL];
+}
+
+Index PolygonMesh::getBoundaryLoopCorner(const Index iL, const Index j) const {
+  if(j<0 || j>=getBoundaryLoopSize(iL)) return -1;
+  return _boundaryLoopCorner[_firstBoundaryLoop[iL]+j];
+}
+
+Index PolygonMesh::getBoundaryLoopVertex(const Index iL, const Index j) const {
+  if(j<0 || j>=getBoundaryLoopSize(iL)) return -1;
+  return _boundaryLoopVertex[_firstBoundaryLoop[iL]+j];
+}
+
+Index PolygonMesh::getNextBoundaryHalfEdge(const Index iC) const {
+  if(iC<0 || iC>=getNumberOfCorners()) return -1;
+  if(_firstBoundaryLoop.empty()) _buildBoundaryLoops();
+  return _nextBoundaryHalfEdge[iC];
+}
@@ -43,6 +43,7 @@
 #define _POLYGONMESH_HPP_
 
 #include <vector>
+#include <string>
 #include "HalfEdges.hpp"
 
 using namespace std;
@@ -53,70 +54,100 @@ public:
 
   // inherits from Edges
   //
-  // void    reset(const int nV);
-  // int     getNumberOfVertices()                     const;
-  // int     getNumberOfEdges()                        const;
-  // int     getEdge(const int iV0, const int iV1)     const;
-  // int     getVertex0(const int iE)                  const;
-  // int     getVertex1(const int iE)                  const;
+  // void    reset(const Index nV);
+  // Index   getNumberOfVertices()                     const;
+  // Index   getNumberOfEdges()                        const;
+  // Index   getEdge(const Index iV0, const Index iV1) const;
+  // Index   getVertex0(const Index iE)                const;
+  // Index   getVertex1(const Index iE)                const;
 
   // inherits from HalfEdges
   //
-  // int     getNumberOfCorners();
-  // int     getFace(const int iC) const;
-  // int     getSrc(const int iC) const;
-  // int     getDst(const int iC) const;
-  // int     getNext(const int iC) const;
-  // int     getPrev(const int iC) const;
-  // int     getTwin(const int iC) const;
-  // int     getNumberOfEdgeHalfEdges(const int iE);
-  // int     getEdgeHalfEdge(const int iE, const int j);
+  // Index   getNumberOfCorners();
+  // Index   getFace(const Index iC) const;
+  // Index   getSrc(const Index iC) const;
+  // Index   getDst(const Index iC) const;
+  // Index   getNext(const Index iC) const;
+  // Index   getPrev(const Index iC) const;
+  // Index   getTwin(const Index iC) const;
+  // Index   getNumberOfEdgeHalfEdges(const Index iE);
+  // Index   getEdgeHalfEdge(const Index iE, const Index j);
 
-             PolygonMesh(const int nV, const vector<int>& coordIndex);
+  // topology cache; if the cache directory is not empty, the
+  // constructor looks in it for the file getCacheFilename(nV,coordIndex)
+  // written by a previous construction from the same arguments; if
+  // the file is found, and its header matches the arguments and the
+  // current HalfEdges build method and layout, the topology is read
+  // from the file instead of being computed; otherwise it is computed,
+  // and written to the file; the default value is the empty string,
+  // which disables the cache
 
-  // number of -1's in the coordIndex argument
+  static void          setCacheDirectory(const string& dir);
+  static const string& getCacheDirectory();
 
-     int     getNumberOfFaces()                        const;
+  // returns the name of the cache file, which is made of a 64 bit
+  // hash of the arguments, in the cache directory
+
+  static string        getCacheFilename(const Index nV,
+                                        const vector<int>& coordIndex);
+
+             PolygonMesh(const Index nV, const vector<int>& coordIndex);
+
+  // returns true if the topology was read from the cache
+
+     bool    isFromCache()                             const;
+
+  // number of -1's in the coordIndex argument; counted the first
+  // time this method is called
+
+     Index   getNumberOfFaces()                        const;
 
   // number of faces incident to each edge; note that this is equal to
   // the number of half edges incident to each edge
 
-     int     getNumberOfEdgeFaces(const int iE)        const;
+     Index   getNumberOfEdgeFaces(const Index iE)      const;
 
   // if the arguments fall within their respective ranges, this method
   // returns the j-th face in the list of faces incident to the edge
   // iE; and it returns -1 if either argument is out of range
 
-     int     getEdgeFace(const int iE, const int j)    const;
+     Index   getEdgeFace(const Index iE, const Index j) const;
 
   // if the arguments fall within their respective ranges, this method
   // returns returns true if iF is found in the list of faces incident
   // to the edge iE; otherwise it returns false
 
-     bool    isEdgeFace(const int iE, const int iF)    const;
+     bool    isEdgeFace(const Index iE, const Index iF) const;
 
   // edges are classified as boundary, regular, or singular depending
   // on the number of incident faces: 1=boundary, 2=regular, 3 or
   // more=singular
 
-     bool    isBoundaryEdge(const int iE)               const;
-     bool    isRegularEdge(const int iE)               const;
-     bool    isSingularEdge(const int iE)              const;
+     bool    isBoundaryEdge(const Index iE)             const;
+     bool    isRegularEdge(const Index iE)             const;
+     bool    isSingularEdge(const Index iE)            const;
+
+  // the vertex classification is computed on demand: the boundary
+  // vertices the first time isBoundaryVertex() or isInternalVertex()
+  // is called, and the singular vertices the first time
+  // isSingularVertex() or isRegular() is called; the edge
+  // classification, and hasBoundary(), only require the number of
+  // half edges incident to each edge, and are always available
 
   // a vertex is boundary if and only if it is the end of a boundary
   // edge
 
-     bool    isBoundaryVertex(const int iV)            const;
+     bool    isBoundaryVertex(const Index iV)          const;
 
   // a vertex is internal if and only if it is not a boundary edge
 
-     bool    isInternalVertex(const int iV)            const;
+     bool    isInternalVertex(const Index iV)          const;
 
   // a vertex is singular if the number of connected components in the
   // subgraph of the dual graph defined by the subset of faces
   // incident to the vertex is larger than 1; otherwise it is regular
 
-     bool    isSingularVertex(const int iV)            const;
+     bool    isSingularVertex(const Index iV)          const;
 
   // a way to determine which vertices are singular and which are
   // regular is to construct a partition of the corners of the mesh,
@@ -164,14 +195,157 @@ public:
   // boundary edge
 
      bool    hasBoundary()                             const;
+
+  // vertex to corner incidence lists; if the vertex index iV is in
+  // range, these methods return the number of corners iC such that
+  // getSrc(iC)==iV, and the j-th of those corners, in increasing
+  // order; otherwise they return 0 and -1 respectively; the lists are
+  // built with a counting sort of the corners the first time one of
+  // these methods is called
+
+     Index   getNumberOfVertexCorners(const Index iV)  const;
+     Index   getVertexCorner(const Index iV, const Index j) const;
+
+  // fills the corners array with the corners of the vertex iV,
+  // ordered around the vertex; consecutive corners belong to faces
+  // which share an edge incident to the vertex; for a consistently
+  // oriented mesh, the corner following iC is getTwin(getPrev(iC));
+  // for a boundary vertex the first and last corners are in faces
+  // incident to boundary edges; inconsistently oriented faces are
+  // traversed as well; if the vertex is singular, or the half edges
+  // around the vertex do not form a single fan, the corners are
+  // returned in the order of the incidence list, and the method
+  // returns false; otherwise it returns true
+  //
+  // the faces, edges, and neighbor vertices of the one-ring can be
+  // obtained from the corners with getFace(iC), getEdge(iV,getDst(iC))
+  // and getDst(iC)
+
+     bool    getVertexOneRing(const Index iV, vector<Index>& corners) const;
+
+  // face connected components; two faces are connected if they share
+  // a regular edge; the components are numbered in increasing order
+  // of their lowest face index; the faces are joined in parallel in
+  // a ConcurrentPartition the first time one of these methods is
+  // called; getFaceComponent() returns -1 if iF is out of range
+
+     Index   getNumberOfComponents()                   const;
+     Index   getFaceComponent(const Index iF)          const;
+
+  // a regular edge is consistently oriented if its two half edges
+  // traverse it in opposite directions; returns false for boundary
+  // and singular edges
+
+     bool    isConsistentlyOrientedEdge(const Index iE) const;
+
+  // orientation of the components; a breadth first search across the
+  // regular edges, starting at the lowest face of every component,
+  // determines which faces have to be reversed to agree with the
+  // orientation of the starting face; the faces of each level of the
+  // search are visited in parallel; a component is orientable if no
+  // conflicts are found during the search; faces of non orientable
+  // components are never reversed; computed the first time one of
+  // these methods is called
+
+     bool    isOrientableComponent(const Index iComp)  const;
+     bool    isReversedFace(const Index iF)            const;
+
+  // copies the coordIndex array passed to the constructor into the
+  // argument, with the corners of the faces for which
+  // isReversedFace() returns true in reverse order, so that every
+  // orientable component is consistently oriented; returns the
+  // number of reversed faces; a new PolygonMesh has to be
+  // constructed from the result
+
+     Index   getOrientedCoordIndex(vector<int>& coordIndex) const;
+
+  // boundary loops; the boundary half edges, i.e. the half edges of
+  // the boundary edges, are linked into loops, and the loops are
+  // stored as an array of arrays; the j-th element of the loop iL is
+  // the boundary half edge getBoundaryLoopCorner(iL,j), traversed
+  // starting at the vertex getBoundaryLoopVertex(iL,j); with
+  // consistently oriented faces this vertex is always getSrc() of the
+  // half edge, but a half edge of a face with the opposite orientation
+  // is traversed from getDst() to getSrc(); at a singular vertex, with
+  // more than two incident boundary edges, the loops are joined in
+  // the order of the edges; a chain which ends at a singular edge is
+  // returned as an open loop; the loops, and the next boundary half
+  // edge table, are built in time linear in the number of edges the
+  // first time one of these methods is called; out of range
+  // arguments return 0 and -1 respectively
+
+     Index   getNumberOfBoundaryLoops()                const;
+     Index   getBoundaryLoopSize(const Index iL)       const;
+     Index   getBoundaryLoopCorner(const Index iL, const Index j) const;
+     Index   getBoundaryLoopVertex(const Index iL, const Index j) const;
+
+  // if iC is a boundary half edge, returns the boundary half edge
+  // which follows iC in its loop; returns -1 if iC is not a boundary
+  // half edge, or it is the last half edge of an open loop
+
+     Index   getNextBoundaryHalfEdge(const Index iC)   const;
+
+  // returns the number of bytes allocated by the internal arrays,
+  // including those inherited from HalfEdges
+
+     size_t  getMemoryUsage()                          const;
   
 private:
 
+  static string _cacheDirectory; // default : ""
+
+  // vertex classification; build _isBoundaryVertex and
+  // _nPartsVertex respectively, after the half edges
+  void             _buildBoundaryVertices()            const;
+  void             _buildVertexParts()                 const;
+
+  // components and orientation
+  void             _buildComponents()                  const;
+  void             _buildOrientation()                 const;
+
+  // builds the boundary loops
+  void             _buildBoundaryLoops()               const;
+
+  // read and write the cache file; hash is the hash of the
+  // constructor arguments, which is computed once per construction
+  static string    _cacheFilename(const uint64_t hash);
+  bool             _readTopology(const string& filename, const Index nV,
+                                 const uint64_t hash);
+  bool             _writeTopology(const string& filename, const Index nV,
+                                  const uint64_t hash) const;
+
+  // builds _firstCornerVertex and _cornerVertex
+  void             _buildVertexCorners()               const;
+
   // consider these private variables a suggestion
   // feel free to decide how to implement this class
 
-  vector<int>      _nPartsVertex;
-  vector<bool> _isBoundaryVertex;
+  // empty until first used
+  mutable vector<Index> _nPartsVertex;
+  mutable vector<bool>  _isBoundaryVertex;
+
+  // vertex to corner incidence lists, as an array of arrays; empty
+  // until first used
+  mutable vector<Index> _firstCornerVertex;
+  mutable vector<Index> _cornerVertex;
+
+  // number of faces; -1 until first used
+  mutable Index _nFaces;
+
+  // components and orientation; empty, or -1, until first used
+  mutable Index         _nComponents;
+  mutable vector<Index> _faceComponent;
+  mutable vector<char>  _isOrientableComponent;
+  mutable vector<char>  _isReversedFace;
+
+  // boundary loops, as an array of arrays, and the next boundary half
+  // edge of each corner; empty until first used
+  mutable vector<Index> _firstBoundaryLoop;
+  mutable vector<Index> _boundaryLoopCorner;
+  mutable vector<Index> _boundaryLoopVertex;
+  mutable vector<Index> _nextBoundaryHalfEdge;
+
+  bool _fromCache;
   
 };
 
@@ -41,17 +41,80 @@
 
 #include <iostream>
 #include "PolygonMeshTest.hpp"
+#include "TriangleMesh.hpp"
 #include <wrl/Shape.hpp>
 #include <wrl/Appearance.hpp>
 #include <wrl/Material.hpp>
 #include <wrl/IndexedFaceSet.hpp>
 #include <wrl/SceneGraphTraversal.hpp>
 
+// prints the number of vertices, edges, faces, and corners of the
+// mesh, and the classification of its edges and vertices; the Mesh
+// class can be either PolygonMesh or TriangleMesh
+template <class Mesh>
+static void _printMesh(const Mesh& mesh, const string& indent, ostream& ostr) {
+  Index nV = mesh.getNumberOfVertices();
+  Index nE = mesh.getNumberOfEdges();
+  Index nF = mesh.getNumberOfFaces();
+  Index nC = mesh.getNumberOfCorners();
+
+  ostr << indent << "  nV          = " << nV << endl;
+  ostr << indent << "  nE          = " << nE << endl;
+  ostr << indent << "  nF          = " << nF << endl;
+  ostr << indent << "  nC          = " << nC << endl;
+
+  // print info about the mesh
+
+  Index nV_boundary  = 0;
+  Index nV_internal  = 0;
+  Index nV_singular  = 0;
+  Index nV_regular = 0;
+  Index nE_boundary  = 0;
+  Index nE_regular = 0;
+  Index nE_singular  = 0;
+  Index nE_other   = 0;
+
+  Index iE,iV;
+
+  for(iE=0;iE<nE;iE++) {
+    if(mesh.isBoundaryEdge(iE)) {
+      nE_boundary++;
+    } else if(mesh.isRegularEdge(iE)) {
+      nE_regular++;
+    } else if(mesh.isSingularEdge(iE)) {
+      nE_singular++;
+    } else {
+      nE_other++;
+    }
+  }
+
+  for(iV=0;iV<nV;iV++) {
+    if(mesh.isBoundaryVertex(iV))
+      nV_boundary++;
+    if(mesh.isSingularVertex(iV))
+      nV_singular++;
+  }
+
+  nV_internal = nV-nV_boundary;
+  nV_regular  = nV-nV_singular;
+
+  ostr << indent << "  nV_boundary = " << nV_boundary << endl;
+  ostr << indent << "  nV_internal = " << nV_internal << endl;
+  ostr << indent << "  nV_regular  = " << nV_regular  << endl;
+  ostr << indent << "  nV_singular = " << nV_singular << endl;
+  ostr << indent << "  nE_boundary = " << nE_boundary << endl;
+  ostr << indent << "  nE_regular  = " << nE_regular  << endl;
+  ostr << indent << "  nE_singular = " << nE_singular << endl;
+  ostr << indent << "  nE_other    = " << nE_other    << endl;
+  ostr << indent << "  isRegular   = " << mesh.isRegular() << endl;
+  ostr << indent << "  hasBoundary = " << mesh.hasBoundary() << endl;
+}
+
 PolygonMeshTest::PolygonMeshTest
 (SceneGraph& wrl, const string& indent, ostream& ostr):_ostr(ostr) {
   _ostr << indent << "PolygonMeshTest {" << endl;
 
-  int nIndexedFaceSet = 0;
+  Index nIndexedFaceSet = 0;
 
   SceneGraphTraversal traversal(wrl);
   Node* node = (Node*)0;
@@ -88,72 +151,23 @@ PolygonMeshTest::PolygonMeshTest
               << "    geometry IndexedFaceSet[" << nIndexedFaceSet << "] {" << endl;
         IndexedFaceSet* ifs = (IndexedFaceSet*)node;
 
-        int nVifs = ifs->getNumberOfCoord();
-        vector<int>& coordIndex = ifs->getCoordIndex();
+        Index nVifs = ifs->getNumberOfCoord();
+        const vector<int>& coordIndex = ifs->getCoordIndex();
 
         _ostr << indent << "      nV(ifs) = " << nVifs << endl;
 
         _ostr << indent << "      PolygonMesh(nV,coordIndex) {" << endl;
 
         PolygonMesh pMesh(nVifs,coordIndex);
+        _printMesh(pMesh,indent+"      ",_ostr);
+        _ostr << indent << "      } PolygonMesh" << endl;
 
-        int nV = pMesh.getNumberOfVertices();
-        int nE = pMesh.getNumberOfEdges();
-        int nF = pMesh.getNumberOfFaces();
-        int nC = pMesh.getNumberOfCorners();
-
-        _ostr << indent << "        nV          = " << nV << endl;
-        _ostr << indent << "        nE          = " << nE << endl;
-        _ostr << indent << "        nF          = " << nF << endl;
-        _ostr << indent << "        nC          = " << nC << endl;
-
-        // print info about the polygon mesh
-
-        int nV_boundary  = 0;
-        int nV_internal  = 0;
-        int nV_singular  = 0;
-        int nV_regular   = 0;
-        int nE_boundary  = 0;
-        int nE_regular   = 0;
-        int nE_singular  = 0;
-        int nE_other     = 0;
-
-        int iE,iV;
-
-        for(iE=0;iE<nE;iE++) {
-          if(pMesh.isBoundaryEdge(iE)) {
-            nE_boundary++;
-          } else if(pMesh.isRegularEdge(iE)) {
-            nE_regular++;
-          } else if(pMesh.isSingularEdge(iE)) {
-            nE_singular++;
-          } else {
-            nE_other++;
-          }
-        }
-
-        for(iV=0;iV<nV;iV++) {
-          if(pMesh.isBoundaryVertex(iV))
-            nV_boundary++;
-          if(pMesh.isSingularVertex(iV))
-            nV_singular++;
+        if(TriangleMesh::isTriangleMesh(coordIndex)) {
+          _ostr << indent << "      TriangleMesh(nV,coordIndex) {" << endl;
+          TriangleMesh tMesh(nVifs,coordIndex);
+          _printMesh(tMesh,indent+"      ",_ostr);
+          _ostr << indent << "      } TriangleMesh" << endl;
         }
-
-        nV_internal = nV-nV_boundary;
-        nV_regular  = nV-nV_singular;
-
-        _ostr << indent << "        nV_boundary = " << nV_boundary << endl;
-        _ostr << indent << "        nV_internal = " << nV_internal << endl;
-        _ostr << indent << "        nV_regular  = " << nV_regular  << endl;
-        _ostr << indent << "        nV_singular = " << nV_singular << endl;
-        _ostr << indent << "        nE_boundary = " << nE_boundary << endl;
-        _ostr << indent << "        nE_regular  = " << nE_regular  << endl;
-        _ostr << indent << "        nE_singular = " << nE_singular << endl;
-        _ostr << indent << "        nE_other    = " << nE_other    << endl;
-        _ostr << indent << "        isRegular   = " << pMesh.isRegular() << endl;
-        _ostr << indent << "        hasBoundary = " << pMesh.hasBoundary() << endl;
-
-        _ostr << indent << "      } PolygonMesh" << endl;
         _ostr << indent << "    } IndexedFaceSet" << endl;
         nIndexedFaceSet++;
       } else {
@@ -0,0 +1,674 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// TriangleMesh.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#include <algorithm>
+#include "TriangleMesh.hpp"
+#include "ConcurrentPartition.hpp"
+#include "util/Parallel.hpp"
+
+// static
+
+bool TriangleMesh::isTriangleMesh(const vector<int>& coordIndex) {
+  Index nC = static_cast<Index>(coordIndex.size());
+  Index iC0,iC1;
+  for(iC0=iC1=0;iC1<nC;iC1++) {
+    if(coordIndex[iC1]>=0) continue;
+    if(iC1-iC0!=3) return false;
+    iC0 = iC1+1;
+  }
+  return (iC0==nC);
+}
+
+TriangleMesh::TriangleMesh(const Index nVertices, const vector<int>& coordIndex):
+  Edges(nVertices),
+  _triangles(),
+  _twin(),
+  _firstCornerEdge(),
+  _nCornersEdge(),
+  _cornerEdge(),
+  _nPartsVertex(),
+  _isBoundaryVertex()
+{
+  // copy the vertex indices of the triangular faces, skipping the
+  //    face separators
+  Index nCoordIndex = static_cast<Index>(coordIndex.size());
+  _triangles.reserve(3*(nCoordIndex/4));
+  Index iC0,iC1;
+  for(iC0=iC1=0;iC1<nCoordIndex;iC1++) {
+    if(coordIndex[iC1]>=0) continue;
+    if(iC1-iC0==3)
+      _triangles.insert(_triangles.end(),
+                        coordIndex.begin()+iC0,coordIndex.begin()+iC1);
+    iC0 = iC1+1;
+  }
+
+  _build();
+}
+
+void TriangleMesh::_build() {
+  Index nV = getNumberOfVertices();
+  Index nC = getNumberOfCorners();
+
+  // 1) insert all the edges in the graph, and count the number of
+  //    half edges incident to each edge in _firstCornerEdge[iE+1];
+  //    half edges with repeated or out of range vertex indices are
+  //    not associated with any edge
+  vector<Index> cornerEdge(nC,-1);
+  _reserveEdges(nC/2);
+  _firstCornerEdge.assign(1,0);
+  Index iC,iE;
+  for(iC=0;iC<nC;iC++) {
+    iE = _insertEdge(_triangles[iC],_triangles[nextUnchecked(iC)]);
+    cornerEdge[iC] = iE;
+    if(iE<0) continue;
+    if(iE+1==static_cast<Index>(_firstCornerEdge.size()))
+      _firstCornerEdge.push_back(0);
+    _firstCornerEdge[iE+1]++;
+  }
+  Index nE = getNumberOfEdges();
+
+  // 2) accumulate the counts and fill the half edge to edge
+  //    incidence lists
+  _nCornersEdge.resize(nE);
+  for(iE=0;iE<nE;iE++) {
+    _nCornersEdge[iE] = _firstCornerEdge[iE+1];
+    _firstCornerEdge[iE+1] += _firstCornerEdge[iE];
+  }
+  _cornerEdge.resize(_firstCornerEdge[nE]);
+  vector<Index> next(_firstCornerEdge.begin(),_firstCornerEdge.end()-1);
+  for(iC=0;iC<nC;iC++)
+    if((iE=cornerEdge[iC])>=0)
+      _cornerEdge[next[iE]++] = iC;
+
+  // 3) the two half edges incident to each regular edge are twins;
+  //    all the other half edges are boundary half edges
+  _twin.assign(nC,-1);
+  for(iE=0;iE<nE;iE++) {
+    if(getNumberOfEdgeHalfEdges(iE)!=2) continue;
+    Index iC0 = _cornerEdge[_firstCornerEdge[iE]];
+    Index iC1 = _cornerEdge[_firstCornerEdge[iE]+1];
+    _twin[iC0] = iC1;
+    _twin[iC1] = iC0;
+  }
+
+  // 4) classify the vertices as boundary or internal
+  _isBoundaryVertex.assign(nV,false);
+  for(iE=0;iE<nE;iE++) {
+    if(getNumberOfEdgeHalfEdges(iE)==1) {
+      _isBoundaryVertex[getVertex0(iE)] = true;
+      _isBoundaryVertex[getVertex1(iE)] = true;
+    }
+  }
+
+  // 5) join the pairs of corners opposite to each other accross the
+  //    regular edges, as in the PolygonMesh constructor, and count the
+  //    number of parts per vertex
+  ConcurrentPartition partition(nC);
+  Parallel::forRanges(nC,[&](Index /*iR*/, Index i0, Index i1) {
+    for(Index iC0=i0;iC0<i1;iC0++) {
+      Index iC1 = _twin[iC0];
+      if(iC1<iC0) continue;
+      if(_triangles[iC0]==_triangles[nextUnchecked(iC1)]) {
+        partition.join(iC0,nextUnchecked(iC1));
+        partition.join(iC1,nextUnchecked(iC0));
+      } else {
+        partition.join(iC0,iC1);
+        partition.join(nextUnchecked(iC0),nextUnchecked(iC1));
+      }
+    }
+  });
+  vector<char> isRepresentative(nC,0);
+  Parallel::forRanges(nC,[&](Index /*iR*/, Index i0, Index i1) {
+    for(Index i=i0;i<i1;i++)
+      isRepresentative[i] = (partition.find(i)==i);
+  });
+  _nPartsVertex.assign(nV,0);
+  for(iC=0;iC<nC;iC++) {
+    Index iV = _triangles[iC];
+    if(isRepresentative[iC] && 0<=iV && iV<nV)
+      _nPartsVertex[iV]++;
+  }
+}
+
+const vector<Index>& TriangleMesh::getTriangles() const {
+  return _triangles;
+}
+
+Index TriangleMesh::getNumberOfFaces() const {
+  return static_cast<Index>(_triangles.size())/3;
+}
+
+Index TriangleMesh::getNumberOfCorners() const {
+  return static_cast<Index>(_triangles.size());
+}
+
+// half edge methods
+
+Index TriangleMesh::getFace(const Index iC) const {
+  if(iC<0 || iC>=getNumberOfCorners()) return -1;
+  return faceUnchecked(iC);
+}
+
+Index TriangleMesh::getSrc(const Index iC) const {
+  if(iC<0 || iC>=getNumberOfCorners()) return -1;
+  return _triangles[iC];
+}
+
+Index TriangleMesh::getDst(const Index iC) const {
+  if(iC<0 || iC>=getNumberOfCorners()) return -1;
+  return _triangles[nextUnchecked(iC)];
+}
+
+Index TriangleMesh::getNext(const Index iC) const {
+  if(iC<0 || iC>=getNumberOfCorners()) return -1;
+  return nextUnchecked(iC);
+}
+
+Index TriangleMesh::getPrev(const Index iC) const {
+  if(iC<0 || iC>=getNumberOfCorners()) return -1;
+  return prevUnchecked(iC);
+}
+
+Index TriangleMesh::getTwin(const Index iC) const {
+  if(iC<0 || iC>=getNumberOfCorners()) return -1;
+  return _twin[iC];
+}
+
+Index TriangleMesh::getNumberOfEdgeHalfEdges(const Index iE) const {
+  if(iE<0 || iE>=getNumberOfEdges()) return 0;
+  return _nCornersEdge[iE];
+}
+
+Index TriangleMesh::getEdgeHalfEdge(const Index iE, const Index j) const {
+  if(j<0 || j>=getNumberOfEdgeHalfEdges(iE)) return -1;
+  return _cornerEdge[_firstCornerEdge[iE]+j];
+}
+
+// edge faces
+
+Index TriangleMesh::getNumberOfEdgeFaces(const Index iE) const {
+  return getNumberOfEdgeHalfEdges(iE);
+}
+
+Index TriangleMesh::getEdgeFace(const Index iE, const Index j) const {
+  return getFace(getEdgeHalfEdge(iE,j));
+}
+
+bool TriangleMesh::isEdgeFace(const Index iE, const Index iF) const {
+  Index nH = getNumberOfEdgeHalfEdges(iE);
+  for(Index j=0;j<nH;j++)
+    if(getEdgeFace(iE,j)==iF) return true;
+  return false;
+}
+
+// classification of edges
+
+bool TriangleMesh::isBoundaryEdge(const Index iE) const {
+  return (getNumberOfEdgeFaces(iE)==1);
+}
+
+bool TriangleMesh::isRegularEdge(const Index iE) const {
+  return (getNumberOfEdgeFaces(iE)==2);
+}
+
+bool TriangleMesh::isSingularEdge(const Index iE) const {
+  return (getNumberOfEdgeFaces(iE)>=3);
+}
+
+// classification of vertices
+
+bool TriangleMesh::isBoundaryVertex(const Index iV) const {
+  Index nV = getNumberOfVertices();
+  return (0<=iV && iV<nV)?_isBoundaryVertex[iV]:false;
+}
+
+bool TriangleMesh::isInternalVertex(const Index iV) const {
+  Index nV = getNumberOfVertices();
+  return (0<=iV && iV<nV)?(!_isBoundaryVertex[iV]):false;
+}
+
+bool TriangleMesh::isSingularVertex(const Index iV) const {
+  Index nV = getNumberOfVertices();
+  return ((0<=iV && iV<nV) && _nPartsVertex[iV]>1);
+}
+
+// properties of the whole mesh
+
+bool TriangleMesh::isRegular() const {
+  Index nE = getNumberOfEdges();
+  for(Index iE=0;iE<nE;iE++)
+    if(isSingularEdge(iE)) return false;
+  Index nV = getNumberOfVertices();
+  for(Index iV=0;iV<nV;iV++)
+    if(isSingularVertex(iV)) return false;
+  return true;
+}
+
+bool TriangleMesh::hasBoundary() const {
+  Index nE = getNumberOfEdges();
+  for(Index iE=0;iE<nE;iE++)
+    if(isBoundaryEdge(iE)) return true;
+  return false;
+}
+
+size_t TriangleMesh::getMemoryUsage() const {
+  return Edges::getMemoryUsage()+
+    sizeof(Index)*(_triangles.capacity()+_twin.capacity()+
+                 _firstCornerEdge.capacity()+_nCornersEdge.capacity()+
+                 _cornerEdge.capacity()+
+                 _nPartsVertex.capacity())+
+    _isBoundaryVertex.capacity()/8;
+}
+
+// local editing operations
+
+Index TriangleMesh::_getCornerEdge(const Index iC) const {
+  return getEdge(_triangles[iC],_triangles[nextUnchecked(iC)]);
+}
+
+void TriangleMesh::_setTwins(const Index iC0, const Index iC1) {
+  if(iC0>=0) _twin[iC0] = iC1;
+  if(iC1>=0) _twin[iC1] = iC0;
+}
+
+void TriangleMesh::_appendEdgeList(const Index iE, const Index capacity) {
+  // edges are created in increasing order, so the list of the new
+  // edge goes at the end of the _cornerEdge array
+  _firstCornerEdge.push_back(_firstCornerEdge[iE]+capacity);
+  _nCornersEdge.push_back(0);
+  _cornerEdge.resize(_firstCornerEdge[iE+1],-1);
+}
+
+void TriangleMesh::_addEdgeCorner(const Index iE, const Index iC) {
+  _cornerEdge[_firstCornerEdge[iE]+_nCornersEdge[iE]++] = iC;
+}
+
+void TriangleMesh::_replaceEdgeCorner(const Index iE, const Index iC, const Index jC) {
+  Index j0 = _firstCornerEdge[iE];
+  Index j1 = j0+_nCornersEdge[iE];
+  for(Index j=j0;j<j1;j++) {
+    if(_cornerEdge[j]!=iC) continue;
+    if(jC>=0) {
+      _cornerEdge[j] = jC;
+    } else {
+      // keep the remaining corners in the same order
+      for(;j+1<j1;j++) _cornerEdge[j] = _cornerEdge[j+1];
+      _cornerEdge[j1-1] = -1;
+      _nCornersEdge[iE]--;
+    }
+    break;
+  }
+}
+
+Index TriangleMesh::_crossHalfEdge(const Index iV, const Index iH, bool& out) const {
+  Index iT = _twin[iH];
+  if(iT<0) return -1;
+  if(_triangles[iT]==iV) { out = false; return iT; }
+  out = true;
+  return nextUnchecked(iT);
+}
+
+bool TriangleMesh::_vertexFan(const Index iC, vector<Index>& corners) const {
+  // each corner of the vertex is incident to two half edges
+  // containing the vertex : the outgoing half edge jC, and the
+  // incoming half edge getPrev(jC); the walk leaves each corner
+  // through the half edge opposite to the one it arrived from, as in
+  // PolygonMesh::getVertexOneRing()
+  Index iV = _triangles[iC];
+  corners.clear();
+  corners.push_back(iC);
+  Index jC = iC;
+  bool out = true;
+  bool nextOut;
+  while((jC=_crossHalfEdge(iV,out?jC:prevUnchecked(jC),nextOut))>=0) {
+    if(jC==iC) return true;
+    corners.push_back(jC);
+    out = nextOut;
+  }
+  // the fan is open : walk in the opposite direction from iC
+  vector<Index> back;
+  jC  = iC;
+  out = false;
+  while((jC=_crossHalfEdge(iV,out?jC:prevUnchecked(jC),nextOut))>=0) {
+    back.push_back(jC);
+    out = nextOut;
+  }
+  corners.insert(corners.begin(),back.rbegin(),back.rend());
+  return false;
+}
+
+Index TriangleMesh::flipEdge(const Index iE) {
+  if(getNumberOfEdgeHalfEdges(iE)!=2) return -1;
+  // iC0=(a,b) and iC1=(b,a)
+  Index iC0 = getEdgeHalfEdge(iE,0);
+  Index iC1 = getEdgeHalfEdge(iE,1);
+  Index iVa = _triangles[iC0];
+  Index iVb = _triangles[nextUnchecked(iC0)];
+  if(_triangles[iC1]!=iVb) return -1;
+  Index iVc = _triangles[prevUnchecked(iC0)];
+  Index iVd = _triangles[prevUnchecked(iC1)];
+  if(iVc==iVd || iVc==iVa || iVc==iVb || iVd==iVa || iVd==iVb) return -1;
+  if(getEdge(iVc,iVd)>=0) return -1;
+  if(isSingularVertex(iVa) || isSingularVertex(iVb) ||
+     isSingularVertex(iVc) || isSingularVertex(iVd)) return -1;
+
+  // half edges of the quadrilateral a->d->b->c->a, their edges, and
+  // their twins
+  Index iCad = nextUnchecked(iC1), iCdb = prevUnchecked(iC1);
+  Index iCbc = nextUnchecked(iC0), iCca = prevUnchecked(iC0);
+  Index iEad = _getCornerEdge(iCad), iEdb = _getCornerEdge(iCdb);
+  Index iEbc = _getCornerEdge(iCbc), iEca = _getCornerEdge(iCca);
+  Index iTad = _twin[iCad], iTdb = _twin[iCdb];
+  Index iTbc = _twin[iCbc], iTca = _twin[iCca];
+
+  // rewrite the two faces as (a,d,c) and (d,b,c)
+  Index iC0f = 3*(iC0/3);
+  Index iC1f = 3*(iC1/3);
+  _triangles[iC0f] = iVa; _triangles[iC0f+1] = iVd; _triangles[iC0f+2] = iVc;
+  _triangles[iC1f] = iVd; _triangles[iC1f+1] = iVb; _triangles[iC1f+2] = iVc;
+
+  _replaceEdgeCorner(iEad,iCad,iC0f  ); _setTwins(iC0f  ,iTad);
+  _replaceEdgeCorner(iEca,iCca,iC0f+2); _setTwins(iC0f+2,iTca);
+  _replaceEdgeCorner(iEdb,iCdb,iC1f  ); _setTwins(iC1f  ,iTdb);
+  _replaceEdgeCorner(iEbc,iCbc,iC1f+1); _setTwins(iC1f+1,iTbc);
+
+  // the edge index iE is reused for the new edge (c,d)
+  _moveEdge(iE,iVc,iVd);
+  _cornerEdge[_firstCornerEdge[iE]  ] = iC0f+1;
+  _cornerEdge[_firstCornerEdge[iE]+1] = iC1f+2;
+  _setTwins(iC0f+1,iC1f+2);
+
+  // the boundary edges and the regular vertices are not affected
+  return iE;
+}
+
+Index TriangleMesh::splitEdge(const Index iE) {
+  Index nH = getNumberOfEdgeHalfEdges(iE);
+  if(nH<1) return -1;
+  Index iVa = getVertex0(iE);
+  Index iVb = getVertex1(iE);
+  vector<Index> corner(nH),opposite(nH);
+  Index j,k;
+  for(j=0;j<nH;j++) {
+    corner[j]   = getEdgeHalfEdge(iE,j);
+    opposite[j] = _triangles[prevUnchecked(corner[j])];
+    if(opposite[j]==iVa || opposite[j]==iVb) return -1;
+    for(k=0;k<j;k++)
+      if(opposite[k]==opposite[j]) return -1;
+  }
+
+  // the new vertex is boundary if the edge is boundary; each
+  // triangle incident to a singular edge produces a separate part
+  Index iVm = _insertVertex();
+  _isBoundaryVertex.push_back(nH==1);
+  _nPartsVertex.push_back((nH==2)?1:nH);
+
+  // the edge index iE is reused for the edge (a,m)
+  _moveEdge(iE,iVa,iVm);
+  Index iEmb = _insertEdge(iVm,iVb);
+  _appendEdgeList(iEmb,nH);
+
+  for(j=0;j<nH;j++) {
+    // the triangle (s,t,o) becomes (s,m,o), keeping the corners
+    // iC=(s,m), iCn=(m,o) and iCp=(o,s); the new triangle (m,t,o)
+    // has the corners iG=(m,t), iG+1=(t,o), and iG+2=(o,m)
+    Index iC  = corner[j];
+    Index iCn = nextUnchecked(iC);
+    Index iVs = _triangles[iC];
+    Index iVt = _triangles[iCn];
+    Index iVo = opposite[j];
+    Index iEto = _getCornerEdge(iCn);
+    Index iTto = _twin[iCn];
+    Index iG  = getNumberOfCorners();
+    _triangles.push_back(iVm); _triangles.push_back(iVt); _triangles.push_back(iVo);
+    _twin.push_back(-1); _twin.push_back(-1); _twin.push_back(-1);
+    _triangles[iCn] = iVm;
+
+    _replaceEdgeCorner(iEto,iCn,iG+1);
+    _setTwins(iG+1,iTto);
+
+    if(iVs==iVa) {
+      // iC=(a,m) remains in the list of iE, and iG=(m,b)
+      _addEdgeCorner(iEmb,iG);
+    } else {
+      // iC=(b,m), and iG=(m,a) replaces it in the list of iE
+      _replaceEdgeCorner(iE,iC,iG);
+      _addEdgeCorner(iEmb,iC);
+    }
+
+    Index iEmo = _insertEdge(iVm,iVo);
+    _appendEdgeList(iEmo,2);
+    _addEdgeCorner(iEmo,iCn);
+    _addEdgeCorner(iEmo,iG+2);
+    _setTwins(iCn,iG+2);
+  }
+
+  // the half edges incident to (a,m) and (m,b) are twins only if
+  // the original edge was regular
+  Index iEh[2] = { iE, iEmb };
+  for(k=0;k<2;k++) {
+    for(j=0;j<nH;j++)
+      _twin[getEdgeHalfEdge(iEh[k],j)] = -1;
+    if(nH==2)
+      _setTwins(getEdgeHalfEdge(iEh[k],0),getEdgeHalfEdge(iEh[k],1));
+  }
+
+  return iVm;
+}
+
+Index TriangleMesh::splitFace(const Index iF) {
+  if(iF<0 || iF>=getNumberOfFaces() || isDeletedFace(iF)) return -1;
+  Index iC  = 3*iF;
+  Index iVa = _triangles[iC];
+  Index iVb = _triangles[iC+1];
+  Index iVc = _triangles[iC+2];
+  if(iVa==iVb || iVb==iVc || iVc==iVa) return -1;
+  Index iEbc = _getCornerEdge(iC+1);
+  Index iEca = _getCornerEdge(iC+2);
+  Index iTbc = _twin[iC+1];
+  Index iTca = _twin[iC+2];
+
+  Index iVm = _insertVertex();
+  _isBoundaryVertex.push_back(false);
+  _nPartsVertex.push_back(1);
+
+  // the face becomes (a,b,m), and the two new faces are (b,c,m) and
+  // (c,a,m)
+  Index iG1 = getNumberOfCorners();
+  Index iG2 = iG1+3;
+  _triangles.push_back(iVb); _triangles.push_back(iVc); _triangles.push_back(iVm);
+  _triangles.push_back(iVc); _triangles.push_back(iVa); _triangles.push_back(iVm);
+  _twin.insert(_twin.end(),6,-1);
+  _triangles[iC+2] = iVm;
+
+  _replaceEdgeCorner(iEbc,iC+1,iG1); _setTwins(iG1,iTbc);
+  _replaceEdgeCorner(iEca,iC+2,iG2); _setTwins(iG2,iTca);
+
+  // the three new edges are regular
+  Index iCm[3][2] = { { iC+1, iG1+2 }, { iG1+1, iG2+2 }, { iG2+1, iC+2 } };
+  for(Index k=0;k<3;k++) {
+    Index iEm = _insertEdge(_triangles[iCm[k][0]],iVm);
+    _appendEdgeList(iEm,2);
+    _addEdgeCorner(iEm,iCm[k][0]);
+    _addEdgeCorner(iEm,iCm[k][1]);
+    _setTwins(iCm[k][0],iCm[k][1]);
+  }
+
+  return iVm;
+}
+
+Index TriangleMesh::collapseEdge(const Index iE) {
+  Index nH = getNumberOfEdgeHalfEdges(iE);
+  if(nH<1 || nH>2) return -1;
+  Index iVa = getVertex0(iE);
+  Index iVb = getVertex1(iE);
+  if(isSingularVertex(iVa) || isSingularVertex(iVb)) return -1;
+  if(nH==2 && isBoundaryVertex(iVa) && isBoundaryVertex(iVb)) return -1;
+
+  // for each triangle (a,b,o) incident to the edge, the half edges
+  // on the edges (a,o) and (b,o), and their edges
+  Index iVo[2],iCao[2],iCbo[2],iEao[2],iEbo[2];
+  Index j,k;
+  for(j=0;j<nH;j++) {
+    Index iC  = getEdgeHalfEdge(iE,j);
+    Index iCn = nextUnchecked(iC);
+    Index iCp = prevUnchecked(iC);
+    iVo[j] = _triangles[iCp];
+    if(iVo[j]==iVa || iVo[j]==iVb) return -1;
+    if(_triangles[iC]==iVa) {
+      iCbo[j] = iCn; iCao[j] = iCp;
+    } else {
+      iCao[j] = iCn; iCbo[j] = iCp;
+    }
+    iEao[j] = _getCornerEdge(iCao[j]);
+    iEbo[j] = _getCornerEdge(iCbo[j]);
+    Index nHao = getNumberOfEdgeHalfEdges(iEao[j]);
+    Index nHbo = getNumberOfEdgeHalfEdges(iEbo[j]);
+    if(nHao>2 || nHbo>2 || nHao+nHbo<=2) return -1;
+  }
+  if(nH==2 && iVo[0]==iVo[1]) return -1;
+
+  // link condition : the only common neighbors of a and b should be
+  // the opposite vertices
+  Index iC0 = getEdgeHalfEdge(iE,0);
+  Index iCa = (_triangles[iC0]==iVa)?iC0:nextUnchecked(iC0);
+  Index iCb = (_triangles[iC0]==iVb)?iC0:nextUnchecked(iC0);
+  vector<Index> fanA,fanB,neighborA;
+  _vertexFan(iCa,fanA);
+  _vertexFan(iCb,fanB);
+  for(Index iC : fanA) {
+    neighborA.push_back(_triangles[nextUnchecked(iC)]);
+    neighborA.push_back(_triangles[prevUnchecked(iC)]);
+  }
+  sort(neighborA.begin(),neighborA.end());
+  for(Index iC : fanB) {
+    Index iVx[2] = { _triangles[nextUnchecked(iC)], _triangles[prevUnchecked(iC)] };
+    for(k=0;k<2;k++) {
+      if(iVx[k]==iVa || iVx[k]==iVo[0] || iVx[k]==iVo[nH-1]) continue;
+      if(binary_search(neighborA.begin(),neighborA.end(),iVx[k])) return -1;
+    }
+  }
+
+  // edges incident to b which are not incident to the removed
+  // triangles; they will be moved to a
+  vector<Index> edgeB;
+  for(Index iC : fanB) {
+    Index iF = iC/3;
+    if(iF==iC0/3 || (nH==2 && iF==getEdgeHalfEdge(iE,1)/3)) continue;
+    edgeB.push_back(_getCornerEdge(iC));
+    edgeB.push_back(_getCornerEdge(prevUnchecked(iC)));
+  }
+  for(j=0;j<nH;j++)
+    edgeB.erase(remove(edgeB.begin(),edgeB.end(),iEbo[j]),edgeB.end());
+  sort(edgeB.begin(),edgeB.end());
+  edgeB.erase(unique(edgeB.begin(),edgeB.end()),edgeB.end());
+
+  // remove the edge and the triangles incident to it
+  Index iFdead[2];
+  for(j=0;j<nH;j++) iFdead[j] = getEdgeHalfEdge(iE,j)/3;
+  _removeEdge(iE);
+  for(j=0;j<nH;j++) _cornerEdge[_firstCornerEdge[iE]+j] = -1;
+  _nCornersEdge[iE] = 0;
+
+  // merge the edges (a,o) and (b,o) of each removed triangle
+  for(j=0;j<nH;j++) {
+    _replaceEdgeCorner(iEao[j],iCao[j],-1);
+    _replaceEdgeCorner(iEbo[j],iCbo[j],-1);
+    Index iHa = getEdgeHalfEdge(iEao[j],0);
+    Index iHb = getEdgeHalfEdge(iEbo[j],0);
+    Index nHm = getNumberOfEdgeHalfEdges(iEao[j])+getNumberOfEdgeHalfEdges(iEbo[j]);
+    // keep the edge whose list has enough capacity
+    Index iEkeep = iEao[j];
+    Index iEdrop = iEbo[j];
+    if(_firstCornerEdge[iEkeep+1]-_firstCornerEdge[iEkeep]<nHm) {
+      iEkeep = iEbo[j]; iEdrop = iEao[j];
+    }
+    Index iHdrop = getEdgeHalfEdge(iEdrop,0);
+    if(iHdrop>=0) {
+      _replaceEdgeCorner(iEdrop,iHdrop,-1);
+      _addEdgeCorner(iEkeep,iHdrop);
+    }
+    _removeEdge(iEdrop);
+    if(iEkeep==iEbo[j]) _moveEdge(iEkeep,iVa,iVo[j]);
+    _setTwins(iHa,iHb);
+  }
+
+  // move the other edges of b to a, and replace b by a in the
+  // remaining triangles
+  for(Index iEb : edgeB) {
+    Index iVx = (getVertex0(iEb)==iVb)?getVertex1(iEb):getVertex0(iEb);
+    _moveEdge(iEb,iVa,iVx);
+  }
+  for(Index iC : fanB)
+    _triangles[iC] = iVa;
+  for(j=0;j<nH;j++) {
+    for(k=3*iFdead[j];k<3*iFdead[j]+3;k++) {
+      _triangles[k] = -1;
+      _twin[k]      = -1;
+    }
+  }
+
+  // a is boundary if either a or b were boundary; b is isolated
+  if(_isBoundaryVertex[iVb]) _isBoundaryVertex[iVa] = true;
+  _isBoundaryVertex[iVb] = false;
+  _nPartsVertex[iVb]     = 0;
+
+  return iVa;
+}
+
+bool TriangleMesh::isDeletedFace(const Index iF) const {
+  return (0<=iF && iF<getNumberOfFaces() && _triangles[3*iF]<0);
+}
+
+void TriangleMesh::compact() {
+  Index nF = getNumberOfFaces();
+  Index iF,jF;
+  for(iF=jF=0;iF<nF;iF++) {
+    if(isDeletedFace(iF)) continue;
+    if(jF<iF)
+      for(Index k=0;k<3;k++)
+        _triangles[3*jF+k] = _triangles[3*iF+k];
+    jF++;
+  }
+  _triangles.resize(3*jF);
+  _reset(getNumberOfVertices());
+  _build();
+}
@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// TriangleMesh.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#ifndef _TRIANGLE_MESH_HPP_
+#define _TRIANGLE_MESH_HPP_
+
+#include <vector>
+#include "Edges.hpp"
+
+using namespace std;
+
+class TriangleMesh : public Edges {
+
+  // - same public interface as the PolygonMesh class, specialized for
+  //   meshes where all the faces are triangles
+  // - the corners are stored in a compact array of 3*nF vertex
+  //   indices, without face separators; the corners of face iF are
+  //   3*iF, 3*iF+1, and 3*iF+2
+  // - face, next, and prev are computed from the corner index with
+  //   integer arithmetic, rather than by looking for face separators
+  // - since all the faces have the same size, faces can be modified
+  //   in place, and the mesh supports local editing operations whose
+  //   cost is proportional to the size of the neighborhood of the
+  //   edited elements, rather than to the size of the mesh
+
+public:
+
+  // inherits from Edges
+  //
+  // Index   getNumberOfVertices()                     const;
+  // Index   getNumberOfEdges()                        const;
+  // Index   getEdge(const Index iV0, const Index iV1) const;
+  // Index   getVertex0(const Index iE)                const;
+  // Index   getVertex1(const Index iE)                const;
+
+  // returns true if all the faces of the coordIndex array are
+  // triangles, and the array ends with a face separator
+  static bool isTriangleMesh(const vector<int>& coordIndex);
+
+  // the coordIndex array has the same format as in the PolygonMesh
+  // constructor; faces which are not triangles are ignored, so that
+  // face indices only agree with those of the PolygonMesh if
+  // isTriangleMesh(coordIndex) is true
+
+             TriangleMesh(const Index nV, const vector<int>& coordIndex);
+
+  // returns the compact array of 3*nF vertex indices
+
+     const vector<Index>& getTriangles()               const;
+
+     Index   getNumberOfFaces()                        const;
+
+  // returns 3*getNumberOfFaces()
+
+     Index   getNumberOfCorners()                      const;
+
+  // half edge methods; same semantics as in the HalfEdges class, but
+  // note that corner indices are indices into the getTriangles()
+  // array, rather than into the coordIndex array; if the corner index
+  // iC is out of range these methods return -1
+
+     Index   getFace(const Index iC)                   const;
+     Index   getSrc(const Index iC)                    const;
+     Index   getDst(const Index iC)                    const;
+     Index   getNext(const Index iC)                   const;
+     Index   getPrev(const Index iC)                   const;
+     Index   getTwin(const Index iC)                   const;
+
+  // same as getFace(), getNext(), getPrev() and getTwin(), but without
+  // the range check, and inline, for the loops which visit every
+  // corner; iC has to be in the range 0<=iC<getNumberOfCorners()
+
+     Index   faceUnchecked(const Index iC)  const { return iC/3; }
+     Index   nextUnchecked(const Index iC)  const { return (iC%3==2)?iC-2:iC+1; }
+     Index   prevUnchecked(const Index iC)  const { return (iC%3==0)?iC+2:iC-1; }
+     Index   twinUnchecked(const Index iC)  const { return _twin[iC]; }
+
+     Index   getNumberOfEdgeHalfEdges(const Index iE)  const;
+     Index   getEdgeHalfEdge(const Index iE, const Index j) const;
+
+  // same as in the PolygonMesh class
+
+     Index   getNumberOfEdgeFaces(const Index iE)      const;
+     Index   getEdgeFace(const Index iE, const Index j) const;
+     bool    isEdgeFace(const Index iE, const Index iF) const;
+
+     bool    isBoundaryEdge(const Index iE)            const;
+     bool    isRegularEdge(const Index iE)             const;
+     bool    isSingularEdge(const Index iE)            const;
+
+     bool    isBoundaryVertex(const Index iV)          const;
+     bool    isInternalVertex(const Index iV)          const;
+     bool    isSingularVertex(const Index iV)          const;
+
+     bool    isRegular()                               const;
+     bool    hasBoundary()                             const;
+
+  // returns the number of bytes allocated by the internal arrays,
+  // including those inherited from Edges
+
+     size_t  getMemoryUsage()                          const;
+
+  // local editing operations
+  //
+  // - these operations are only applied to manifold neighborhoods;
+  //   if the preconditions are not satisfied, the mesh is not
+  //   modified and the methods return -1
+  // - new vertices get the index getNumberOfVertices() at the time of
+  //   the call; the caller is responsible for appending the
+  //   corresponding coordinates
+  // - new faces and new edges are appended; faces removed by
+  //   collapseEdge() are marked as deleted, with their three vertex
+  //   indices set to -1, and removed edges are left without incident
+  //   half edges, with getVertex0(iE)==getVertex1(iE)==-1, until
+  //   compact() is called
+  // - twins, edge to half edge incidence lists, and vertex
+  //   classification are updated incrementally
+
+  // replaces the two triangles (a,b,c) and (b,a,d) incident to the
+  // regular edge iE=(a,b) by the triangles (a,d,c) and (d,b,c); the
+  // edge index iE is assigned to the new edge (c,d), which is
+  // returned; the two faces must be consistently oriented, the
+  // vertices a, b, c, and d must be regular, and the edge (c,d) must
+  // not exist
+
+     Index   flipEdge(const Index iE);
+
+  // inserts a new vertex m on the edge iE=(a,b), splits each
+  // triangle (a,b,c) incident to the edge into (a,m,c) and (m,b,c),
+  // and returns m; the edge index iE is assigned to the edge (a,m);
+  // the opposite vertices c must all be different
+
+     Index   splitEdge(const Index iE);
+
+  // inserts a new vertex m in the triangle iF=(a,b,c), replaces it
+  // by (a,b,m), (b,c,m), and (c,a,m), and returns m
+
+     Index   splitFace(const Index iF);
+
+  // collapses the edge iE=(a,b) onto the vertex a=getVertex0(iE):
+  // removes the triangles incident to the edge, replaces b by a in
+  // all the other triangles, and returns a; the edge must be
+  // boundary or regular, a and b must be regular, and the collapse
+  // must satisfy the link condition (the only common neighbors of a
+  // and b are the opposite vertices of the triangles incident to the
+  // edge); an internal edge with two boundary vertices, or a triangle
+  // whose other two edges are both boundary, cannot be collapsed;
+  // b is left as an isolated vertex
+
+     Index   collapseEdge(const Index iE);
+
+  // returns true if the face iF has been removed by collapseEdge()
+
+     bool    isDeletedFace(const Index iF)             const;
+
+  // removes the deleted faces and the removed edges, renumbering the
+  // remaining faces, corners, and edges; vertex indices are not
+  // changed; this method takes time proportional to the mesh size
+
+     void    compact();
+
+private:
+
+  // builds the data structures from the _triangles array
+  void     _build();
+
+  // fills the corners array with the corners of the vertex of corner
+  // iC which can be reached from iC across twin half edges, ordered
+  // around the vertex; returns true if the fan is closed
+  bool     _vertexFan(const Index iC, vector<Index>& corners) const;
+
+  // returns the corner of the vertex of corner iC in the face across
+  // the half edge iH, which contains the vertex, or -1 if iH has no
+  // twin; sets out to true if the walk around the vertex should
+  // continue across the outgoing half edge of the returned corner
+  Index    _crossHalfEdge(const Index iV, const Index iH, bool& out) const;
+
+  // appends an empty incidence list of the given capacity, for the
+  // edge iE just inserted
+  void     _appendEdgeList(const Index iE, const Index capacity);
+
+  // appends the corner iC to the incidence list of the edge iE
+  void     _addEdgeCorner(const Index iE, const Index iC);
+
+  // replaces the corner iC by the corner jC in the incidence list of
+  // the edge iE; if jC<0 the corner is removed from the list
+  void     _replaceEdgeCorner(const Index iE, const Index iC, const Index jC);
+
+  // makes iC0 and iC1 twins; either one can be -1
+  void     _setTwins(const Index iC0, const Index iC1);
+
+  // returns the index of the edge of the half edge iC
+  Index    _getCornerEdge(const Index iC)             const;
+
+  // 3 vertex indices per face
+  vector<Index>  _triangles;
+
+  // array of twin corners
+  vector<Index>  _twin;
+
+  // the half-edge to edge incidence relations is represented as an
+  // arrray of arrays; the list of the edge iE is stored at the
+  // locations _firstCornerEdge[iE]<=j<_firstCornerEdge[iE]+_nCornersEdge[iE]
+  // of the _cornerEdge array, and it can grow up to
+  // _firstCornerEdge[iE+1]; the lists only shrink during edits
+  vector<Index>  _firstCornerEdge;
+  vector<Index>  _nCornersEdge;
+  vector<Index>  _cornerEdge;
+
+  vector<Index>  _nPartsVertex;
+  vector<bool> _isBoundaryVertex;
+
+};
+
+#endif /* _TRIANGLE_MESH_HPP_ */
@@ -46,7 +46,8 @@ GuiGLBuffer::GuiGLBuffer():
   _hasFaces(false),
   _hasPolylines(false),
   _hasColor(false),
-  _hasNormal(false) {
+  _hasNormal(false),
+  _generation(0) {
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -58,7 +59,8 @@ GuiGLBuffer::GuiGLBuffer(IndexedFaceSet* pIfs, QColor& materialColor):
   _hasFaces(false),
   _hasPolylines(false),
   _hasColor(false),
-  _hasNormal(false) {
+  _hasNormal(false),
+  _generation(0) {
 
   // std::cout << "GuiGLBuffer::GuiGLBuffer(IndexedFaceSet) {\n";
 
@@ -68,21 +70,26 @@ GuiGLBuffer::GuiGLBuffer(IndexedFaceSet* pIfs, QColor& materialColor):
 
   if(pIfs==(IndexedFaceSet*)0) return;
 
-  vector<float>& coord       = pIfs->getCoord();
-  vector<int>&   coordIndex  = pIfs->getCoordIndex();
+  // the arrays are only read, so that their generations do not change
+  const IndexedFaceSet& ifs = *pIfs;
+  _generation = ifs.getGeneration(IndexedFaceSet::ALL_ARRAYS_MASK);
 
-  bool           colorPerVertex = pIfs->getColorPerVertex();
-  vector<float>& color       = pIfs->getColor();
-  vector<int>&   colorIndex  = pIfs->getColorIndex();
+  const vector<float>& coord       = ifs.getCoord();
+  const vector<int>&   coordIndex  = ifs.getCoordIndex();
+  const vector<Index>& faceOffsets = ifs.getFaceOffsets();
+
+  bool                 colorPerVertex = ifs.getColorPerVertex();
+  const vector<float>& color       = ifs.getColor();
+  const vector<int>&   colorIndex  = ifs.getColorIndex();
   // IndexedFaceSet::Binding   cBinding    = pIfs->getColorBinding();
 
-  bool           normalPerVertex = pIfs->getNormalPerVertex();
-  vector<float>& normal      = pIfs->getNormal();
-  vector<int>&   normalIndex = pIfs->getNormalIndex();
+  bool                 normalPerVertex = ifs.getNormalPerVertex();
+  const vector<float>& normal      = ifs.getNormal();
+  const vector<int>&   normalIndex = ifs.getNormalIndex();
   // IndexedFaceSet::Binding   nBinding    = pIfs->getNormalBinding();
 
   // int         nV          = pIfs->getNumberOfCoord();
-  int            nF          = pIfs->getNumberOfFaces();
+  int            nF          = static_cast<int>(faceOffsets.size())-1;
 
   // material color values in [0.0:1.0] range
   float /*qreal*/ matR,matG,matB,matA;
@@ -110,62 +117,59 @@ GuiGLBuffer::GuiGLBuffer(IndexedFaceSet* pIfs, QColor& materialColor):
     int   j[3];
 
     int iN,iC,iV,k,h,i0,i1,iF;
-    for(iF=i0=i1=0;i1<(int)coordIndex.size();i1++) {
-      if(coordIndex[i1]<0) {
-        // number of triangles in this face
-        // nTrianglesFace = i1-i0-2;
+    for(iF=0;iF<nF;iF++) {
+      i0 = faceOffsets[iF];
+      i1 = faceOffsets[iF+1]-1;
+      // number of triangles in this face
+      // nTrianglesFace = i1-i0-2;
+
+      if(_hasNormal && normalPerVertex==false) {
+        // NORMAL_PER_FACE_INDEXED or NORMAL_PER_FACE
+        iN = (normalIndex.size()>0)?normalIndex[iF]:iF;
+        for(h=0;h<3;h++)
+          n[0][h] = n[1][h] = n[2][h] = normal[3*iN+h];
+      }
 
-        if(_hasNormal && normalPerVertex==false) {
-          // NORMAL_PER_FACE_INDEXED or NORMAL_PER_FACE
-          iN = (normalIndex.size()>0)?normalIndex[iF]:iF;
-          for(h=0;h<3;h++)
-            n[0][h] = n[1][h] = n[2][h] = normal[3*iN+h];
-        }
+      if(_hasColor && colorPerVertex==false) {
+        // COLOR_PER_FACE_INDEXED or COLOR_PER_FACE
+        iC = (colorIndex.size()>0)?colorIndex[iF]:iF;
+        for(h=0;h<3;h++)
+          c[0][h] = c[1][h] = c[2][h] = color[3*iC+h];
+      }
 
-        if(_hasColor && colorPerVertex==false) {
-          // COLOR_PER_FACE_INDEXED or COLOR_PER_FACE
-          iC = (colorIndex.size()>0)?colorIndex[iF]:iF;
+      // triangulate face [i0:i1) on the fly and add triangles to current mesh
+      for(j[0]=i0,j[1]=i0+1,j[2]=i0+2;j[2]<i1;j[1]=j[2]++) {
+        // triangle [j0,j1,j2]
+        for(k=0;k<3;k++) {
+          // get vertex coordinates
+          iV = coordIndex[j[k]];
           for(h=0;h<3;h++)
-            c[0][h] = c[1][h] = c[2][h] = color[3*iC+h];
-        }
+            x[k][h] = coord[3*iV+h];
 
-        // triangulate face [i0:i1) on the fly and add triangles to current mesh
-        for(j[0]=i0,j[1]=i0+1,j[2]=i0+2;j[2]<i1;j[1]=j[2]++) {
-          // triangle [j0,j1,j2]
-          for(k=0;k<3;k++) {
-            // get vertex coordinates
-            iV = coordIndex[j[k]];
+          if(_hasNormal && normalPerVertex==true) {
+            // NORMAL_PER_CORNER or NORNAL_PER_VERTEX
+            iN = (normalIndex.size()>0)?normalIndex[j[k]]:iV;
             for(h=0;h<3;h++)
-              x[k][h] = coord[3*iV+h];
-
-            if(_hasNormal && normalPerVertex==true) {
-              // NORMAL_PER_CORNER or NORNAL_PER_VERTEX
-              iN = (normalIndex.size()>0)?normalIndex[j[k]]:iV;
-              for(h=0;h<3;h++)
-                n[k][h] = normal[3*iN+h];
-            }
-
-            if(_hasColor && colorPerVertex==true) {
-              // COLOR_PER_CORNER or COLOR_PER_VERTEX
-              iC = (colorIndex.size()>0)?colorIndex[j[k]]:iV;
-              for(h=0;h<3;h++)
-                c[k][h] = color[3*iC+h];
-            }
-
+              n[k][h] = normal[3*iN+h];
           }
 
-          // push values into buffers
-          for(k=2;k>=0;k--) {
-            m_vertices.append(QVector3D(x[k][0],x[k][1],x[k][2]));
-            if(_hasNormal)
-              m_normals.append(QVector3D(n[k][0],n[k][1],n[k][2]));
-            if(_hasColor)
-              m_colors.append(QVector3D(c[k][0],c[k][1],c[k][2]));
+          if(_hasColor && colorPerVertex==true) {
+            // COLOR_PER_CORNER or COLOR_PER_VERTEX
+            iC = (colorIndex.size()>0)?colorIndex[j[k]]:iV;
+            for(h=0;h<3;h++)
+              c[k][h] = color[3*iC+h];
           }
+
         }
 
-        // advance to next face
-        i0 = i1+1; iF++;
+        // push values into buffers
+        for(k=2;k>=0;k--) {
+          m_vertices.append(QVector3D(x[k][0],x[k][1],x[k][2]));
+          if(_hasNormal)
+            m_normals.append(QVector3D(n[k][0],n[k][1],n[k][2]));
+          if(_hasColor)
+            m_colors.append(QVector3D(c[k][0],c[k][1],c[k][2]));
+        }
       }
     }
 
@@ -257,7 +261,8 @@ GuiGLBuffer::GuiGLBuffer(IndexedLineSet* pIls, QColor& materialColor):
   _hasFaces(false),
   _hasPolylines(false),
   _hasColor(false),
-  _hasNormal(false) {
+  _hasNormal(false),
+  _generation(0) {
 
   // std::cout << "GuiGLBuffer::GuiGLBuffer(IndexedLineSet) {\n";
 
@@ -267,13 +272,13 @@ GuiGLBuffer::GuiGLBuffer(IndexedLineSet* pIls, QColor& materialColor):
 
   if(pIls==(IndexedLineSet*)0) return;
 
-  vector<float>& coord          = pIls->getCoord();
-  vector<int>&   coordIndex     = pIls->getCoordIndex();
-  vector<float>& color          = pIls->getColor();
-  vector<int>&   colorIndex     = pIls->getColorIndex();
-  bool           colorPerVertex = pIls->getColorPerVertex();
-  // int         nV             = pIls->getNumberOfCoord();
-  int            nP             = pIls->getNumberOfPolylines();
+  const vector<float>& coord          = pIls->getCoord();
+  const vector<int>&   coordIndex     = pIls->getCoordIndex();
+  const vector<float>& color          = pIls->getColor();
+  const vector<int>&   colorIndex     = pIls->getColorIndex();
+  bool                 colorPerVertex = pIls->getColorPerVertex();
+  // int               nV             = pIls->getNumberOfCoord();
+  int                  nP             = pIls->getNumberOfPolylines();
 
   // material color values in [0.0:1.0] range
   float /*qreal*/ matR,matG,matB,matA;
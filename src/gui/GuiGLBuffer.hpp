@@ -65,6 +65,10 @@ public:
   bool     hasColor()            const { return                   _hasColor; }
   bool     hasNormal()           const { return                  _hasNormal; }
 
+  // generation of the IndexedFaceSet arrays the buffer was built from,
+  // or 0 for other geometry nodes
+  uint64_t getGeneration()       const { return                 _generation; }
+
 protected:
 
   Type     _type;
@@ -75,6 +79,7 @@ protected:
   bool     _hasPolylines;
   bool     _hasColor;
   bool     _hasNormal;
+  uint64_t _generation;
 
 };
 
@@ -64,6 +64,7 @@ public:
 
   int            getNumberOfVertices();
   GuiGLBuffer*   getVertexBuffer() const;
+  const QColor&  getMaterialColor() const { return _materialColor; }
   QMatrix4x4&    getMVPMatrix();
 
   void           setPointSize(float pointSize);
@@ -140,17 +140,11 @@ void GuiGLWidget::setSceneGraph(SceneGraph* pWrl, bool resetHomeView) {
 
   // pWrl->printInfo("  ");
 
-  // cout << "  _shaderMap.size() = "<< _shaderMap.size() <<"\n";
-  // cout << "  deleting old shaders ... \n";
-  map<Shape*,GuiGLShader*>::iterator i;
-  for(i=_shaderMap.begin();i!=_shaderMap.end();i++) {
-    Shape* shape = i->first;
-    cout << "    found Shape \"" << shape->getName() << "\"\n";
-    GuiGLShader* shader = i->second;
-    i->second = (GuiGLShader*)0;
-    delete shader;
-  }
-  _shaderMap.clear();
+  // the shaders of the IndexedFaceSet nodes which have not changed
+  // since their buffers were built are reused; the old Shape pointers
+  // are only used as keys, since the nodes may have been deleted
+  map<Shape*,GuiGLShader*> oldShaderMap;
+  oldShaderMap.swap(_shaderMap);
 
   // cout << "  _shaderMap.size() = "<< _shaderMap.size() <<"\n";
 
@@ -210,6 +204,17 @@ void GuiGLWidget::setSceneGraph(SceneGraph* pWrl, bool resetHomeView) {
           //      << materialColor.green() << " , "
           //      << materialColor.blue() <<" )\n";
 
+          map<Shape*,GuiGLShader*>::iterator i = oldShaderMap.find(shape);
+          if(i!=oldShaderMap.end() &&
+             i->second->getMaterialColor()==materialColor &&
+             i->second->getVertexBuffer()!=(GuiGLBuffer*)0 &&
+             i->second->getVertexBuffer()->getGeneration()==
+             pIfs->getGeneration(IndexedFaceSet::ALL_ARRAYS_MASK)) {
+            _shaderMap[shape] = i->second;
+            oldShaderMap.erase(i);
+            continue;
+          }
+
           GuiGLBuffer* ifsb   = new GuiGLBuffer(pIfs, materialColor);
           GuiGLShader* shader = new GuiGLShader(materialColor,&_lightSource);
           shader->setVertexBuffer(ifsb);
@@ -266,6 +271,14 @@ void GuiGLWidget::setSceneGraph(SceneGraph* pWrl, bool resetHomeView) {
 
   }
 
+  // delete the shaders which were not reused
+  map<Shape*,GuiGLShader*>::iterator i;
+  for(i=oldShaderMap.begin();i!=oldShaderMap.end();i++) {
+    GuiGLShader* shader = i->second;
+    i->second = (GuiGLShader*)0;
+    delete shader;
+  }
+
   cout << "}\n";
 }
 
@@ -288,7 +301,7 @@ void GuiGLWidget::invertNormal() {
     Node* geometry = shape->getGeometry();
     if(IndexedFaceSet* ifs=dynamic_cast<IndexedFaceSet*>(geometry)) {
 
-      vector<float> &normal = ifs->getNormal();    
+      vector<float> &normal = ifs->editNormal();    
       float n0,n1,n2;
       for(unsigned i=0;i<normal.size();i+=3) {
         n0 = normal[i+0]; n1 = normal[i+1]; n2 = normal[i+2];
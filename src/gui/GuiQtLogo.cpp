@@ -101,7 +101,7 @@ GuiQtLogo::GuiQtLogo():
     newExtrude(x8, y8, x5, y5);
   }
 
-  vector<float>& coord = _pIfs->getCoord();
+  vector<float>& coord = _pIfs->editCoord();
   for (unsigned i = 0;i < coord.size();i++)
     coord[i] *= 2.0f;
 
@@ -109,21 +109,21 @@ GuiQtLogo::GuiQtLogo():
 }
 
 int GuiQtLogo::newVertex(float x, float y, float z) {
-  vector<float>& coord  = _pIfs->getCoord();
+  vector<float>& coord  = _pIfs->editCoord();
   int iV = static_cast<int>(coord.size()/3);
   coord.push_back(x); coord.push_back(y); coord.push_back(z);
   return iV;
 }
 
 int GuiQtLogo::newNormal(float nx, float ny, float nz) {
-  vector<float>& normal = _pIfs->getNormal();
+  vector<float>& normal = _pIfs->editNormal();
   int iN = static_cast<int>(normal.size()/3);
   normal.push_back(nx); normal.push_back(ny); normal.push_back(nz);
   return iN;
 }
 
 void GuiQtLogo::newTriangle(int i0, int i1, int i2) {
-  vector<int>& coordIndex = _pIfs->getCoordIndex();
+  vector<int>& coordIndex = _pIfs->editCoordIndex();
   coordIndex.push_back(i0);
   coordIndex.push_back(i1);
   coordIndex.push_back(i2);
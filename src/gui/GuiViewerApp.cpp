@@ -33,6 +33,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // #include <iostream>
+#include <clocale>
 #include <QApplication>
 #include <QMainWindow>
 #include <QSurfaceFormat>
@@ -44,6 +45,11 @@ int main( int argc, char ** argv ) {
 
   QApplication app( argc, argv );
 
+  // QApplication sets the locale from the environment; the loaders
+  // are locale independent, but the savers write numbers with
+  // printf(), which must use '.' as the decimal point
+  setlocale(LC_NUMERIC, "C");
+
   QSurfaceFormat format;
   format.setDepthBufferSize(24);
   format.setStencilBufferSize(8);
@@ -162,16 +162,20 @@ void LoaderPly::addBinaryValue
 //////////////////////////////////////////////////////////////////////
 // static
 void LoaderPly::addAsciiValue
-(const string& token,
+(const string_view& token,
  const Ply::Element::Property::Type propertyType,
  void* value) {
 
+  // as with atoi() and atof(), the value is 0 if token is not a number
+
   switch(propertyType) {
   case Ply::Element::Property::CHAR:
   case Ply::Element::Property::INT8:
     {
       vector<char>* valueChar= static_cast<vector<char>*>(value);
-      char v = static_cast<char>(atoi(token.c_str()));
+      int i = 0;
+      Tokenizer::parseInt(token,i);
+      char v = static_cast<char>(i);
       valueChar->push_back(v);
     }
     break;
@@ -179,7 +183,9 @@ void LoaderPly::addAsciiValue
   case Ply::Element::Property::UINT8:
     {
       vector<uchar>* valueUChar= static_cast<vector<uchar>*>(value);
-      uchar v = static_cast<uchar>(atoi(token.c_str()));
+      int i = 0;
+      Tokenizer::parseInt(token,i);
+      uchar v = static_cast<uchar>(i);
       valueUChar->push_back(v);
     }
     break;
@@ -187,7 +193,9 @@ void LoaderPly::addAsciiValue
   case Ply::Element::Property::INT16:
     {
       vector<short>* valueShort= static_cast<vector<short>*>(value);
-      short v = static_cast<short>(atoi(token.c_str()));
+      int i = 0;
+      Tokenizer::parseInt(token,i);
+      short v = static_cast<short>(i);
       valueShort->push_back(v);
     }
     break;
@@ -195,7 +203,9 @@ void LoaderPly::addAsciiValue
   case Ply::Element::Property::UINT16:
     {
       vector<ushort>* valueUShort= static_cast<vector<ushort>*>(value);
-      ushort v = static_cast<ushort>(atoi(token.c_str()));
+      int i = 0;
+      Tokenizer::parseInt(token,i);
+      ushort v = static_cast<ushort>(i);
       valueUShort->push_back(v);
     }
     break;
@@ -203,7 +213,8 @@ void LoaderPly::addAsciiValue
   case Ply::Element::Property::INT32:
     {
       vector<int>* valueInt= static_cast<vector<int>*>(value);
-      int v = static_cast<int>(atoi(token.c_str()));
+      int v = 0;
+      Tokenizer::parseInt(token,v);
       valueInt->push_back(v);
     }
     break;
@@ -211,7 +222,9 @@ void LoaderPly::addAsciiValue
   case Ply::Element::Property::UINT32:
     {
       vector<uint>* valueUInt= static_cast<vector<uint>*>(value);
-      uint v = static_cast<uint>(atol(token.c_str()));
+      unsigned int ui = 0;
+      Tokenizer::parseUInt(token,ui);
+      uint v = static_cast<uint>(ui);
       valueUInt->push_back(v);
     }
     break;
@@ -221,7 +234,9 @@ void LoaderPly::addAsciiValue
   case Ply::Element::Property::FLOAT32_3:
     {
       vector<float>* valueFloat = static_cast<vector<float>*>(value);
-      float v = static_cast<float>(atof(token.c_str()));
+      double d = 0.0;
+      Tokenizer::parseDouble(token,d);
+      float v = static_cast<float>(d);
       valueFloat->push_back(v);
     }
     break;
@@ -229,7 +244,8 @@ void LoaderPly::addAsciiValue
   case Ply::Element::Property::FLOAT64:
     {
       vector<double>* valueDouble = static_cast<vector<double>*>(value);
-      double v = static_cast<double>(atof(token.c_str()));
+      double v = 0.0;
+      Tokenizer::parseDouble(token,v);
       valueDouble->push_back(v);
     }
     break;
@@ -340,7 +356,8 @@ size_t LoaderPly::readHeader(FILE* fp, Ply& ply, const string indent) {
 
         if(ftkn.get()==false)      
           throw new StrException("expecting element nRecords");
-        int nRecords = atoi(ftkn.c_str());
+        int nRecords = 0;
+        Tokenizer::parseInt(ftkn,nRecords);
         if(nRecords<0)
           throw new StrException("expecting non-negative element nRecords");
     
@@ -417,6 +434,7 @@ size_t LoaderPly::readHeader(FILE* fp, Ply& ply, const string indent) {
 
       }
     }
+    ftkn.sync();
     nBytes = static_cast<size_t>(ftell(fp));
   }
 
@@ -678,7 +696,8 @@ size_t LoaderPly::readAsciiData(FILE* fp, Ply& ply, const string indent) {
     // Ply::Element::Property::Type listType = Ply::Element::Property::Type::NONE;
     Ply::Element::Property::Type propertyType = Ply::Element::Property::Type::NONE;
     void* value;
-    string line,name,propertyName,token;
+    string line,name,propertyName;
+    string_view token;
     int i,iElement,iProperty,iRecord,k0,k1,nList,nProperties,nRecords;
 
     bool wrlMode = ply.getWrlMode();
@@ -722,13 +741,13 @@ size_t LoaderPly::readAsciiData(FILE* fp, Ply& ply, const string indent) {
  
               nList = 0;
 
-              if(stkn.get()==false) {
+              if(stkn.getView(token)==false) {
                 char s[128];
                 snprintf(s,128,"end of line in property record %d",iRecord);
                 throw new StrException(string(s));
               }
 
-              nList = atoi(stkn.c_str());
+              Tokenizer::parseInt(token,nList);
 
               if(wrlMode==false || propertyName!="coordIndex")
                 property->pushBackList(nList);
@@ -736,12 +755,12 @@ size_t LoaderPly::readAsciiData(FILE* fp, Ply& ply, const string indent) {
               value = property->getValue();
   
                for(i=0;i<nList;i++) {
-                 if(stkn.get()==false) {
+                 if(stkn.getView(token)==false) {
                    char s[128];
                    snprintf(s,128,"end of line in property record %d",iRecord);
                    throw new StrException(string(s));
                  }
-                 addAsciiValue(stkn,propertyType,value);
+                 addAsciiValue(token,propertyType,value);
                }
 
                if(wrlMode && propertyName=="coordIndex")
@@ -756,12 +775,12 @@ size_t LoaderPly::readAsciiData(FILE* fp, Ply& ply, const string indent) {
                 (propertyType==Ply::Element::Property::Type::FLOAT32_2)?2:1;
 
               while(--n>=0) {
-                if(stkn.get()==false) {
+                if(stkn.getView(token)==false) {
                   char s[128];
                   snprintf(s,128,"end of line in property record %d",iRecord);
                   throw new StrException(string(s));
                 }
-                addAsciiValue(stkn,propertyType,value);
+                addAsciiValue(token,propertyType,value);
                 if(wrlMode && propertyName=="color") {
                     static_cast<vector<float>*>(value)->back() /= 255.0;
                 }
@@ -781,6 +800,7 @@ size_t LoaderPly::readAsciiData(FILE* fp, Ply& ply, const string indent) {
       } // for(iRecord=0;iRecord<nRecords;iRecord++)
     } // for(iElement=0;iElement<nElements;iElement++)
 
+    ftkn.sync();
     long fp1 = ftell(fp);
     nBytes = static_cast<size_t>(fp1-fp0);
   }
@@ -42,6 +42,7 @@
 #ifndef _LOADER_PLY_HPP_
 #define _LOADER_PLY_HPP_
 
+#include <string_view>
 #include "Loader.hpp"
 #include <util/Endian.hpp>
 #include <wrl/Ply.hpp>
@@ -75,7 +76,7 @@ private:
    void* value);
   
   static void addAsciiValue
-  (const string& token,
+  (const string_view& token,
    const Ply::Element::Property::Type propertyType,
    void* value);
   
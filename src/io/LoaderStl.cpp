@@ -43,6 +43,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <climits>
 #include "TokenizerFile.hpp"
 #include "LoaderStl.hpp"
 #include "StrException.hpp"
@@ -51,12 +52,31 @@
 #include "wrl/Appearance.hpp"
 #include "wrl/Material.hpp"
 #include "wrl/IndexedFaceSet.hpp"
+#include "wrl/SceneGraphProcessor.hpp"
+#include "util/MappedFile.hpp"
+#include "util/Parallel.hpp"
 
 // reference
 // https://en.wikipedia.org/wiki/STL_(file_format)
 
 const char* LoaderStl::_ext = "stl";
 
+void LoaderStl::setWeldVertices(const bool value) {
+  _weldVertices = value;
+}
+
+bool LoaderStl::getWeldVertices() const {
+  return _weldVertices;
+}
+
+void LoaderStl::setWeldEpsilon(const float epsilon) {
+  _weldEpsilon = (epsilon>0.0f)?epsilon:0.0f;
+}
+
+float LoaderStl::getWeldEpsilon() const {
+  return _weldEpsilon;
+}
+
 IndexedFaceSet* LoaderStl::_initializeSceneGraph
 (const char* filename, SceneGraph& wrl) {
   // 0) clear the container
@@ -119,90 +139,81 @@ bool LoaderStl::_loadFacetAscii
   return true;
 }
 
-bool LoaderStl::_loadFacetBinary
-(FILE* fp, Vec3f& n, Vec3f& v1, Vec3f& v2, Vec3f& v3, uint16_t* abc) {
+// binary STL layout : an 80 byte header, a 4 byte number of
+// triangles, and one 50 byte record per triangle, made of the normal
+// and the three vertices as 12 floats, and a 2 byte attribute
+bool LoaderStl::_isBinarySize(const size_t fileSize, const char* data) {
+  if(fileSize<84) return false;
+  uint32_t nTriangles;
+  memcpy(&nTriangles,data+80,4);
+  return (fileSize==84+50*static_cast<size_t>(nTriangles));
+}
 
-  if(fread(&(n[0]),1,12,fp)<12)
-    throw new StrException("unable to read normal vector");
-  if(fread(&(v1[0]),1,12,fp)<12)
-    throw new StrException("unable to read vertex 0");
-  if(fread(&(v2[0]),1,12,fp)<12)
-    throw new StrException("unable to read vertex 1");
-  if(fread(&(v3[0]),1,12,fp)<12)
-    throw new StrException("unable to read vertex 2");
-  if(fread(abc,1,2,fp)<2)
-    throw new StrException("unable to read atribute byte count");
+void LoaderStl::_loadBinary(const MappedFile& file, IndexedFaceSet& ifs) {
+  const char* data     = file.getData();
+  size_t      fileSize = file.getSize();
+  if(fileSize<84)
+    throw new StrException("unable to read number of triangles");
+  uint32_t nTriangles = 0;
+  memcpy(&nTriangles,data+80,4);
+  if(static_cast<size_t>(nTriangles)>(fileSize-84)/50)
+    throw new StrException("file too short for the number of triangles");
+  if(nTriangles>static_cast<uint32_t>(INT_MAX/4))
+    throw new StrException("too many triangles");
 
-  return true;
+  // every array is allocated once, and the records are decoded in
+  // parallel straight from the mapped file; vertex iV of triangle iT
+  // is 3*iT+iV, and triangles are separated by -1
+  int nT = static_cast<int>(nTriangles);
+  vector<int>&   coordIndex = ifs.editCoordIndex();
+  vector<float>& coord      = ifs.editCoord();
+  vector<float>& normal     = ifs.editNormal();
+  coordIndex.resize(4*static_cast<size_t>(nT));
+  coord.resize(9*static_cast<size_t>(nT));
+  normal.resize(3*static_cast<size_t>(nT));
+  // set the normalPerVertex variable to false (i.e., normals per face)
+  ifs.setNormalPerVertex(false);
+
+  const char* records = data+84;
+  Parallel::forRanges(nT,[&](Index /*iR*/, Index iT0, Index iT1) {
+    for(size_t iT=static_cast<size_t>(iT0);iT<static_cast<size_t>(iT1);iT++) {
+      const char* record = records+50*iT;
+      memcpy(&normal[3*iT],record   ,12);
+      memcpy(&coord [9*iT],record+12,36);
+      int iV = static_cast<int>(3*iT);
+      coordIndex[4*iT  ] = iV;
+      coordIndex[4*iT+1] = iV+1;
+      coordIndex[4*iT+2] = iV+2;
+      coordIndex[4*iT+3] = -1;
+    }
+  });
 }
 
 bool LoaderStl::load(const char* filename, SceneGraph& wrl) {
   bool success = false;
 
   FILE* fp = (FILE*)0;
+  IndexedFaceSet* ifs = (IndexedFaceSet*)0;
   try {
     // open the file
     if(filename==(char*)0) throw new StrException("filename==null");
 
-    // allocate binary header and initialize to zero
-    char header[80];
-    memset(header,0x00,80);
-    // determine if file is ascii or binary
-    fp = fopen(filename,"rb");
-    if(fp==(FILE*)0)
+    // binary files are mapped into memory, and decoded in place
+    MappedFile file(filename);
+    if(file.isMapped()==false)
       throw new StrException("unable to open file for binary read");
-    if(fread(header,1,5,fp)<5)
+    if(file.getSize()<5)
       throw new StrException("unable to read first characters of file");
-    bool binary = (strncmp(header,"solid",5)!=0);
+    // some binary files also start with "solid"; their size matches
+    // the number of triangles in the header
+    bool binary =
+      (strncmp(file.getData(),"solid",5)!=0) ||
+      _isBinarySize(file.getSize(),file.getData());
     if(binary) {
-      // read the rest of the header
-      if(fread(header+5,1,75,fp)<75)
-        throw new StrException("unable to read 75 next characters of file");
-      // read number of triangles
-      uint32_t nTriangles = 0;
-      if(fread(&nTriangles,1,4,fp)<4)
-        throw new StrException("unable to read number of triangles");
-
-      IndexedFaceSet* ifs = _initializeSceneGraph(filename,wrl);
-      // get references to the coordIndex, coord, and normal arrays
-      vector<int>& coordIndex = ifs->getCoordIndex();
-      vector<float>& coord    = ifs->getCoord();
-      vector<float>& normal   = ifs->getNormal();
-      // 6) set the normalPerVertex variable to false (i.e., normals per face)  
-      ifs->setNormalPerVertex(false);
-
-      int   iV0,iV1,iV2,iT;
-      Vec3f n,v1,v2,v3;
-      uint16_t abc; // attribute byte count
-        for(iT=0;iT<nTriangles;iT++) {
-        _loadFacetBinary(fp,n,v1,v2,v3,&abc);
-        normal.push_back(n[0]);
-        normal.push_back(n[1]);
-        normal.push_back(n[2]);
-        iV0 = static_cast<int>(coord.size()/3);
-        coord.push_back(v1[0]);
-        coord.push_back(v1[1]);
-        coord.push_back(v1[2]);
-        iV1 = static_cast<int>(coord.size()/3);
-        coord.push_back(v2[0]);
-        coord.push_back(v2[1]);
-        coord.push_back(v2[2]);
-        iV2 = static_cast<int>(coord.size()/3);
-        coord.push_back(v3[0]);
-        coord.push_back(v3[1]);
-        coord.push_back(v3[2]);
-        coordIndex.push_back(iV0);
-        coordIndex.push_back(iV1);
-        coordIndex.push_back(iV2);
-        coordIndex.push_back(-1);
-      }
-      
+      ifs = _initializeSceneGraph(filename,wrl);
+      _loadBinary(file,*ifs);
       success = true;
-
-      fclose(fp);
     } else /* if(ascii) */ {
-      // close the binary file and reopen it
-      fclose(fp);
       fp = fopen(filename,"r");
       if(fp==(FILE*)0)
         throw new StrException("unable to open ASCII STL file");
@@ -218,11 +229,11 @@ bool LoaderStl::load(const char* filename, SceneGraph& wrl) {
       string stlName = tkn; // second token should be the solid name
 
       // create the scene graph structure :
-      IndexedFaceSet* ifs = _initializeSceneGraph(filename,wrl);
+      ifs = _initializeSceneGraph(filename,wrl);
       // get references to the coordIndex, coord, and normal arrays
-      vector<int>& coordIndex = ifs->getCoordIndex();
-      vector<float>& coord    = ifs->getCoord();
-      vector<float>& normal   = ifs->getNormal();
+      vector<int>& coordIndex = ifs->editCoordIndex();
+      vector<float>& coord    = ifs->editCoord();
+      vector<float>& normal   = ifs->editNormal();
       // set the normalPerVertex variable to false (i.e., normals per face)  
       ifs->setNormalPerVertex(false);
 
@@ -255,6 +266,11 @@ bool LoaderStl::load(const char* filename, SceneGraph& wrl) {
       // close the file (this statement may not be reached)
       fclose(fp);
     }
+
+    // every triangle has its own three vertices in the file
+    if(_weldVertices)
+      SceneGraphProcessor::weldVertices(*ifs,_weldEpsilon);
+    ifs->seal();
  
   } catch(StrException* e) { 
 
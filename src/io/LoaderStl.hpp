@@ -43,20 +43,33 @@
 #include "wrl/Node.hpp"
 #include "wrl/IndexedFaceSet.hpp"
 
+class MappedFile;
+
 class LoaderStl : public Loader {
 
 private:
 
   const static char* _ext;
 
+  bool  _weldVertices; // default : false
+  float _weldEpsilon;  // default : 0.0f
+
 public:
 
-  LoaderStl()  {};
+  LoaderStl():_weldVertices(false),_weldEpsilon(0.0f) {};
   ~LoaderStl() {};
 
   bool  load(const char* filename, SceneGraph& wrl);
   const char* ext() const { return _ext; }
 
+  // if enabled, coincident vertices are merged after loading, so that
+  // the IndexedFaceSet is connected; see SceneGraphProcessor::weldVertices;
+  // the options only apply to the loads performed by this instance
+  void  setWeldVertices(const bool value);
+  bool  getWeldVertices() const;
+  void  setWeldEpsilon(const float epsilon);
+  float getWeldEpsilon() const;
+
 private:
 
   IndexedFaceSet* _initializeSceneGraph(const char* filename, SceneGraph& wrl);
@@ -64,8 +77,11 @@ private:
   bool _loadFacetAscii
   (TokenizerFile& tkn, Vec3f& n, Vec3f& v1, Vec3f& v2, Vec3f& v3);
 
-  bool _loadFacetBinary
-  (FILE* fp, Vec3f& n, Vec3f& v1, Vec3f& v2, Vec3f& v3, uint16_t* abc);
+  static bool _isBinarySize(const size_t fileSize, const char* data);
+
+  // throws a StrException if the file is too short for the number of
+  // triangles in its header
+  static void _loadBinary(const MappedFile& file, IndexedFaceSet& ifs);
 
 };
 
@@ -250,6 +250,7 @@ bool LoaderWrl::loadShape(TokenizerFile& tkn, Shape& shape) {
         name = "";
         shape.setGeometry(ifs);
         loadIndexedFaceSet(tkn,*ifs);
+        ifs->seal();
       } else if(tkn.equals("IndexedLineSet")) {
         IndexedLineSet* ils = new IndexedLineSet();
         ils->setName(name);
@@ -438,7 +439,7 @@ bool LoaderWrl::loadIndexedFaceSet(TokenizerFile& tkn, IndexedFaceSet& ifs) {
   while(success==false && tkn.get()) {
     if(tkn.equals("color")) {
       //   SFNode  
-      vector<float>& _color = ifs.getColor();
+      vector<float>& _color = ifs.editColor();
 
       // if DEF name found, skip and ignore ??
 
@@ -455,7 +456,7 @@ bool LoaderWrl::loadIndexedFaceSet(TokenizerFile& tkn, IndexedFaceSet& ifs) {
 
     } else if(tkn.equals("coord")) {
       //   SFNode  
-      vector<float>& _coord = ifs.getCoord();
+      vector<float>& _coord = ifs.editCoord();
 
       // if DEF name found, skip and ignore ??
 
@@ -472,7 +473,7 @@ bool LoaderWrl::loadIndexedFaceSet(TokenizerFile& tkn, IndexedFaceSet& ifs) {
 
     } else if(tkn.equals("normal")) {
       //   SFNode  
-      vector<float>& _normal = ifs.getNormal();
+      vector<float>& _normal = ifs.editNormal();
 
       // if DEF name found, skip and ignore ??
 
@@ -489,7 +490,7 @@ bool LoaderWrl::loadIndexedFaceSet(TokenizerFile& tkn, IndexedFaceSet& ifs) {
 
     } else if(tkn.equals("texCoord")) {
       //   SFNode  
-      vector<float>& _texCoord = ifs.getTexCoord();
+      vector<float>& _texCoord = ifs.editTexCoord();
 
       // if DEF name found, skip and ignore ??
 
@@ -511,12 +512,12 @@ bool LoaderWrl::loadIndexedFaceSet(TokenizerFile& tkn, IndexedFaceSet& ifs) {
         throw new StrException("loading IndexedFaceSet ccw field");  
     } else if(tkn.equals("colorIndex")) {
       //   MFInt32 
-      vector<int>& _colorIndex = ifs.getColorIndex();
+      vector<int>& _colorIndex = ifs.editColorIndex();
       if(loadVecInt(tkn,_colorIndex)==false)
         throw new StrException("loading IndexedFaceSet colorIndex field");
     } else if(tkn.equals("colorPerVertex")) {
       //   SFBool
-      bool& _colorPerVertex = ifs.getColorPerVertex();
+      bool& _colorPerVertex = ifs.editColorPerVertex();
         if(tkn.getBool(_colorPerVertex)==false)
         throw new StrException("loading IndexedFaceSet colorPerVertex field");
     } else if(tkn.equals("convex")) {
@@ -526,7 +527,7 @@ bool LoaderWrl::loadIndexedFaceSet(TokenizerFile& tkn, IndexedFaceSet& ifs) {
         throw new StrException("loading IndexedFaceSet convex field");
     } else if(tkn.equals("coordIndex")) {
       //   MFInt32 
-      vector<int>& _coordIndex = ifs.getCoordIndex();
+      vector<int>& _coordIndex = ifs.editCoordIndex();
       if(loadVecInt(tkn,_coordIndex)==false)
         throw new StrException("loading IndexedFaceSet coordIndex field");
     } else if(tkn.equals("creaseAngle")) {
@@ -536,12 +537,12 @@ bool LoaderWrl::loadIndexedFaceSet(TokenizerFile& tkn, IndexedFaceSet& ifs) {
         throw new StrException("loading IndexedFaceSet creaseAngle value");
     } else if(tkn.equals("normalIndex")) {
       //   MFInt32 
-      vector<int>& _normalIndex = ifs.getNormalIndex();
+      vector<int>& _normalIndex = ifs.editNormalIndex();
       if(loadVecInt(tkn,_normalIndex)==false)
         throw new StrException("loading IndexedFaceSet normalIndex field");
     } else if(tkn.equals("normalPerVertex")) {
       //   SFBool
-      bool& _normalPerVertex = ifs.getNormalPerVertex();
+      bool& _normalPerVertex = ifs.editNormalPerVertex();
       if(tkn.getBool(_normalPerVertex)==false)
         throw new StrException("loading IndexedFaceSet normalPerVertex field");
     } else if(tkn.equals("solid")) {
@@ -551,7 +552,7 @@ bool LoaderWrl::loadIndexedFaceSet(TokenizerFile& tkn, IndexedFaceSet& ifs) {
         throw new StrException("loading IndexedFaceSet solid field");
     } else if(tkn.equals("texCoordIndex")) {
       //   MFInt32 
-      vector<int>& _texCoordIndex = ifs.getTexCoordIndex();
+      vector<int>& _texCoordIndex = ifs.editTexCoordIndex();
       if(loadVecInt(tkn,_texCoordIndex)==false)
         throw new StrException("loading IndexedFaceSet texCoordIndex field");
     } else if(tkn.equals("}")) {
@@ -578,7 +579,7 @@ bool LoaderWrl::loadIndexedLineSet(TokenizerFile& tkn, IndexedLineSet& ifs) {
   while(success==false && tkn.get()) {
     if(tkn.equals("color")) {
       //   SFNode  
-      vector<float>& _color = ifs.getColor();
+      vector<float>& _color = ifs.editColor();
 
       // if DEF name found, skip and ignore ??
 
@@ -595,7 +596,7 @@ bool LoaderWrl::loadIndexedLineSet(TokenizerFile& tkn, IndexedLineSet& ifs) {
 
     } else if(tkn.equals("coord")) {
       //   SFNode  
-      vector<float>& _coord = ifs.getCoord();
+      vector<float>& _coord = ifs.editCoord();
 
       // if DEF name found, skip and ignore ??
 
@@ -612,17 +613,17 @@ bool LoaderWrl::loadIndexedLineSet(TokenizerFile& tkn, IndexedLineSet& ifs) {
 
     } else if(tkn.equals("colorIndex")) {
       //   MFInt32 
-      vector<int>& _colorIndex = ifs.getColorIndex();
+      vector<int>& _colorIndex = ifs.editColorIndex();
       if(loadVecInt(tkn,_colorIndex)==false)
         throw new StrException("loading IndexedLineSet colorIndex field");
     } else if(tkn.equals("colorPerVertex")) {
       //   SFBool
-      bool& _colorPerVertex = ifs.getColorPerVertex();
+      bool& _colorPerVertex = ifs.editColorPerVertex();
         if(tkn.getBool(_colorPerVertex)==false)
         throw new StrException("loading IndexedLineSet colorPerVertex field");
     } else if(tkn.equals("coordIndex")) {
       //   MFInt32 
-      vector<int>& _coordIndex = ifs.getCoordIndex();
+      vector<int>& _coordIndex = ifs.editCoordIndex();
       if(loadVecInt(tkn,_coordIndex)==false)
         throw new StrException("loading IndexedLineSet coordIndex field");
     } else if(tkn.equals("}")) {
@@ -634,37 +635,24 @@ bool LoaderWrl::loadIndexedLineSet(TokenizerFile& tkn, IndexedLineSet& ifs) {
   return success;
 }
 
+// the whole array is located first, and then parsed at once, in
+// parallel if it is large
 bool LoaderWrl::loadVecFloat(TokenizerFile&tkn,vector<float>& vec) {
-  bool success = false;
   if(tkn.expecting("[")==false) throw new StrException("expecting \"[\"");
-  float value;
-  while(success==false && tkn.get()) {
-    if(tkn.equals("]")) {
-      success = true; // done
-    } else if(sscanf(tkn.c_str(),"%f",&value)==1) {
-      vec.push_back(value);
-    } else {
-      throw new StrException("expecting int value");
-    }
-  }
-
-  return success;
+  string_view span;
+  if(tkn.getSpan(']',span)==false) return false;
+  if(Tokenizer::parseFloats(span,vec)==false)
+    throw new StrException("expecting float value");
+  return true;
 }
 
 bool LoaderWrl::loadVecInt(TokenizerFile&tkn,vector<int>& vec) {
-  bool success = false;
   if(tkn.expecting("[")==false) throw new StrException("expecting \"[\"");
-  int value;
-  while(success==false && tkn.get()) {
-    if(tkn.equals("]")) {
-      success = true; // done
-    } else if(sscanf(tkn.c_str(),"%d",&value)==1) {
-      vec.push_back(value);
-    } else {
-      throw new StrException("expecting int value");
-    }
-  }
-  return success;
+  string_view span;
+  if(tkn.getSpan(']',span)==false) return false;
+  if(Tokenizer::parseInts(span,vec)==false)
+    throw new StrException("expecting int value");
+  return true;
 }
 
 bool LoaderWrl::loadVecString(TokenizerFile&tkn,vector<string>& vec) {
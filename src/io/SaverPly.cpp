@@ -166,7 +166,7 @@ bool SaverPly::writeBinaryValue
 // static
 bool SaverPly::writeBinaryValue
 (FILE * fp, const Ply::Element::Property::Type propertyType,
- const bool swapBytes, void* value, int index) {
+ const bool swapBytes, const void* value, int index) {
   bool success = false;
   if(fp!=nullptr) {
     Endian::SingleValueBuffer svb;
@@ -174,21 +174,21 @@ bool SaverPly::writeBinaryValue
     case Ply::Element::Property::Type::CHAR:
     case Ply::Element::Property::Type::INT8:
       {
-        svb.c[0] = (*static_cast<vector<char>*>(value))[UL(index)];
+        svb.c[0] = (*static_cast<const vector<char>*>(value))[UL(index)];
         success = (fwrite(&(svb.c[0]),1,1,fp)==2);
       }
       break;
     case Ply::Element::Property::Type::UCHAR:
     case Ply::Element::Property::Type::UINT8:
       {
-        svb.uc[0] = (*static_cast<vector<uchar>*>(value))[UL(index)];
+        svb.uc[0] = (*static_cast<const vector<uchar>*>(value))[UL(index)];
         success = (fwrite(&(svb.uc[0]),1,1,fp)==2);
       }
       break;
     case Ply::Element::Property::Type::SHORT:
     case Ply::Element::Property::Type::INT16:
       {
-        svb.s[0] = (*static_cast<vector<short>*>(value))[UL(index)];
+        svb.s[0] = (*static_cast<const vector<short>*>(value))[UL(index)];
         if(swapBytes) Endian::swapShort(svb);
         success = (fwrite(&(svb.s[0]),1,2,fp)==2);
       }
@@ -196,7 +196,7 @@ bool SaverPly::writeBinaryValue
     case Ply::Element::Property::Type::USHORT:
     case Ply::Element::Property::Type::UINT16:
       {
-        svb.us[0] = (*static_cast<vector<ushort>*>(value))[UL(index)];
+        svb.us[0] = (*static_cast<const vector<ushort>*>(value))[UL(index)];
         if(swapBytes) Endian::swapUShort(svb);
         success = (fwrite(&(svb.us[0]),1,2,fp)==2);
       }
@@ -204,7 +204,7 @@ bool SaverPly::writeBinaryValue
     case Ply::Element::Property::Type::INT:
     case Ply::Element::Property::Type::INT32:
       {
-        svb.i[0] = (*static_cast<vector<int>*>(value))[UL(index)];
+        svb.i[0] = (*static_cast<const vector<int>*>(value))[UL(index)];
         if(swapBytes) Endian::swapInt(svb);
         success = (fwrite(&(svb.i[0]),1,4,fp)==4);
       }
@@ -212,7 +212,7 @@ bool SaverPly::writeBinaryValue
     case Ply::Element::Property::Type::UINT:
     case Ply::Element::Property::Type::UINT32:
       {
-        svb.ui[0] = (*static_cast<vector<uint>*>(value))[UL(index)];
+        svb.ui[0] = (*static_cast<const vector<uint>*>(value))[UL(index)];
         if(swapBytes) Endian::swapUInt(svb);
         success = (fwrite(&(svb.ui[0]),1,4,fp)==4);
       }
@@ -226,7 +226,7 @@ bool SaverPly::writeBinaryValue
           (propertyType==Ply::Element::Property::Type::FLOAT32_3)?3:
           (propertyType==Ply::Element::Property::Type::FLOAT32_2)?2:1;
         for(int i=0;i<n;i++) {
-          svb.f[0] = (*static_cast<vector<float>*>(value))[n*UL(index)+i];
+          svb.f[0] = (*static_cast<const vector<float>*>(value))[n*UL(index)+i];
           if(swapBytes) Endian::swapFloat(svb);
           success = (fwrite(&(svb.f[0]),1,4,fp)==4);
           if(success==false) break;
@@ -236,7 +236,7 @@ bool SaverPly::writeBinaryValue
     case Ply::Element::Property::Type::DOUBLE:
     case Ply::Element::Property::Type::FLOAT64:
       {
-        svb.d[0] = (*static_cast<vector<double>*>(value))[UL(index)];
+        svb.d[0] = (*static_cast<const vector<double>*>(value))[UL(index)];
         if(swapBytes) Endian::swapDouble(svb);
         success = (fwrite(&(svb.d[0]),1,8,fp)==8);
       }
@@ -252,12 +252,12 @@ bool SaverPly::writeBinaryValue
 // static
   
 bool SaverPly::writeBinaryColorValue
-(FILE * fp, const bool swapBytes, void* value, int index) {
+(FILE * fp, const bool swapBytes, const void* value, int index) {
   bool success = false;
   if(fp!=nullptr) {
     Endian::SingleValueBuffer svb;
     for(int i=0;i<3;i++) {
-      float& f = (*static_cast<vector<float>*>(value))[3*UL(index)+i]; 
+      const float& f = (*static_cast<const vector<float>*>(value))[3*UL(index)+i]; 
       svb.uc[0] = static_cast<uchar>(255.0*f); 
       success = (fwrite(&(svb.uc[0]),1,1,fp)==1);
       if(success==false) break;
@@ -270,49 +270,49 @@ bool SaverPly::writeBinaryColorValue
 // static
 bool SaverPly::writeAsciiValue
 (FILE * fp, const Ply::Element::Property::Type propertyType,
- void* value, int index) {
+ const void* value, int index) {
   bool success = false;
   if(fp!=nullptr) {
     switch(propertyType) {
     case Ply::Element::Property::Type::CHAR:
     case Ply::Element::Property::Type::INT8:
       {
-        char & c = (*static_cast<vector<char>*>(value))[UL(index)];
+        const char & c = (*static_cast<const vector<char>*>(value))[UL(index)];
         success = (fprintf(fp,"%d",c)>0);
       }
       break;
     case Ply::Element::Property::Type::UCHAR:
     case Ply::Element::Property::Type::UINT8:
       {
-        uchar & uc = (*static_cast<vector<uchar>*>(value))[UL(index)];
+        const uchar & uc = (*static_cast<const vector<uchar>*>(value))[UL(index)];
         success = (fprintf(fp,"%d",uc)>0);
       }
       break;
     case Ply::Element::Property::Type::SHORT:
     case Ply::Element::Property::Type::INT16:
       {
-        short & s = (*static_cast<vector<short>*>(value))[UL(index)];
+        const short & s = (*static_cast<const vector<short>*>(value))[UL(index)];
         success = (fprintf(fp,"%d",s)>0);
       }
       break;
     case Ply::Element::Property::Type::USHORT:
     case Ply::Element::Property::Type::UINT16:
       {
-        ushort & us = (*static_cast<vector<ushort>*>(value))[UL(index)];
+        const ushort & us = (*static_cast<const vector<ushort>*>(value))[UL(index)];
         success = (fprintf(fp,"%d",us)>0);
       }
       break;
     case Ply::Element::Property::Type::INT:
     case Ply::Element::Property::Type::INT32:
       {
-        int & i = (*static_cast<vector<int>*>(value))[UL(index)];
+        const int & i = (*static_cast<const vector<int>*>(value))[UL(index)];
         success = (fprintf(fp,"%d",i)>0);
       }
       break;
     case Ply::Element::Property::Type::UINT:
     case Ply::Element::Property::Type::UINT32:
       {
-        uint & ui = (*static_cast<vector<uint>*>(value))[UL(index)];
+        const uint & ui = (*static_cast<const vector<uint>*>(value))[UL(index)];
         success = (fprintf(fp,"%d",ui)>0);
       }
       break;
@@ -325,7 +325,7 @@ bool SaverPly::writeAsciiValue
           (propertyType==Ply::Element::Property::Type::FLOAT32_3)?3:
           (propertyType==Ply::Element::Property::Type::FLOAT32_2)?2:1;
         for(int i=0;i<n;i++) {
-          float & f = (*static_cast<vector<float>*>(value))[i+n*UL(index)];
+          const float & f = (*static_cast<const vector<float>*>(value))[i+n*UL(index)];
           success = (fprintf(fp,"%f ",D(f))>0);
           if(success==false) break;
         }
@@ -334,7 +334,7 @@ bool SaverPly::writeAsciiValue
     case Ply::Element::Property::Type::DOUBLE:
     case Ply::Element::Property::Type::FLOAT64:
       {
-        double & d = (*static_cast<vector<double>*>(value))[UL(index)];
+        const double & d = (*static_cast<const vector<double>*>(value))[UL(index)];
         success = (fprintf(fp,"%f",d)>0);
       }
       break; 
@@ -349,11 +349,11 @@ bool SaverPly::writeAsciiValue
 // static
   
 bool SaverPly::writeAsciiColorValue
-(FILE * fp, void* value, int index) {
+(FILE * fp, const void* value, int index) {
   bool success = false;
   if(fp!=nullptr) {
     for(int i=0;i<3;i++) {
-      float& f = (*static_cast<vector<float>*>(value))[3*UL(index)+i]; 
+      const float& f = (*static_cast<const vector<float>*>(value))[3*UL(index)+i]; 
       uchar uc = static_cast<uchar>(255.0*f); 
       success = (fprintf(fp,"%3d ",uc)>0);
       if(success==false) break;
@@ -580,7 +580,7 @@ SaverPly::writeBinaryData
     Ply::Element::Property* property;
     Ply::Element::Property::Type listType;
     Ply::Element::Property::Type propertyType;
-    void* propertyValue;
+    const void* propertyValue;
     int iElement,iList0,iList1,iList,nList,k0,k1;
     int iProperty,iRecord,nElements,nProperties,nRecords;
     string name,propertyName;
@@ -616,7 +616,7 @@ SaverPly::writeBinaryData
           propertyName  = property->getName();
           if(_skipAlpha && propertyName=="alpha") continue;
           propertyType  = property->getPropertyType();
-          propertyValue = property->getValue();
+          propertyValue = property->readValue();
 
           if(property->isList()) {
             listType = property->getListType();
@@ -699,7 +699,7 @@ SaverPly::writeAsciiData
     Ply::Element::Property* property;
     // Ply::Element::Property::Type listType;
     Ply::Element::Property::Type propertyType;
-    void* propertyValue;
+    const void* propertyValue;
     int iElement,iList0,iList1,iList,nList,iProperty;
     int iRecord,nElements,nProperties,nRecords,k0,k1;
     string name,propertyName;
@@ -735,7 +735,7 @@ SaverPly::writeAsciiData
           propertyName  = property->getName();
           if(_skipAlpha && propertyName=="alpha") continue;
           propertyType  = property->getPropertyType();
-          propertyValue = property->getValue();
+          propertyValue = property->readValue();
 
           if(property->isList()) {
             // listType = property->getListType();
@@ -1020,13 +1020,13 @@ SaverPly::writeBinaryData
 
   int i,i0,i1,iF,nList,iV,iN,iC,j,k0,k1;
 
-  vector<float>& coord         = ifs.getCoord();
-  vector<int>&   coordIndex    = ifs.getCoordIndex();
-  vector<float>& normal        = ifs.getNormal();
-  vector<int>&   normalIndex   = ifs.getNormalIndex();
-  vector<float>& color         = ifs.getColor();
-  vector<int>&   colorIndex    = ifs.getColorIndex();
-  vector<float>& texCoord      = ifs.getTexCoord();
+  const vector<float>& coord         = ifs.getCoord();
+  const vector<int>&   coordIndex    = ifs.getCoordIndex();
+  const vector<float>& normal        = ifs.getNormal();
+  const vector<int>&   normalIndex   = ifs.getNormalIndex();
+  const vector<float>& color         = ifs.getColor();
+  const vector<int>&   colorIndex    = ifs.getColorIndex();
+  const vector<float>& texCoord      = ifs.getTexCoord();
   // vector<int>&   texCoordIndex = ifs.getTexCoordIndex();
 
   int nVertices = ifs.getNumberOfVertices();
@@ -1174,13 +1174,13 @@ SaverPly::writeAsciiData
   int i,i0,i1,iF,iV,iN,iC,j,k0,k1;
   uint nList;
 
-  vector<float>& coord         = ifs.getCoord();
-  vector<int>&   coordIndex    = ifs.getCoordIndex();
-  vector<float>& normal        = ifs.getNormal();
-  vector<int>&   normalIndex   = ifs.getNormalIndex();
-  vector<float>& color         = ifs.getColor();
-  vector<int>&   colorIndex    = ifs.getColorIndex();
-  vector<float>& texCoord      = ifs.getTexCoord();
+  const vector<float>& coord         = ifs.getCoord();
+  const vector<int>&   coordIndex    = ifs.getCoordIndex();
+  const vector<float>& normal        = ifs.getNormal();
+  const vector<int>&   normalIndex   = ifs.getNormalIndex();
+  const vector<float>& color         = ifs.getColor();
+  const vector<int>&   colorIndex    = ifs.getColorIndex();
+  const vector<float>& texCoord      = ifs.getTexCoord();
   // vector<int>&   texCoordIndex = ifs.getTexCoordIndex();
 
   int nVertices = ifs.getNumberOfVertices();
@@ -87,17 +87,17 @@ public:
 
   static bool writeBinaryValue
   (FILE * fp, const Ply::Element::Property::Type propertyType,
-   const bool swapBytes, void* value, int i);
+   const bool swapBytes, const void* value, int i);
   
   static bool writeBinaryColorValue
-  (FILE * fp, const bool swapBytes, void* value, int i);
+  (FILE * fp, const bool swapBytes, const void* value, int i);
 
   static bool writeAsciiValue
   (FILE * fp, const Ply::Element::Property::Type propertyType,
-   void* value, int i);
+   const void* value, int i);
   
   static bool writeAsciiColorValue
-  (FILE * fp, void* value, int i);
+  (FILE * fp, const void* value, int i);
   
   static bool
   writeHeader(FILE * fp, Ply& ply, const string indent="",
@@ -58,12 +58,13 @@ bool SaverStl::_saveAscii
 (FILE* fp, const char* solidname, IndexedFaceSet& ifs) const {
 
   int nF = ifs.getNumberOfFaces();
-  vector<float>& coord       = ifs.getCoord();
-  vector<int>&   coordIndex  = ifs.getCoordIndex();
-  vector<float>& normal      = ifs.getNormal();
-  vector<int>&   normalIndex = ifs.getNormalIndex();
+  const vector<float>& coord       = ifs.getCoord();
+  const vector<int>&   coordIndex  = ifs.getCoordIndex();
+  const vector<Index>& faceOffsets = ifs.getFaceOffsets();
+  const vector<float>& normal      = ifs.getNormal();
+  const vector<int>&   normalIndex = ifs.getNormalIndex();
   // already checked that ifs.getNormalPerVertex()==false
-  bool           npf_indexed = (static_cast<int>(normalIndex.size())==nF);
+  bool                 npf_indexed = (static_cast<int>(normalIndex.size())==nF);
 
   fprintf(fp,"solid %s\n",solidname);
     
@@ -71,13 +72,14 @@ bool SaverStl::_saveAscii
   float x0,x1,x2,n0,n1,n2;
 
   int nV = coord.size()/3;
-  Faces* faces = new Faces(nV, coordIndex);
+  Faces* faces = new Faces(nV, coordIndex, faceOffsets);
 
   for(iF=0;iF<nF;iF++) { // for each face ...
 
     // TODO
     // use fprintf() to print formatted text
-    fprintf(fp, "facet normal %f %f %f\n", normal[iF*3], normal[iF*3+1], normal[iF*3+2]);
+    iN = (npf_indexed)?normalIndex[iF]:iF;
+    fprintf(fp, "facet normal %f %f %f\n", normal[iN*3], normal[iN*3+1], normal[iN*3+2]);
     fprintf(fp, "  outer loop\n");
     int faceSize = faces->getFaceSize(iF);
     int iC = faces->getFaceFirstCorner(iF);
@@ -101,12 +103,13 @@ bool SaverStl::_saveBinary
 (FILE* fp, const char* solidname, IndexedFaceSet& ifs) const {
 
   int nF = ifs.getNumberOfFaces();
-  vector<float>& coord       = ifs.getCoord();
-  vector<int>&   coordIndex  = ifs.getCoordIndex();
-  vector<float>& normal      = ifs.getNormal();
-  vector<int>&   normalIndex = ifs.getNormalIndex();
+  const vector<float>& coord       = ifs.getCoord();
+  const vector<int>&   coordIndex  = ifs.getCoordIndex();
+  const vector<Index>& faceOffsets = ifs.getFaceOffsets();
+  const vector<float>& normal      = ifs.getNormal();
+  const vector<int>&   normalIndex = ifs.getNormalIndex();
   // already checked that ifs.getNormalPerVertex()==false
-  bool           npf_indexed = (static_cast<int>(normalIndex.size())==nF);
+  bool                 npf_indexed = (static_cast<int>(normalIndex.size())==nF);
 
   size_t written = 0;
 
@@ -138,7 +141,7 @@ bool SaverStl::_saveBinary
     if(written!=12)
       throw new StrException("unable to write normal vector");
 
-    iV0  = coordIndex[4*iF+0];
+    iV0  = coordIndex[faceOffsets[iF]+0];
     v[0] = coord[3*iV0  ];
     v[1] = coord[3*iV0+1];
     v[2] = coord[3*iV0+2];
@@ -146,7 +149,7 @@ bool SaverStl::_saveBinary
     if(written!=12)
       throw new StrException("unable to write vertex 0");
 
-    iV1  = coordIndex[4*iF+1];
+    iV1  = coordIndex[faceOffsets[iF]+1];
     v[0] = coord[3*iV1  ];
     v[1] = coord[3*iV1+1];
     v[2] = coord[3*iV1+2];
@@ -154,7 +157,7 @@ bool SaverStl::_saveBinary
     if(written!=12)
       throw new StrException("unable to write vertex 1");
 
-    iV2  = coordIndex[4*iF+2];
+    iV2  = coordIndex[faceOffsets[iF]+2];
     v[0] = coord[3*iV2  ];
     v[1] = coord[3*iV2+1];
     v[2] = coord[3*iV2+2];
@@ -195,7 +198,7 @@ bool SaverStl::save(const char* filename, SceneGraph& wrl) const {
     // - construct an instance of the Faces class from the IndexedFaceSet
     // int nV = ifs->getNumberOfCoord();
     // vector<float>& coord      = ifs->getCoord();
-    vector<int>&   coordIndex = ifs->getCoordIndex();
+    const vector<Index>& faceOffsets = ifs->getFaceOffsets();
 
     // 4) the IndexedFaceSet should be a triangle mesh
     // - use the Faces class, or directly the coordIndex array to
@@ -212,13 +215,11 @@ bool SaverStl::save(const char* filename, SceneGraph& wrl) const {
     //     throw new StrException("is not a triangle mesh");
     // }
 
-    int i0,i1,nFs;
-    for(i0=i1=0;i0<static_cast<int>(coordIndex.size());i1++) {
-      if(coordIndex[i1]>=0) continue;
-      nFs = i1-i0; // size of face
+    int iF,nFs,nF = static_cast<int>(faceOffsets.size())-1;
+    for(iF=0;iF<nF;iF++) {
+      nFs = faceOffsets[iF+1]-faceOffsets[iF]-1; // size of face
       if(nFs!=3)
         throw new StrException("is not a triangle mesh");
-      i0=i1+1;
     }
 
     // 5) verify that the IndexedFaceSet has normals per face
@@ -203,16 +203,16 @@ void SaverWrl::saveIndexedFaceSet
   bool&          convex          = ifs.getConvex();
   float&         creaseAngle     = ifs.getCreaseangle();
   bool&          solid           = ifs.getSolid();
-  bool&          normalPerVertex = ifs.getNormalPerVertex();
-  bool&          colorPerVertex  = ifs.getColorPerVertex();
-  vector<float>& coord           = ifs.getCoord();
-  vector<int>&   coordIndex      = ifs.getCoordIndex();
-  vector<float>& normal          = ifs.getNormal();
-  vector<int>&   normalIndex     = ifs.getNormalIndex();
-  vector<float>& color           = ifs.getColor();
-  vector<int>&   colorIndex      = ifs.getColorIndex();
-  vector<float>& texCoord        = ifs.getTexCoord();
-  vector<int>&   texCoordIndex   = ifs.getTexCoordIndex();
+  bool&          normalPerVertex = ifs.editNormalPerVertex();
+  bool&          colorPerVertex  = ifs.editColorPerVertex();
+  const vector<float>& coord           = ifs.getCoord();
+  const vector<int>&   coordIndex      = ifs.getCoordIndex();
+  const vector<float>& normal          = ifs.getNormal();
+  const vector<int>&   normalIndex     = ifs.getNormalIndex();
+  const vector<float>& color           = ifs.getColor();
+  const vector<int>&   colorIndex      = ifs.getColorIndex();
+  const vector<float>& texCoord        = ifs.getTexCoord();
+  const vector<int>&   texCoordIndex   = ifs.getTexCoordIndex();
 
 
   // default ccw TRUE
@@ -386,11 +386,11 @@ void SaverWrl::saveIndexedLineSet
 
   IndexedLineSet& ifs = *indexedLineSet;
 
-  vector<float>& coord           = ifs.getCoord();
-  vector<int>&   coordIndex      = ifs.getCoordIndex();
-  vector<float>& color           = ifs.getColor();
-  vector<int>&   colorIndex      = ifs.getColorIndex();
-  bool&          colorPerVertex  = ifs.getColorPerVertex();
+  const vector<float>& coord           = ifs.getCoord();
+  const vector<int>&   coordIndex      = ifs.getCoordIndex();
+  const vector<float>& color           = ifs.getColor();
+  const vector<int>&   colorIndex      = ifs.getColorIndex();
+  bool&          colorPerVertex  = ifs.editColorPerVertex();
 
   {
     int i;
@@ -40,64 +40,179 @@
 // DAMAGE.
 
 #include <stdio.h>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <charconv>
+#include <algorithm>
 #include "Tokenizer.hpp"
 #include "StrException.hpp"
+#include "util/Parallel.hpp"
 
-Tokenizer::Tokenizer(): _skip(true) {
+static inline bool _isBlank(const char c) {
+  return (c==' ' || c=='\t' || c=='\n' || c==',' || c=='\015'); // c=="^M"
+}
+
+// first blank space character, or first end of line, in [p,end)
+static inline const char* _find
+(const char* p, const char* end, const bool toEndOfLine) {
+  if(toEndOfLine) {
+    const void* q = (p<end)?memchr(p,'\n',static_cast<size_t>(end-p)):nullptr;
+    return (q!=nullptr)?static_cast<const char*>(q):end;
+  }
+  while(p<end && !_isBlank(*p)) p++;
+  return p;
+}
+
+Tokenizer::Tokenizer():
+  _skip(true),
+  _next(nullptr),
+  _end(nullptr),
+  _carry(),
+  _view() {
 }
 
 void Tokenizer::setSkipComments(const bool value) {
   _skip = value;
 }
 
-bool Tokenizer::get() {
-  char c='\0';
+bool Tokenizer::_fill() {
+  const char* data = nullptr;
+  size_t      size = 0;
+  while(fill(data,size))
+    if(size>0) {
+      _next = data;
+      _end  = data+size;
+      return true;
+    }
+  _next = _end;
+  return false;
+}
+
+// collects the characters up to the next blank space, or up to the
+// end of the line; the character which ends the token is consumed,
+// but it is not part of the token
+void Tokenizer::_collect(string_view& tkn, const bool toEndOfLine) {
+  const char* p = _find(_next,_end,toEndOfLine);
+  if(p<_end) {
+    tkn   = string_view(_next,static_cast<size_t>(p-_next));
+    _next = p+1;
+    return;
+  }
+  // the token continues in the next block
+  _carry.assign(_next,static_cast<size_t>(_end-_next));
+  _next = _end;
+  while(_fill()) {
+    p = _find(_next,_end,toEndOfLine);
+    _carry.append(_next,static_cast<size_t>(p-_next));
+    if(p<_end) {
+      _next = p+1;
+      break;
+    }
+    _next = _end;
+  }
+  tkn = string_view(_carry);
+}
+
+bool Tokenizer::getView(string_view& tkn) {
+  clear();
   do {
-    clear();
     // skip blank space
-    while((c=getc())!=EOF)
-      if(!(c==' ' || c=='\t' || c=='\n' || c==',' || c=='\015'))
-        { push_back(c); break; }
-    // collect token characters
-    while(((c=getc())!=EOF) &&
-          !(c==' ' || c=='\t' || c=='\n' || c==',' || c=='\015')) // c=="^M"
-      push_back(c);
-    // if comment, get the rest of the line, including blank spaces
-    if(size()>0 && (*this)[0]=='#') {
-      // last blank space character read is not in tkn yet
-      if(c!='\n')
-        push_back(c);
-      while((c=getc())!=EOF && c!='\n')
-        push_back(c);
+    for(;;) {
+      while(_next<_end && _isBlank(*_next)) _next++;
+      if(_next<_end) break;
+      if(_fill()==false) {
+        _view = tkn = string_view();
+        return false;
+      }
     }
-    // terminate the string
-    // push_back('\0');
-  } while(_skip && length()>0 && *(begin())=='#');
-  
-  return (length()>0)?true:false;
+    // comments extend to the end of the line
+    _collect(tkn,*_next=='#');
+  } while(_skip && tkn[0]=='#');
+  _view = tkn;
+  return true;
+}
+
+bool Tokenizer::get() {
+  string_view tkn;
+  bool success = getView(tkn);
+  assign(tkn.data(),tkn.size());
+  _view = string_view(data(),size());
+  return success;
 }
 
 void Tokenizer::get(const string& errMsg) /* throw(StrException *) */ {
   if(get()==false) throw new StrException(errMsg);
 }
 
-bool Tokenizer::getline() {
+bool Tokenizer::getSpan(const char close, string_view& span) {
   clear();
-  char c='\0';
-  while((c=getc())!=EOF && c!='\n') {
-    push_back(c);
+  _carry.clear();
+  bool inComment = false;
+  for(;;) {
+    if(_next==_end) {
+      if(_fill()==false) {
+        _view = span = string_view(_carry);
+        return false;
+      }
+    }
+    const char* p0    = _next;
+    const char* p     = p0;
+    bool        found = false;
+    while(p<_end && found==false) {
+      size_t n = static_cast<size_t>(_end-p);
+      if(inComment) {
+        const char* q = static_cast<const char*>(memchr(p,'\n',n));
+        inComment = (q==nullptr);
+        p = (inComment)?_end:q+1;
+      } else {
+        const char* c = static_cast<const char*>(memchr(p,close,n));
+        if(c==nullptr) c = _end;
+        const char* h =
+          static_cast<const char*>(memchr(p,'#',static_cast<size_t>(c-p)));
+        if(h!=nullptr) {
+          inComment = true;
+          p = h+1;
+        } else {
+          found = (c<_end);
+          p = c;
+        }
+      }
+    }
+    // the span is in the current block unless it started in a previous one
+    if(found && _carry.empty()) {
+      span  = string_view(p0,static_cast<size_t>(p-p0));
+      _next = p+1;
+      break;
+    }
+    _carry.append(p0,static_cast<size_t>(p-p0));
+    if(found) {
+      span  = string_view(_carry);
+      _next = p+1;
+      break;
+    }
+    _next = _end;
   }
+  _view = span;
+  return true;
+}
+
+bool Tokenizer::getline() {
+  string_view line;
+  _collect(line,true);
+  assign(line.data(),line.size());
+  _view = string_view(data(),size());
   return (length()>0)?true:false;
 }
 
 void Tokenizer::nextline() {
-  char c='\0';
-  while((c=getc())!=EOF && c!='\n');
+  string_view line;
+  _collect(line,true);
 }
-
 bool Tokenizer::getBool(bool& b) {
   bool success = false;
-  if(get()) {
+  string_view tkn;
+  if(getView(tkn)) {
     if(this->equals("t") || this->equals("true") ||
        this->equals("T") || this->equals("TRUE")) {
       b = true;
@@ -112,57 +227,38 @@ bool Tokenizer::getBool(bool& b) {
 }
 
 bool Tokenizer::getInt(int& i) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%d",&i)==1));
-  return success;
+  string_view tkn;
+  return (getView(tkn) && parseInt(tkn,i));
 }
 
 bool Tokenizer::getUInt(unsigned int& ui) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%u",&ui)==1));
-  return success;
+  string_view tkn;
+  return (getView(tkn) && parseUInt(tkn,ui));
 }
 
 bool Tokenizer::getFloat(float& f) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&f)==1));
-  return success;
+  string_view tkn;
+  return (getView(tkn) && parseFloat(tkn,f));
 }
 
 bool Tokenizer::getColor(Color& c) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&(c.r))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(c.g))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(c.b))==1));
-  return success;
+  return getFloat(c.r) && getFloat(c.g) && getFloat(c.b);
 }
 
 bool Tokenizer::getVec4f(Vec4f& v) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.x))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.y))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.z))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.w))==1));
-  return success;
+  return getFloat(v.x) && getFloat(v.y) && getFloat(v.z) && getFloat(v.w);
 }
 
 bool Tokenizer::getVec3f(Vec3f& v) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.x))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.y))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.z))==1));
-  return success;
+  return getFloat(v.x) && getFloat(v.y) && getFloat(v.z);
 }
 
 bool Tokenizer::getVec2f(Vec2f& v) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.x))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.y))==1));
-  return success;
+  return getFloat(v.x) && getFloat(v.y);
 }
 
 bool Tokenizer::equals(const char* str) {
-  return ((*this)==str);
+  return (_view==str);
 }
 
 bool Tokenizer::expecting(const string& str) {
@@ -172,3 +268,161 @@ bool Tokenizer::expecting(const string& str) {
 bool Tokenizer::expecting(const char* str) {
   return get() && this->equals(str);
 }
+
+//////////////////////////////////////////////////////////////////////
+// numeric conversions
+
+// from_chars() does not accept a leading '+'
+static inline const char* _skipPlus(const char* p, const char* end) {
+  return (p+1<end && p[0]=='+' && p[1]!='+' && p[1]!='-')?p+1:p;
+}
+
+static const double _pow10[] = {
+  1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,1e12,1e13,1e14,1e15
+};
+
+// fast path for short decimals such as "-12.375", with no exponent;
+// if the digits, without the point, form an integer m with at most
+// maxDigits digits, both m and 10^k are exact in T, and the quotient
+// m/10^k is correctly rounded, as with strtof() or strtod()
+template<class T>
+static inline bool _parseShortDecimal
+(const char* p, const char* end, const int maxDigits, T& x) {
+  bool negative = false;
+  if(p<end && (*p=='-' || *p=='+')) negative = (*p++=='-');
+  uint64_t m       = 0;
+  int      nDigits = 0;
+  int      k       = 0;
+  bool     point   = false;
+  for(;p<end;p++) {
+    if('0'<=*p && *p<='9') {
+      if(++nDigits>maxDigits) return false;
+      m = 10*m+static_cast<uint64_t>(*p-'0');
+      if(point) k++;
+    } else if(*p=='.' && point==false) {
+      point = true;
+    } else {
+      return false;
+    }
+  }
+  if(nDigits==0) return false;
+  x = static_cast<T>(m)/static_cast<T>(_pow10[k]);
+  if(negative) x = -x;
+  return true;
+}
+
+bool Tokenizer::parseInt(const string_view& s, int& i) {
+  const char* end = s.data()+s.size();
+  return (from_chars(_skipPlus(s.data(),end),end,i).ec==errc());
+}
+
+bool Tokenizer::parseUInt(const string_view& s, unsigned int& ui) {
+  const char* end = s.data()+s.size();
+  return (from_chars(_skipPlus(s.data(),end),end,ui).ec==errc());
+}
+
+bool Tokenizer::parseDouble(const string_view& s, double& d) {
+  const char* end = s.data()+s.size();
+  if(_parseShortDecimal(s.data(),end,15,d)) return true;
+  const char* p = _skipPlus(s.data(),end);
+  from_chars_result r = from_chars(p,end,d);
+  if(r.ec==errc::result_out_of_range) {
+    // overflow or underflow; same values as strtod()
+    const char* e = p;
+    while(e<r.ptr && *e!='e' && *e!='E') e++;
+    bool tiny = (e+1<r.ptr && e[1]=='-');
+    d = (tiny)?0.0:HUGE_VAL;
+    if(*p=='-') d = -d;
+    return true;
+  }
+  return (r.ec==errc());
+}
+
+bool Tokenizer::parseFloat(const string_view& s, float& f) {
+  const char* end = s.data()+s.size();
+  if(_parseShortDecimal(s.data(),end,7,f)) return true;
+  const char* p = _skipPlus(s.data(),end);
+  from_chars_result r = from_chars(p,end,f);
+  if(r.ec==errc::result_out_of_range) {
+    double d;
+    if(parseDouble(string_view(p,static_cast<size_t>(end-p)),d)==false)
+      return false;
+    f = static_cast<float>(d);
+    return true;
+  }
+  return (r.ec==errc());
+}
+
+// calls f(token) for each token in [p,end); comments are skipped
+template<class F>
+static inline void _forEachToken(const char* p, const char* end, F f) {
+  for(;;) {
+    while(p<end && _isBlank(*p)) p++;
+    if(p==end) break;
+    if(*p=='#') {
+      p = _find(p,end,true);
+      continue;
+    }
+    const char* q = p;
+    while(q<end && !_isBlank(*q) && *q!='#') q++;
+    f(string_view(p,static_cast<size_t>(q-p)));
+    p = q;
+  }
+}
+
+// the span is split into chunks of at least MIN_CHUNK bytes; chunk
+// boundaries are moved forward to blank space, so that every token
+// lies in a single chunk; the tokens of each chunk are counted first,
+// and then parsed in place into vec
+template<class T>
+static bool _parseNumbers
+(const string_view& s, vector<T>& vec,
+ bool (*parse)(const string_view&, T&)) {
+  const size_t MIN_CHUNK = 1<<16;
+  const char*  data = s.data();
+  size_t       size = s.size();
+  // comments may span chunk boundaries
+  bool  hasComments = (size>0 && memchr(data,'#',size)!=nullptr);
+  Index nChunks =
+    (hasComments)?1:
+    Parallel::getNumberOfRanges
+    (static_cast<Index>(std::min<size_t>(size/MIN_CHUNK+1,1<<20)),1);
+  vector<size_t> first(nChunks+1,size);
+  first[0] = 0;
+  for(Index iC=1;iC<nChunks;iC++) {
+    size_t i = std::max(first[iC-1],(size/nChunks)*iC);
+    while(i<size && !_isBlank(data[i])) i++;
+    first[iC] = i;
+  }
+  vector<size_t> offset(nChunks+1,vec.size());
+  Parallel::forRanges(nChunks,[&](Index /*iR*/, Index iC0, Index iC1) {
+    for(Index iC=iC0;iC<iC1;iC++) {
+      size_t n = 0;
+      _forEachToken(data+first[iC],data+first[iC+1],
+                    [&n](const string_view&) { n++; });
+      offset[iC+1] = n;
+    }
+  },1);
+  for(Index iC=0;iC<nChunks;iC++)
+    offset[iC+1] += offset[iC];
+  vec.resize(offset[nChunks]);
+  vector<char> success(nChunks,1);
+  Parallel::forRanges(nChunks,[&](Index /*iR*/, Index iC0, Index iC1) {
+    for(Index iC=iC0;iC<iC1;iC++) {
+      T* v = vec.data()+offset[iC];
+      _forEachToken(data+first[iC],data+first[iC+1],
+                    [&](const string_view& tkn) {
+        if(parse(tkn,*v++)==false) success[iC] = 0;
+      });
+    }
+  },1);
+  return (find(success.begin(),success.end(),0)==success.end());
+}
+
+bool Tokenizer::parseInts(const string_view& s, vector<int>& vec) {
+  return _parseNumbers(s,vec,parseInt);
+}
+
+bool Tokenizer::parseFloats(const string_view& s, vector<float>& vec) {
+  return _parseNumbers(s,vec,parseFloat);
+}
@@ -42,24 +42,54 @@
 #ifndef TOKENIZER_HPP
 #define TOKENIZER_HPP
 
+#include <string_view>
+#include <vector>
 #include <wrl/Node.hpp>
 
 // abstract class
 // use TokenizerFile or TokenizerString instead
+//
+// the input is scanned one block at a time, with no per character
+// function calls; derived classes supply the blocks through fill()
 class Tokenizer : public string {
 
 private:
 
-  bool _skip;
+  bool        _skip;
+  const char* _next;  // first character of the current block not consumed yet
+  const char* _end;   // end of the current block
+  string      _carry; // tokens which continue in the next block
+  string_view _view;  // last token
+
+  // returns false at the end of the input; otherwise [data,data+size)
+  // becomes the current block, which must remain valid until the next
+  // call to fill()
+  virtual bool fill(const char*& data, size_t& size) = 0;
+
+  bool _fill();
+  void _collect(string_view& tkn, const bool toEndOfLine);
 
-  virtual char getc() = 0;
+protected:
+
+  // number of characters of the current block not consumed yet
+  size_t unread() const { return static_cast<size_t>(_end-_next); }
+  void   discard()      { _next = _end; }
 
 public:
 
   Tokenizer();
+  virtual ~Tokenizer() { }
 
   bool get();
   void get(const string& errMsg);
+  // same as get(), but the token is not copied; the string is left
+  // empty, and tkn remains valid until the next call
+  bool getView(string_view& tkn);
+  // collects the characters up to the first close character which is
+  // not in a comment, and consumes it; comments are kept in the span;
+  // returns false if the input ends first; span remains valid until
+  // the next call
+  bool getSpan(const char close, string_view& span);
   bool getline();
   void nextline();
   bool getBool(bool& b);
@@ -75,6 +105,21 @@ public:
   bool expecting(const char* str);
   void setSkipComments(const bool value);
 
+  // locale independent conversions, which do not allocate memory; as
+  // with sscanf(), a leading '+' is accepted, and only the longest
+  // prefix of s which is a number is converted
+  static bool parseInt(const string_view& s, int& i);
+  static bool parseUInt(const string_view& s, unsigned int& ui);
+  static bool parseFloat(const string_view& s, float& f);
+  static bool parseDouble(const string_view& s, double& d);
+
+  // parse all the tokens of s, which may contain comments, and append
+  // the values to vec; large spans are split into chunks at blank
+  // space, and the chunks are parsed in parallel; return false if a
+  // token is not a number
+  static bool parseInts(const string_view& s, vector<int>& vec);
+  static bool parseFloats(const string_view& s, vector<float>& vec);
+
 };
 
 #endif // TOKENIZER_HPP
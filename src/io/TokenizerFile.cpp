@@ -44,11 +44,20 @@
 
 TokenizerFile::TokenizerFile(FILE* fp):
   Tokenizer(),
-  _fp(fp) {
+  _fp(fp),
+  _block(BLOCK_SIZE) {
 }
 
-char TokenizerFile::getc() {
-  return static_cast<char>(std::getc(_fp)); // c library function
+bool TokenizerFile::fill(const char*& data, size_t& size) {
+  size = (_fp!=(FILE*)0)?fread(_block.data(),1,_block.size(),_fp):0;
+  data = _block.data();
+  return (size>0);
+}
+
+void TokenizerFile::sync() {
+  if(_fp!=(FILE*)0 && unread()>0)
+    fseek(_fp,-static_cast<long>(unread()),SEEK_CUR);
+  discard();
 }
 
 // #define LINE_BUFFER_LENGTH 1024
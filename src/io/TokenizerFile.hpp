@@ -42,23 +42,36 @@
 #ifndef TOKENIZER_FILE_HPP
 #define TOKENIZER_FILE_HPP
 
+#include <vector>
 #include "Tokenizer.hpp"
 
+// the file is read in blocks of BLOCK_SIZE bytes, starting at the
+// current file position; call sync() before reading from the file
+// directly, or calling ftell()
 class TokenizerFile : public Tokenizer {
 
+public:
+
+  const static size_t BLOCK_SIZE = 1<<16;
+
 protected:
 
-  FILE* _fp;
-  bool  _skip; // if(_skip) skip comments
+  FILE*        _fp;
+  bool         _skip; // if(_skip) skip comments
+  vector<char> _block;
 
 private:
 
-  virtual char getc();
+  virtual bool fill(const char*& data, size_t& size);
 
 public:
 
   TokenizerFile(FILE* fp);
 
+  // moves the file position back to the first character not consumed
+  // yet, and discards the rest of the current block
+  void sync();
+
   // bool getline();
 
 };
@@ -48,9 +48,9 @@ TokenizerString::TokenizerString(const string& str):
   _pos(0) {
 }
 
-char TokenizerString::getc() {
-  if(_pos<_str.length())
-    return _str[_pos++];
-  else
-    return EOF;
+bool TokenizerString::fill(const char*& data, size_t& size) {
+  data = _str.data()+_pos;
+  size = _str.length()-_pos;
+  _pos = _str.length();
+  return (size>0);
 }
@@ -51,7 +51,8 @@ private:
   const string  _str;
   size_t        _pos;
 
-  virtual char getc();
+  // the whole string is a single block
+  virtual bool fill(const char*& data, size_t& size);
 
 public:
 
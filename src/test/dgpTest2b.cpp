@@ -221,15 +221,15 @@ int main(int argc, char **argv) {
       // TODO ...
 
       if (D._removeNormal) {
-        vector<float>& normal = ifs->getNormal();
+        vector<float>& normal = ifs->editNormal();
         normal.clear();
-        vector<int>& normalIndex = ifs->getNormalIndex();
+        vector<int>& normalIndex = ifs->editNormalIndex();
         normalIndex.clear();
         ifs->setNormalPerVertex(true);
       }
 
       if (D._removeColor) {
-        vector<float>& color = ifs->getColor();
+        vector<float>& color = ifs->editColor();
         color.clear();
         vector<int> colorIndex = ifs->getColorIndex();
         colorIndex.clear();
@@ -237,9 +237,9 @@ int main(int argc, char **argv) {
       }
 
       if (D._removeTexCoord) {
-        vector<float>& texCoord = ifs->getTexCoord();
+        vector<float>& texCoord = ifs->editTexCoord();
         texCoord.clear();
-        vector<int>& texCoordIndex = ifs->getTexCoordIndex();
+        vector<int>& texCoordIndex = ifs->editTexCoordIndex();
         texCoordIndex.clear();
       }
 
@@ -34,10 +34,19 @@
 
 #include <string>
 #include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <queue>
+#include <cmath>
+#include <thread>
 
 using namespace std;
 
 #include <wrl/SceneGraphTraversal.hpp>
+#include <wrl/SceneGraphProcessor.hpp>
+#include <wrl/IndexedFaceSetPly.hpp>
 
 #include <io/AppLoader.hpp>
 #include <io/AppSaver.hpp>
@@ -47,9 +56,19 @@ using namespace std;
 #include <io/SaverPly.hpp>
 #include <io/SaverStl.hpp>
 #include <io/SaverWrl.hpp>
+#include <io/TokenizerFile.hpp>
+#include <io/TokenizerString.hpp>
 
 #include <core/PolygonMesh.hpp>
 #include <core/PolygonMeshTest.hpp>
+#include <core/TriangleMesh.hpp>
+#include <core/Partition.hpp>
+#include <core/ConcurrentPartition.hpp>
+#include <core/CsrGraph.hpp>
+#include <core/Graph.hpp>
+#include <core/ExternalHalfEdges.hpp>
+
+#include <util/Parallel.hpp>
 
 #include "dgpPrt.hpp"
 
@@ -58,6 +77,12 @@ public:
   bool   _debug;
   bool   _binaryOutput;
   bool   _removeProperties;
+  bool   _benchmark;
+  bool   _test;
+  bool   _sortBuild;
+  bool   _fastLayout;
+  bool   _topologyCache;
+  bool   _weldStl;
   string _inFile;
   string _outFile;
 public:
@@ -65,6 +90,12 @@ public:
     _debug(false),
     _binaryOutput(false),
     _removeProperties(false),
+    _benchmark(false),
+    _test(false),
+    _sortBuild(false),
+    _fastLayout(false),
+    _topologyCache(false),
+    _weldStl(false),
     _inFile(""),
     _outFile("")
   { }
@@ -74,6 +105,12 @@ void options(Data& D) {
   cout << "   -d|-debug               [" << tv(D._debug)            << "]" << endl;
   cout << "   -b|-binaryOutput        [" << tv(D._binaryOutput)     << "]" << endl;
   cout << "   -r|-removeProperties    [" << tv(D._removeProperties) << "]" << endl;
+  cout << "   -B|-benchmark           [" << tv(D._benchmark)        << "]" << endl;
+  cout << "   -t|-test                [" << tv(D._test)             << "]" << endl;
+  cout << "   -s|-sortBuild           [" << tv(D._sortBuild)        << "]" << endl;
+  cout << "   -f|-fastLayout          [" << tv(D._fastLayout)       << "]" << endl;
+  cout << "   -c|-topologyCache       [" << tv(D._topologyCache)    << "]" << endl;
+  cout << "   -w|-weldStl             [" << tv(D._weldStl)          << "]" << endl;
 }
 
 void usage(Data& D) {
@@ -89,6 +126,2250 @@ void error(const char *msg) {
   exit(0);
 }
 
+//////////////////////////////////////////////////////////////////////
+// synthetic benchmarks
+
+// closed double cone: the two apex vertices 0 and 1 are connected to
+// every vertex of a ring of n vertices 2,...,n+1; both apex vertices
+// have valence n
+void doubleCone(const int n, int& nV, vector<int>& coordIndex) {
+  nV = n+2;
+  coordIndex.clear();
+  for(int i=0;i<n;i++) {
+    int iV0 = 2+i;
+    int iV1 = 2+(i+1)%n;
+    coordIndex.push_back(0); coordIndex.push_back(iV0); coordIndex.push_back(iV1);
+    coordIndex.push_back(-1);
+    coordIndex.push_back(1); coordIndex.push_back(iV1); coordIndex.push_back(iV0);
+    coordIndex.push_back(-1);
+  }
+}
+
+// closed torus of n x n quads, each one split into two triangles
+void torusGrid(const int n, int& nV, vector<int>& coordIndex) {
+  nV = n*n;
+  coordIndex.clear();
+  for(int i=0;i<n;i++) {
+    for(int j=0;j<n;j++) {
+      int iV00 = n*i+j;
+      int iV10 = n*((i+1)%n)+j;
+      int iV11 = n*((i+1)%n)+(j+1)%n;
+      int iV01 = n*i+(j+1)%n;
+      coordIndex.push_back(iV00); coordIndex.push_back(iV10); coordIndex.push_back(iV11);
+      coordIndex.push_back(-1);
+      coordIndex.push_back(iV00); coordIndex.push_back(iV11); coordIndex.push_back(iV01);
+      coordIndex.push_back(-1);
+    }
+  }
+}
+
+// closed torus of n x n quads
+void torusQuads(const int n, int& nV, vector<int>& coordIndex) {
+  nV = n*n;
+  coordIndex.clear();
+  for(int i=0;i<n;i++) {
+    for(int j=0;j<n;j++) {
+      coordIndex.push_back(n*i+j);
+      coordIndex.push_back(n*((i+1)%n)+j);
+      coordIndex.push_back(n*((i+1)%n)+(j+1)%n);
+      coordIndex.push_back(n*i+(j+1)%n);
+      coordIndex.push_back(-1);
+    }
+  }
+}
+
+// an n x n grid of quads with one hole every 4 x 4 quads
+void gridWithHoles(const int n, int& nV, vector<int>& coordIndex) {
+  nV = (n+1)*(n+1);
+  coordIndex.clear();
+  for(int i=0;i<n;i++) {
+    for(int j=0;j<n;j++) {
+      if(i%4==2 && j%4==2) continue;
+      coordIndex.push_back((n+1)*i+j);
+      coordIndex.push_back((n+1)*i+j+1);
+      coordIndex.push_back((n+1)*(i+1)+j+1);
+      coordIndex.push_back((n+1)*(i+1)+j);
+      coordIndex.push_back(-1);
+    }
+  }
+}
+
+// coordinates of the torusGrid() vertices
+void torusCoord(const int n, vector<float>& coord) {
+  coord.clear();
+  for(int i=0;i<n;i++) {
+    double u = 2.0*M_PI*i/n;
+    for(int j=0;j<n;j++) {
+      double v = 2.0*M_PI*j/n;
+      coord.push_back(static_cast<float>((2.0+cos(v))*cos(u)));
+      coord.push_back(static_cast<float>((2.0+cos(v))*sin(u)));
+      coord.push_back(static_cast<float>(sin(v)));
+    }
+  }
+}
+
+// random vertex numbering and random face order, as in meshes
+// assembled from triangle soups
+void shuffleMesh
+(const int nV, vector<float>& coord, vector<int>& coordIndex) {
+  mt19937 generator(2025);
+  vector<int> newIndex(nV);
+  for(int iV=0;iV<nV;iV++) newIndex[iV] = iV;
+  shuffle(newIndex.begin(),newIndex.end(),generator);
+  vector<float> newCoord(coord.size());
+  for(int iV=0;iV<nV;iV++)
+    for(int j=0;j<3;j++)
+      newCoord[3*newIndex[iV]+j] = coord[3*iV+j];
+  coord.swap(newCoord);
+  vector<int> faceFirst;
+  for(int i=0;i<(int)coordIndex.size();i++) {
+    if(i==0 || coordIndex[i-1]<0) faceFirst.push_back(i);
+    if(coordIndex[i]>=0) coordIndex[i] = newIndex[coordIndex[i]];
+  }
+  shuffle(faceFirst.begin(),faceFirst.end(),generator);
+  vector<int> newCoordIndex;
+  for(int iF=0;iF<(int)faceFirst.size();iF++)
+    for(int i=faceFirst[iF];i<(int)coordIndex.size();i++) {
+      newCoordIndex.push_back(coordIndex[i]);
+      if(coordIndex[i]<0) break;
+    }
+  coordIndex.swap(newCoordIndex);
+}
+
+// misses of a set associative cache with 64 byte lines and least
+// recently used replacement, for the coord accesses made while
+// traversing coordIndex
+long long coordCacheMisses
+(const vector<int>& coordIndex, const int cacheBytes, const int nWays) {
+  const int lineBytes = 64;
+  int nSets = cacheBytes/(lineBytes*nWays);
+  vector<long long> tag(nSets*nWays,-1);
+  long long nMisses = 0;
+  for(int i=0;i<(int)coordIndex.size();i++) {
+    if(coordIndex[i]<0) continue;
+    long long a0 = 12LL*coordIndex[i];
+    for(long long line=a0/lineBytes;line<=(a0+11)/lineBytes;line++) {
+      long long* set = tag.data()+(line%nSets)*nWays;
+      int w = 0;
+      while(w<nWays-1 && set[w]!=line) w++;
+      if(set[w]!=line) nMisses++;
+      // move to the front of the set
+      for(;w>0;w--) set[w] = set[w-1];
+      set[0] = line;
+    }
+  }
+  return nMisses;
+}
+
+// the first IndexedFaceSet found in the scene graph
+IndexedFaceSet* firstIndexedFaceSet(SceneGraph& wrl) {
+  Node* node;
+  SceneGraphTraversal sgt(wrl);
+  while((node=sgt.next())!=(Node*)0) {
+    Shape* shape = dynamic_cast<Shape*>(node);
+    if(shape==(Shape*)0) continue;
+    IndexedFaceSet* ifs = dynamic_cast<IndexedFaceSet*>(shape->getGeometry());
+    if(ifs!=(IndexedFaceSet*)0) return ifs;
+  }
+  return (IndexedFaceSet*)0;
+}
+
+// a scene graph with a single torusGrid() IndexedFaceSet
+void torusSceneGraph(const int n, SceneGraph& wrl) {
+  int nV;
+  Shape* shape = new Shape();
+  IndexedFaceSet* ifs = new IndexedFaceSet();
+  shape->setGeometry(ifs);
+  wrl.addChild(shape);
+  torusCoord(n,ifs->editCoord());
+  torusGrid(n,nV,ifs->editCoordIndex());
+}
+
+double secondsSince(const chrono::steady_clock::time_point& t0) {
+  chrono::duration<double> dt = chrono::steady_clock::now()-t0;
+  return dt.count();
+}
+
+int benchmark() {
+  // number of tables with different results
+  int nMismatches = 0;
+  cout << "dgpTest2c benchmark {" << endl;
+  cout << "  PolygonMesh construction on a double cone of valence n {" << endl;
+  cout << "          n   LINKED_LISTS(s)     HASH_TABLE(s)" << endl;
+  Edges::IndexType       indexType0   = Edges::getIndexType();
+  HalfEdges::BuildMethod buildMethod0 = HalfEdges::getBuildMethod();
+  int nV; vector<int> coordIndex;
+  for(int n=1000;n<=8000;n*=2) {
+    doubleCone(n,nV,coordIndex);
+    double t[2];
+    Edges::IndexType indexType[2] = { Edges::LINKED_LISTS, Edges::HASH_TABLE };
+    for(int k=0;k<2;k++) {
+      Edges::setIndexType(indexType[k]);
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      PolygonMesh pMesh(nV,coordIndex);
+      t[k] = secondsSince(t0);
+    }
+    printf("    %7d %17.6f %17.6f\n",n,t[0],t[1]);
+  }
+  Edges::setIndexType(indexType0);
+  cout << "  }" << endl;
+  cout << "  HalfEdges construction on a torus of 2 x n x n triangles {" << endl;
+  cout << "          n    INCREMENTAL(s)           SORT(s)" << endl;
+  for(int n=250;n<=2000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    double t[2];
+    HalfEdges::BuildMethod buildMethod[2] = { HalfEdges::INCREMENTAL, HalfEdges::SORT };
+    for(int k=0;k<2;k++) {
+      HalfEdges::setBuildMethod(buildMethod[k]);
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      HalfEdges halfEdges(nV,coordIndex);
+      t[k] = secondsSince(t0);
+    }
+    printf("    %7d %17.6f %17.6f\n",n,t[0],t[1]);
+  }
+  HalfEdges::setBuildMethod(buildMethod0);
+  cout << "  }" << endl;
+  cout << "  HalfEdges layouts on a torus of n x n quads {" << endl;
+  cout << "    memory, and one getPrev(getNext(iC)) per corner" << endl;
+  cout << "          n    COMPACT(MB)       FAST(MB)     COMPACT(s)        FAST(s)" << endl;
+  HalfEdges::Layout layout0 = HalfEdges::getLayout();
+  for(int n=250;n<=2000;n*=2) {
+    torusQuads(n,nV,coordIndex);
+    double mb[2],t[2];
+    long long sum[2] = { 0, 0 };
+    HalfEdges::Layout layout[2] = { HalfEdges::COMPACT, HalfEdges::FAST };
+    for(int k=0;k<2;k++) {
+      HalfEdges::setLayout(layout[k]);
+      HalfEdges halfEdges(nV,coordIndex);
+      mb[k] = static_cast<double>(halfEdges.getMemoryUsage())/(1024.0*1024.0);
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      int nC = halfEdges.getNumberOfCorners();
+      for(int iC=0;iC<nC;iC++)
+        sum[k] += halfEdges.getPrev(halfEdges.getNext(iC));
+      t[k] = secondsSince(t0);
+    }
+    printf("    %7d %14.3f %14.3f %14.6f %14.6f (%lld,%lld)\n",n,mb[0],mb[1],t[0],t[1],sum[0],sum[1]);
+  }
+  HalfEdges::setLayout(layout0);
+  cout << "  }" << endl;
+  cout << "  PolygonMesh vertex one-rings on a torus of n x n quads {" << endl;
+  cout << "          n    incidence(s)      one-rings(s)   ordered" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    torusQuads(n,nV,coordIndex);
+    PolygonMesh pMesh(nV,coordIndex);
+    double t[2];
+    int nOrdered = 0;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    pMesh.getNumberOfVertexCorners(0);
+    t[0] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    vector<Index> corners;
+    for(int iV=0;iV<nV;iV++)
+      if(pMesh.getVertexOneRing(iV,corners)) nOrdered++;
+    t[1] = secondsSince(t0);
+    printf("    %7d %15.6f %17.6f %9d\n",n,t[0],t[1],nOrdered);
+  }
+  cout << "  }" << endl;
+  cout << "  PolygonMesh vs TriangleMesh on a torus of 2 x n x n triangles {" << endl;
+  cout << "    construction, and one getPrev(getTwin(getNext(iC))) per corner, also with" << endl;
+  cout << "    the unchecked TriangleMesh accessors" << endl;
+  cout << "          n    PolygonMesh(s)   TriangleMesh(s)  PolygonMesh(s)  TriangleMesh(s)    unchecked(s)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    double t[5];
+    long long sum[3] = { 0, 0, 0 };
+    {
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      PolygonMesh pMesh(nV,coordIndex);
+      t[0] = secondsSince(t0);
+      t0 = chrono::steady_clock::now();
+      int nC = pMesh.getNumberOfCorners();
+      for(int iC=0;iC<nC;iC++)
+        sum[0] += pMesh.getPrev(pMesh.getTwin(pMesh.getNext(iC)));
+      t[2] = secondsSince(t0);
+    }
+    {
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      TriangleMesh tMesh(nV,coordIndex);
+      t[1] = secondsSince(t0);
+      t0 = chrono::steady_clock::now();
+      int nC = tMesh.getNumberOfCorners();
+      for(int iC=0;iC<nC;iC++)
+        sum[1] += tMesh.getPrev(tMesh.getTwin(tMesh.getNext(iC)));
+      t[3] = secondsSince(t0);
+      // the torus has no boundary, so every twin is a valid corner
+      t0 = chrono::steady_clock::now();
+      for(int iC=0;iC<nC;iC++)
+        sum[2] += tMesh.prevUnchecked(tMesh.twinUnchecked(tMesh.nextUnchecked(iC)));
+      t[4] = secondsSince(t0);
+    }
+    if(sum[1]!=sum[2]) nMismatches++;
+    // print the checksums so that the loops are not optimized away
+    printf("    %7d %17.6f %17.6f %15.6f %16.6f %15.6f (%lld,%lld,%lld)\n",
+           n,t[0],t[1],t[2],t[3],t[4],sum[0],sum[1],sum[2]);
+  }
+  cout << "  }" << endl;
+  cout << "  TriangleMesh local edits on a torus of 2 x n x n triangles {" << endl;
+  cout << "    10000 edge flips, 10000 edge splits, 10000 edge collapses" << endl;
+  cout << "          n       rebuild(s)         flips(s)        splits(s)     collapses(s)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    double t[4];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    TriangleMesh tMesh(nV,coordIndex);
+    t[0] = secondsSince(t0);
+    // edges are visited with a fixed stride, to spread the edits
+    int nE = tMesh.getNumberOfEdges();
+    int stride = 7919;
+    int iE = 0;
+    t0 = chrono::steady_clock::now();
+    for(int i=0;i<10000;i++,iE=(iE+stride)%nE) tMesh.flipEdge(iE);
+    t[1] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    for(int i=0;i<10000;i++,iE=(iE+stride)%nE) tMesh.splitEdge(iE);
+    t[2] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    for(int i=0;i<10000;i++,iE=(iE+stride)%nE) tMesh.collapseEdge(iE);
+    t[3] = secondsSince(t0);
+    printf("    %7d %16.6f %16.6f %16.6f %16.6f\n",n,t[0],t[1],t[2],t[3]);
+  }
+  cout << "  }" << endl;
+  cout << "  PolygonMesh topology cache on a torus of 2 x n x n triangles {" << endl;
+  cout << "    construction without cache, with an empty cache, and with the file in the cache" << endl;
+  cout << "          n       no cache(s)      cold cache(s)      warm cache(s)    file(MB)" << endl;
+  string cacheDirectory0 = PolygonMesh::getCacheDirectory();
+  string tmpDirectory = filesystem::temp_directory_path().string();
+  for(int n=250;n<=1000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    PolygonMesh::setCacheDirectory(tmpDirectory);
+    string filename = PolygonMesh::getCacheFilename(nV,coordIndex);
+    remove(filename.c_str());
+    double t[3];
+    string cacheDirectory[3] = { "", tmpDirectory, tmpDirectory };
+    for(int k=0;k<3;k++) {
+      PolygonMesh::setCacheDirectory(cacheDirectory[k]);
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      PolygonMesh pMesh(nV,coordIndex);
+      t[k] = secondsSince(t0);
+    }
+    error_code ec;
+    uintmax_t size = filesystem::file_size(filename,ec);
+    double mb = (ec)?0.0:static_cast<double>(size)/(1024.0*1024.0);
+    remove(filename.c_str());
+    printf("    %7d %17.6f %18.6f %18.6f %11.3f\n",n,t[0],t[1],t[2],mb);
+  }
+  PolygonMesh::setCacheDirectory(cacheDirectory0);
+  cout << "  }" << endl;
+  cout << "  PolygonMesh classification on demand on a torus of 2 x n x n triangles {" << endl;
+  cout << "    construction and hasBoundary(), then the first isBoundaryVertex() and isSingularVertex()" << endl;
+  cout << "          n    hasBoundary(s) isBoundaryVertex(s) isSingularVertex(s)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    double t[3];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    PolygonMesh pMesh(nV,coordIndex);
+    bool hasBoundary = pMesh.hasBoundary();
+    t[0] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    bool isBoundary = pMesh.isBoundaryVertex(0);
+    t[1] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    bool isSingular = pMesh.isSingularVertex(0);
+    t[2] = secondsSince(t0);
+    printf("    %7d %17.6f %19.6f %19.6f (%d,%d,%d)\n",
+           n,t[0],t[1],t[2],hasBoundary,isBoundary,isSingular);
+  }
+  cout << "  }" << endl;
+  cout << "  PolygonMesh components and orientation on a torus of n x n quads {" << endl;
+  cout << "    with one face out of three reversed" << endl;
+  cout << "          n    components(s)   orientation(s)   reversed" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    torusQuads(n,nV,coordIndex);
+    for(int iC0=0,iC1=0,iF=0;iC1<(int)coordIndex.size();iC1++) {
+      if(coordIndex[iC1]>=0) continue;
+      if(iF%3==1) reverse(coordIndex.begin()+iC0,coordIndex.begin()+iC1);
+      iC0 = iC1+1; iF++;
+    }
+    PolygonMesh pMesh(nV,coordIndex);
+    double t[2];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    pMesh.getNumberOfComponents();
+    t[0] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    vector<int> orientedCoordIndex;
+    int nReversed = pMesh.getOrientedCoordIndex(orientedCoordIndex);
+    t[1] = secondsSince(t0);
+    printf("    %7d %16.6f %16.6f %10d\n",n,t[0],t[1],nReversed);
+  }
+  cout << "  }" << endl;
+  cout << "  PolygonMesh boundary loops on a grid of n x n quads with a hole every 4 x 4 quads {" << endl;
+  cout << "          n    boundary loops(s)      loops    corners" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    gridWithHoles(n,nV,coordIndex);
+    PolygonMesh pMesh(nV,coordIndex);
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    int nLoops = pMesh.getNumberOfBoundaryLoops();
+    double t = secondsSince(t0);
+    int nCorners = 0;
+    for(int iL=0;iL<nLoops;iL++)
+      nCorners += pMesh.getBoundaryLoopSize(iL);
+    printf("    %7d %20.6f %10d %10d\n",n,t,nLoops,nCorners);
+  }
+  cout << "  }" << endl;
+  cout << "  CsrGraph dual graph of a torus of 2 x n x n triangles {" << endl;
+  cout << "    CsrGraph::buildDualGraph(), and one pass over the neighbors of every face" << endl;
+  cout << "    compared with getTwin() on every corner" << endl;
+  cout << "          n      dual graph(s)     arcs(s)    getTwin(s)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    PolygonMesh pMesh(nV,coordIndex);
+    double t[3];
+    long long sum[2] = { 0, 0 };
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    CsrGraph dual;
+    dual.buildDualGraph(pMesh);
+    t[0] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    const vector<Index>& firstArc = dual.getFirstArc();
+    const vector<Index>& arcNode  = dual.getArcNode();
+    int nF = dual.getNumberOfNodes();
+    for(int iF=0;iF<nF;iF++)
+      for(Index iA=firstArc[iF];iA<firstArc[iF+1];iA++)
+        sum[0] += arcNode[iA];
+    t[1] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    int nC = pMesh.getNumberOfCorners();
+    for(int iC=0;iC<nC;iC++)
+      sum[1] += pMesh.getFace(pMesh.getTwin(iC));
+    t[2] = secondsSince(t0);
+    printf("    %7d %18.6f %11.6f %13.6f (%lld,%lld)\n",n,t[0],t[1],t[2],sum[0],sum[1]);
+  }
+  cout << "  }" << endl;
+  cout << "  CsrGraph algorithms on the edges of a torus of 2 x n x n triangles {" << endl;
+  cout << "    edge lengths from a flat embedding of the grid" << endl;
+  cout << "          n   snapshot(s)        bfs(s) components(s)        mst(s)   dijkstra(s)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    PolygonMesh pMesh(nV,coordIndex);
+    vector<float> coord;
+    for(int iV=0;iV<nV;iV++) {
+      coord.push_back(static_cast<float>(iV%n));
+      coord.push_back(static_cast<float>(iV/n));
+      coord.push_back(0.0f);
+    }
+    double t[5];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    CsrGraph graph;
+    graph.buildGraph(pMesh);
+    vector<double> edgeLength;
+    CsrGraph::getEdgeLengths(pMesh,coord,edgeLength);
+    t[0] = secondsSince(t0);
+    vector<Index> sources(1,0),level,component,forestEdges,parent;
+    vector<double> distance;
+    t0 = chrono::steady_clock::now();
+    graph.getBreadthFirstLevels(sources,level);
+    t[1] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    int nComponents = graph.getConnectedComponents(component);
+    t[2] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    double length = graph.getMinimumSpanningForest(edgeLength,forestEdges);
+    t[3] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    graph.getShortestPaths(edgeLength,sources,distance,parent);
+    t[4] = secondsSince(t0);
+    printf("    %7d %13.6f %13.6f %13.6f %13.6f %13.6f (%d,%.0f)\n",
+           n,t[0],t[1],t[2],t[3],t[4],nComponents,length);
+  }
+  cout << "  }" << endl;
+  cout << "  ExternalHalfEdges on a torus of 2 x n x n triangles {" << endl;
+  cout << "    in memory HalfEdges (SORT), and out of core with a 16MB memory budget" << endl;
+  cout << "          n     in memory(s)   out of core(s)    runs" << endl;
+  size_t memoryBudget0 = ExternalHalfEdges::getMemoryBudget();
+  ExternalHalfEdges::setMemoryBudget(static_cast<size_t>(16)<<20);
+  HalfEdges::setBuildMethod(HalfEdges::SORT);
+  string tablePrefix = (filesystem::temp_directory_path()/"dgpTest2c").string();
+  string coordIndexFile = tablePrefix+".coordIndex";
+  for(int n=250;n<=1000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    double t[2];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    {
+      HalfEdges halfEdges(nV,coordIndex);
+    }
+    t[0] = secondsSince(t0);
+    ExternalHalfEdges::writeCoordIndex(coordIndexFile,coordIndex);
+    coordIndex.clear();
+    t0 = chrono::steady_clock::now();
+    size_t nRuns = 0;
+    {
+      ExternalHalfEdges halfEdges(coordIndexFile,tablePrefix);
+      nRuns = halfEdges.getNumberOfRuns();
+    }
+    t[1] = secondsSince(t0);
+    ExternalHalfEdges::removeTables(tablePrefix);
+    remove(coordIndexFile.c_str());
+    printf("    %7d %16.6f %16.6f %7zu\n",n,t[0],t[1],nRuns);
+  }
+  HalfEdges::setBuildMethod(buildMethod0);
+  ExternalHalfEdges::setMemoryBudget(memoryBudget0);
+  cout << "  }" << endl;
+  cout << "  IndexedFaceSet vertex and face reordering on a shuffled torus of 2 x n x n triangles {" << endl;
+  cout << "    coord cache misses per corner with 32KB and 1MB 8-way LRU caches, reordering time," << endl;
+  cout << "    SceneGraphProcessor::computeNormalPerVertex() and PolygonMesh construction time" << endl;
+  cout << "          n    order    32KB misses     1MB misses     reorder(s)     normals(s) PolygonMesh(s)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    vector<float> coord;
+    torusGrid(n,nV,coordIndex);
+    torusCoord(n,coord);
+    shuffleMesh(nV,coord,coordIndex);
+    const char* orderName[4] = { "none", "Morton", "Hilbert", "RCM" };
+    for(int k=0;k<4;k++) {
+      SceneGraph wrl;
+      Shape* shape = new Shape();
+      IndexedFaceSet* ifs = new IndexedFaceSet();
+      shape->setGeometry(ifs);
+      wrl.addChild(shape);
+      ifs->editCoord() = coord;
+      ifs->editCoordIndex() = coordIndex;
+      SceneGraphProcessor processor(wrl);
+      double t[3];
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      if(k==1) processor.reorderVerticesMorton();
+      if(k==2) processor.reorderVerticesHilbert();
+      if(k==3) processor.reorderVerticesRcm();
+      if(k>0)  processor.reorderFaces();
+      t[0] = secondsSince(t0);
+      int nC = ifs->getNumberOfCorners();
+      double m32K = static_cast<double>(coordCacheMisses(ifs->getCoordIndex(),32<<10,8))/nC;
+      double m1M  = static_cast<double>(coordCacheMisses(ifs->getCoordIndex(),1<<20,8))/nC;
+      t0 = chrono::steady_clock::now();
+      processor.computeNormalPerVertex();
+      t[1] = secondsSince(t0);
+      t0 = chrono::steady_clock::now();
+      {
+        PolygonMesh pMesh(nV,ifs->getCoordIndex());
+      }
+      t[2] = secondsSince(t0);
+      printf("    %7d %8s %14.4f %14.4f %14.6f %14.6f %14.6f\n",
+             n,orderName[k],m32K,m1M,t[0],t[1],t[2]);
+    }
+  }
+  cout << "  }" << endl;
+  cout << "  SceneGraphProcessor::compact() on a torus of 2 x n x n triangles {" << endl;
+  cout << "    with n*n unreferenced vertices, and one degenerate face every 8 faces" << endl;
+  cout << "          n     1 thread(s)   all threads(s)  removed faces removed vertices" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    vector<float> coord;
+    torusGrid(n,nV,coordIndex);
+    torusCoord(n,coord);
+    coord.insert(coord.end(),coord.begin(),coord.end());
+    for(int i=0;i<(int)coordIndex.size();i+=32) coordIndex[i+1] = coordIndex[i];
+    double t[2];
+    int nRemovedFaces = 0, nRemovedVertices = 0;
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    for(int k=0;k<2;k++) {
+      SceneGraph wrl;
+      Shape* shape = new Shape();
+      IndexedFaceSet* ifs = new IndexedFaceSet();
+      shape->setGeometry(ifs);
+      wrl.addChild(shape);
+      ifs->editCoord() = coord;
+      ifs->editCoordIndex() = coordIndex;
+      SceneGraphProcessor processor(wrl);
+      Parallel::setNumberOfThreads((k==0)?1:nThreads0);
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      processor.compact();
+      t[k] = secondsSince(t0);
+      nRemovedFaces    = 2*n*n-ifs->getNumberOfFaces();
+      nRemovedVertices = 2*n*n-ifs->getNumberOfVertices();
+    }
+    Parallel::setNumberOfThreads(nThreads0);
+    printf("    %7d %15.6f %16.6f %14d %16d\n",
+           n,t[0],t[1],nRemovedFaces,nRemovedVertices);
+  }
+  cout << "  }" << endl;
+  cout << "  IndexedFaceSet face offsets on a torus of 2 x n x n triangles {" << endl;
+  cout << "    first and cached getFaceOffsets(), then ten getNumberOfFaces() and isTriangleMesh()," << endl;
+  cout << "    and normal computation iterating over the cached face offsets" << endl;
+  cout << "          n       build(s)      cached(s)     queries(s)   perFace(s) perVertex(s)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    vector<float> coord;
+    torusGrid(n,nV,coordIndex);
+    torusCoord(n,coord);
+    SceneGraph wrl;
+    Shape* shape = new Shape();
+    IndexedFaceSet* ifs = new IndexedFaceSet();
+    shape->setGeometry(ifs);
+    wrl.addChild(shape);
+    ifs->editCoord() = coord;
+    ifs->editCoordIndex() = coordIndex;
+    SceneGraphProcessor processor(wrl);
+    double t[5];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    ifs->getFaceOffsets();
+    t[0] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    ifs->getFaceOffsets();
+    t[1] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    int nTriangles = 0;
+    for(int k=0;k<10;k++)
+      if(ifs->isTriangleMesh()) nTriangles += ifs->getNumberOfFaces();
+    t[2] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    processor.computeNormalPerFace();
+    t[3] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    processor.computeNormalPerVertex();
+    t[4] = secondsSince(t0);
+    printf("    %7d %14.6f %14.6f %14.6f %12.6f %12.6f (%d)\n",
+           n,t[0],t[1],t[2],t[3],t[4],nTriangles);
+  }
+  cout << "  }" << endl;
+  cout << "  IndexedFaceSet derived data on a torus of 2 x n x n triangles {" << endl;
+  cout << "    computed, requested again with unchanged inputs, and after one coord is modified" << endl;
+  cout << "          n  normal(s)  cached(s)  edited(s)    mesh(s)  cached(s)  edited(s)    bbox(s)  cached(s)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    vector<float> coord;
+    torusGrid(n,nV,coordIndex);
+    torusCoord(n,coord);
+    SceneGraph wrl;
+    Shape* shape = new Shape();
+    IndexedFaceSet* ifs = new IndexedFaceSet();
+    shape->setGeometry(ifs);
+    wrl.addChild(shape);
+    ifs->editCoord() = coord;
+    ifs->editCoordIndex() = coordIndex;
+    SceneGraphProcessor processor(wrl);
+    double t[8];
+    // normals depend on coord and coordIndex
+    for(int k=0;k<3;k++) {
+      if(k==2) ifs->editCoord()[0] += 0.5f;
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      processor.computeNormalPerVertex();
+      t[k] = secondsSince(t0);
+    }
+    // the PolygonMesh only depends on coordIndex
+    for(int k=0;k<3;k++) {
+      if(k==2) ifs->editCoord()[0] -= 0.5f;
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      SceneGraphProcessor::getPolygonMesh(*ifs);
+      t[3+k] = secondsSince(t0);
+    }
+    for(int k=0;k<2;k++) {
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      wrl.clearBBox();
+      wrl.updateBBox();
+      t[6+k] = secondsSince(t0);
+    }
+    printf("    %7d %10.6f %10.6f %10.6f %10.6f %10.6f %10.6f %10.6f %10.6f\n",
+           n,t[0],t[1],t[2],t[3],t[4],t[5],t[6],t[7]);
+  }
+  cout << "  }" << endl;
+  cout << "  IndexedFaceSet copy-on-write arrays on a torus of 2 x n x n triangles {" << endl;
+  cout << "    deep copy of the arrays, share(), first write to the shared coord, and edgesAdd()" << endl;
+  cout << "          n    copy(s)   share(s)   write(s)  edges(s)  shared(MB)" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    vector<float> coord;
+    torusGrid(n,nV,coordIndex);
+    torusCoord(n,coord);
+    SceneGraph wrl;
+    Shape* shape = new Shape();
+    IndexedFaceSet* ifs = new IndexedFaceSet();
+    shape->setGeometry(ifs);
+    wrl.addChild(shape);
+    ifs->editCoord() = coord;
+    ifs->editCoordIndex() = coordIndex;
+    double t[4];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    {
+      IndexedFaceSet copy;
+      copy.editCoord() = ifs->getCoord();
+      copy.editCoordIndex() = ifs->getCoordIndex();
+    }
+    t[0] = secondsSince(t0);
+    ifs->seal();
+    IndexedFaceSet shared;
+    t0 = chrono::steady_clock::now();
+    shared.share(*ifs);
+    t[1] = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    shared.editCoord()[0] += 1.0f;
+    t[2] = secondsSince(t0);
+    SceneGraphProcessor processor(wrl);
+    t0 = chrono::steady_clock::now();
+    processor.edgesAdd();
+    t[3] = secondsSince(t0);
+    double mb = 0.0;
+    if(ifs->getSharedCoord().isShared())
+      mb += (double)(ifs->getCoord().size()*sizeof(float))/(1024.0*1024.0);
+    if(shared.getSharedCoordIndex().isShared())
+      mb += (double)(ifs->getCoordIndex().size()*sizeof(int))/(1024.0*1024.0);
+    printf("    %7d %10.6f %10.6f %10.6f %9.6f %11.2f\n",
+           n,t[0],t[1],t[2],t[3],mb);
+  }
+  cout << "  }" << endl;
+  cout << "  LoaderStl binary STL of a torus of 2 x n x n triangles {" << endl;
+  cout << "          n   file(MB)     1 thread(s)   all threads(s)   all threads(MB/s)" << endl;
+  string stlFile = (filesystem::temp_directory_path()/"dgpTest2c.stl").string();
+  for(int n=250;n<=1000;n*=2) {
+    vector<float> coord;
+    torusGrid(n,nV,coordIndex);
+    torusCoord(n,coord);
+    {
+      SceneGraph wrl;
+      Shape* shape = new Shape();
+      IndexedFaceSet* ifs = new IndexedFaceSet();
+      shape->setGeometry(ifs);
+      wrl.addChild(shape);
+      ifs->editCoord() = coord;
+      ifs->editCoordIndex() = coordIndex;
+      SceneGraphProcessor processor(wrl);
+      processor.computeNormalPerFace();
+      SaverStl saver;
+      SaverStl::setFileType(SaverStl::FileType::BINARY);
+      saver.save(stlFile.c_str(),wrl);
+      SaverStl::setFileType(SaverStl::FileType::ASCII);
+    }
+    double mb = (double)filesystem::file_size(stlFile)/(1024.0*1024.0);
+    double t[2];
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    for(int k=0;k<2;k++) {
+      SceneGraph wrl;
+      LoaderStl loader;
+      Parallel::setNumberOfThreads((k==0)?1:nThreads0);
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      loader.load(stlFile.c_str(),wrl);
+      t[k] = secondsSince(t0);
+    }
+    Parallel::setNumberOfThreads(nThreads0);
+    printf("    %7d %10.2f %15.6f %16.6f %19.1f\n",
+           n,mb,t[0],t[1],mb/t[1]);
+  }
+  filesystem::remove(stlFile);
+  cout << "  }" << endl;
+  cout << "  SceneGraphProcessor::weldVertices torus of 2 x n x n triangles, 3 vertices per triangle {" << endl;
+  cout << "          n   nV before    nV after  1 thread(s)  all threads(s)  boundary edges before/after" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    vector<float> coord;
+    torusGrid(n,nV,coordIndex);
+    torusCoord(n,coord);
+    // split the mesh into separate triangles, as in an STL file
+    vector<float> soupCoord;
+    vector<int>   soupCoordIndex;
+    for(int i=0;i<(int)coordIndex.size();i++) {
+      int iV = coordIndex[i];
+      if(iV<0) { soupCoordIndex.push_back(-1); continue; }
+      soupCoordIndex.push_back((int)(soupCoord.size()/3));
+      soupCoord.push_back(coord[3*iV  ]);
+      soupCoord.push_back(coord[3*iV+1]);
+      soupCoord.push_back(coord[3*iV+2]);
+    }
+    int nVBefore = (int)(soupCoord.size()/3);
+    int nVAfter  = 0;
+    Index nBBefore = 0;
+    Index nBAfter  = 0;
+    double t[2];
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    for(int k=0;k<2;k++) {
+      IndexedFaceSet ifs;
+      ifs.editCoord()      = soupCoord;
+      ifs.editCoordIndex() = soupCoordIndex;
+      if(k==0) {
+        shared_ptr<const PolygonMesh> pm = SceneGraphProcessor::getPolygonMesh(ifs);
+        for(Index iE=0;iE<pm->getNumberOfEdges();iE++)
+          if(pm->isBoundaryEdge(iE)) nBBefore++;
+      }
+      Parallel::setNumberOfThreads((k==0)?1:nThreads0);
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      SceneGraphProcessor::weldVertices(ifs,0.0f);
+      t[k] = secondsSince(t0);
+      if(k==1) {
+        nVAfter = ifs.getNumberOfVertices();
+        shared_ptr<const PolygonMesh> pm = SceneGraphProcessor::getPolygonMesh(ifs);
+        for(Index iE=0;iE<pm->getNumberOfEdges();iE++)
+          if(pm->isBoundaryEdge(iE)) nBAfter++;
+      }
+    }
+    Parallel::setNumberOfThreads(nThreads0);
+    printf("    %7d %11d %11d %12.6f %15.6f %14ld/%ld\n",
+           n,nVBefore,nVAfter,t[0],t[1],(long)nBBefore,(long)nBAfter);
+  }
+  cout << "  }" << endl;
+  cout << "  TokenizerFile VRML file of a torus of 2 x n x n triangles {" << endl;
+  cout << "          n   file(MB)     tokens     get()(s)  getView()(s)  LoaderWrl(s)" << endl;
+  string wrlFile = (filesystem::temp_directory_path()/"dgpTest2c.wrl").string();
+  for(int n=250;n<=1000;n*=2) {
+    vector<float> coord;
+    torusGrid(n,nV,coordIndex);
+    torusCoord(n,coord);
+    {
+      SceneGraph wrl;
+      Shape* shape = new Shape();
+      IndexedFaceSet* ifs = new IndexedFaceSet();
+      shape->setGeometry(ifs);
+      wrl.addChild(shape);
+      ifs->editCoord() = coord;
+      ifs->editCoordIndex() = coordIndex;
+      SaverWrl saver;
+      saver.save(wrlFile.c_str(),wrl);
+    }
+    double mb = (double)filesystem::file_size(wrlFile)/(1024.0*1024.0);
+    long   nTokens = 0;
+    double t[3];
+    for(int k=0;k<2;k++) {
+      FILE* fp = fopen(wrlFile.c_str(),"r");
+      TokenizerFile tkn(fp);
+      string_view   view;
+      nTokens = 0;
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      if(k==0)
+        while(tkn.get()) nTokens++;
+      else
+        while(tkn.getView(view)) nTokens++;
+      t[k] = secondsSince(t0);
+      fclose(fp);
+    }
+    {
+      SceneGraph wrl;
+      LoaderWrl loader;
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      loader.load(wrlFile.c_str(),wrl);
+      t[2] = secondsSince(t0);
+    }
+    printf("    %7d %10.2f %10ld %12.6f %13.6f %13.6f\n",
+           n,mb,nTokens,t[0],t[1],t[2]);
+  }
+  filesystem::remove(wrlFile);
+  cout << "  }" << endl;
+  cout << "  Tokenizer::parseFloat of n decimal tokens {" << endl;
+  cout << "            n   sscanf(s)  parseFloat(s)  same values" << endl;
+  for(int n=1000000;n<=4000000;n*=2) {
+    mt19937 generator(n);
+    uniform_real_distribution<double> distribution(-100.0,100.0);
+    vector<string> tokens(n);
+    char s[32];
+    for(int i=0;i<n;i++) {
+      snprintf(s,32,"%.*f",1+i%6,distribution(generator));
+      tokens[i] = s;
+    }
+    vector<float> f0(n),f1(n);
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for(int i=0;i<n;i++)
+      sscanf(tokens[i].c_str(),"%f",&f0[i]);
+    double t0s = secondsSince(t0);
+    t0 = chrono::steady_clock::now();
+    for(int i=0;i<n;i++)
+      Tokenizer::parseFloat(tokens[i],f1[i]);
+    double t1s = secondsSince(t0);
+    if(f0!=f1) nMismatches++;
+    printf("    %9d %11.6f %14.6f  %s\n",
+           n,t0s,t1s,tv(f0==f1));
+  }
+  cout << "  }" << endl;
+  cout << "  LoaderWrl bulk array parsing, torus of 2 x n x n triangles {" << endl;
+  cout << "          n   file(MB)   1 thread(s)  threads(s)  same arrays" << endl;
+  for(int n=250;n<=1000;n*=2) {
+    torusGrid(n,nV,coordIndex);
+    {
+      SceneGraph wrl;
+      torusSceneGraph(n,wrl);
+      SaverWrl saver;
+      saver.save(wrlFile.c_str(),wrl);
+    }
+    double mb = (double)filesystem::file_size(wrlFile)/(1024.0*1024.0);
+    Index  nThreads0 = Parallel::getNumberOfThreads();
+    double t[2];
+    vector<float> loadedCoord[2];
+    vector<int>   loadedCoordIndex[2];
+    for(int k=0;k<2;k++) {
+      SceneGraph wrl;
+      LoaderWrl loader;
+      Parallel::setNumberOfThreads((k==0)?1:nThreads0);
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      loader.load(wrlFile.c_str(),wrl);
+      t[k] = secondsSince(t0);
+      const IndexedFaceSet* ifs = firstIndexedFaceSet(wrl);
+      if(ifs==(IndexedFaceSet*)0) continue;
+      loadedCoord[k]      = ifs->getCoord();
+      loadedCoordIndex[k] = ifs->getCoordIndex();
+    }
+    Parallel::setNumberOfThreads(nThreads0);
+    bool same =
+      loadedCoord[0]==loadedCoord[1] &&
+      loadedCoordIndex[0]==loadedCoordIndex[1] &&
+      loadedCoordIndex[1]==coordIndex;
+    if(same==false) nMismatches++;
+    printf("    %7d %10.2f %13.6f %11.6f  %s\n",
+           n,mb,t[0],t[1],tv(same));
+  }
+  filesystem::remove(wrlFile);
+  cout << "  }" << endl;
+  cout << "} dgpTest2c benchmark" << endl;
+  return nMismatches;
+}
+
+//////////////////////////////////////////////////////////////////////
+// self tests; every check prints its result, and main() returns a
+// non-zero exit status if any of them fails
+
+static int _nChecks   = 0;
+static int _nFailures = 0;
+
+bool check(const string& name, const bool passed) {
+  _nChecks++;
+  if(passed==false) _nFailures++;
+  cout << "    " << ((passed)?"PASSED ":"FAILED ") << name << endl;
+  return passed;
+}
+
+// twins and faces of every corner, and the vertices of every edge
+bool sameHalfEdges(const HalfEdges& a, const HalfEdges& b) {
+  Index nC = a.getNumberOfCorners();
+  Index nE = a.getNumberOfEdges();
+  if(b.getNumberOfCorners()!=nC || b.getNumberOfEdges()!=nE) return false;
+  for(Index iC=0;iC<nC;iC++)
+    if(a.getTwin(iC)!=b.getTwin(iC) || a.getFace(iC)!=b.getFace(iC))
+      return false;
+  for(Index iE=0;iE<nE;iE++) {
+    Index jE = b.getEdge(a.getVertex0(iE),a.getVertex1(iE));
+    if(jE<0 || a.getNumberOfEdgeHalfEdges(iE)!=b.getNumberOfEdgeHalfEdges(jE))
+      return false;
+  }
+  return true;
+}
+
+// torusGrid() without every seventh face, so that the mesh has
+// boundary edges
+void torusWithHoles(const int n, int& nV, vector<int>& coordIndex) {
+  vector<int> torus;
+  torusGrid(n,nV,torus);
+  coordIndex.clear();
+  for(int i=0,iF=0;i<(int)torus.size();i++) {
+    if(iF%7!=0) coordIndex.push_back(torus[i]);
+    if(torus[i]<0) iF++;
+  }
+}
+
+// reverses the order of the corners of every k-th face
+void reverseFaces(vector<int>& coordIndex, const int k) {
+  for(int i0=0,i1=0,iF=0;i1<(int)coordIndex.size();i1++) {
+    if(coordIndex[i1]>=0) continue;
+    if(iF++%k==0) reverse(coordIndex.begin()+i0,coordIndex.begin()+i1);
+    i0 = i1+1;
+  }
+}
+
+// the corners are those of the vertex, and consecutive corners are in
+// faces which share an edge incident to the vertex; the first and
+// last corners too if the vertex is internal, and otherwise they are
+// in faces incident to boundary edges
+bool isOrderedOneRing
+(const PolygonMesh& mesh, const Index iV, const vector<Index>& corners) {
+  Index n = mesh.getNumberOfVertexCorners(iV);
+  if(static_cast<Index>(corners.size())!=n) return false;
+  vector<Index> sorted(corners);
+  sort(sorted.begin(),sorted.end());
+  for(Index j=0;j<n;j++)
+    if(sorted[j]!=mesh.getVertexCorner(iV,j)) return false;
+  if(n==0) return true;
+  // the two edges incident to the vertex in the face of the corner
+  auto edge = [&mesh,iV](const Index iC, const int k) {
+    return mesh.getEdge(iV,(k==0)?mesh.getDst(iC):mesh.getSrc(mesh.getPrev(iC)));
+  };
+  auto shareEdge = [&edge](const Index iC0, const Index iC1) {
+    for(int k0=0;k0<2;k0++)
+      for(int k1=0;k1<2;k1++)
+        if(edge(iC0,k0)==edge(iC1,k1)) return true;
+    return false;
+  };
+  auto onBoundary = [&mesh,&edge](const Index iC) {
+    return mesh.isBoundaryEdge(edge(iC,0)) || mesh.isBoundaryEdge(edge(iC,1));
+  };
+  for(Index j=0;j+1<n;j++)
+    if(shareEdge(corners[j],corners[j+1])==false) return false;
+  if(mesh.isBoundaryVertex(iV)==false)
+    return shareEdge(corners[n-1],corners[0]);
+  return onBoundary(corners[0]) && onBoundary(corners[n-1]);
+}
+
+// every twin is symmetric, and every edge of a closed manifold mesh
+// is regular
+bool isClosedManifold(const TriangleMesh& mesh) {
+  for(Index iC=0;iC<mesh.getNumberOfCorners();iC++) {
+    Index jC = mesh.getTwin(iC);
+    if(jC<0 || mesh.getTwin(jC)!=iC) return false;
+  }
+  for(Index iE=0;iE<mesh.getNumberOfEdges();iE++)
+    if(mesh.isRegularEdge(iE)==false) return false;
+  return true;
+}
+
+void triangleCoordIndex(const TriangleMesh& mesh, vector<int>& coordIndex) {
+  const vector<Index>& triangles = mesh.getTriangles();
+  coordIndex.clear();
+  for(size_t i=0;i<triangles.size();i+=3) {
+    for(size_t j=0;j<3;j++)
+      coordIndex.push_back(static_cast<int>(triangles[i+j]));
+    coordIndex.push_back(-1);
+  }
+}
+
+// serial versions of the CsrGraph algorithms
+
+void serialBreadthFirstLevels
+(const CsrGraph& graph, const vector<Index>& sources, vector<Index>& level) {
+  const vector<Index>& firstArc = graph.getFirstArc();
+  const vector<Index>& arcNode  = graph.getArcNode();
+  level.assign(graph.getNumberOfNodes(),-1);
+  queue<Index> q;
+  for(Index iN : sources) { level[iN] = 0; q.push(iN); }
+  while(q.empty()==false) {
+    Index iN = q.front(); q.pop();
+    for(Index iA=firstArc[iN];iA<firstArc[iN+1];iA++)
+      if(level[arcNode[iA]]<0) {
+        level[arcNode[iA]] = level[iN]+1;
+        q.push(arcNode[iA]);
+      }
+  }
+}
+
+Index serialConnectedComponents
+(const CsrGraph& graph, vector<Index>& component) {
+  const vector<Index>& firstArc = graph.getFirstArc();
+  const vector<Index>& arcNode  = graph.getArcNode();
+  Index nN = graph.getNumberOfNodes();
+  Partition partition(nN);
+  for(Index iN=0;iN<nN;iN++)
+    for(Index iA=firstArc[iN];iA<firstArc[iN+1];iA++)
+      partition.join(iN,arcNode[iA]);
+  // numbered in increasing order of their lowest node
+  vector<Index> rootComponent(nN,-1);
+  Index nComponents = 0;
+  component.resize(nN);
+  for(Index iN=0;iN<nN;iN++) {
+    Index iR = partition.find(iN);
+    if(rootComponent[iR]<0) rootComponent[iR] = nComponents++;
+    component[iN] = rootComponent[iR];
+  }
+  return nComponents;
+}
+
+double serialMinimumSpanningForest
+(const CsrGraph& graph, const vector<double>& edgeLength) {
+  const vector<Index>& firstArc = graph.getFirstArc();
+  const vector<Index>& arcNode  = graph.getArcNode();
+  const vector<Index>& arcEdge  = graph.getArcEdge();
+  Index nN = graph.getNumberOfNodes();
+  vector< pair<double,Index> > arcs;
+  for(Index iN=0;iN<nN;iN++)
+    for(Index iA=firstArc[iN];iA<firstArc[iN+1];iA++)
+      if(iN<arcNode[iA]) arcs.push_back(make_pair(edgeLength[arcEdge[iA]],iA));
+  sort(arcs.begin(),arcs.end());
+  vector<Index> arcSrc(arcNode.size());
+  for(Index iN=0;iN<nN;iN++)
+    for(Index iA=firstArc[iN];iA<firstArc[iN+1];iA++) arcSrc[iA] = iN;
+  Partition partition(nN);
+  double length = 0.0;
+  for(auto& arc : arcs) {
+    Index iA = arc.second;
+    if(partition.find(arcSrc[iA])==partition.find(arcNode[iA])) continue;
+    partition.join(arcSrc[iA],arcNode[iA]);
+    length += arc.first;
+  }
+  return length;
+}
+
+void serialShortestPaths
+(const CsrGraph& graph, const vector<double>& edgeLength,
+ const vector<Index>& sources, vector<double>& distance) {
+  const vector<Index>& firstArc = graph.getFirstArc();
+  const vector<Index>& arcNode  = graph.getArcNode();
+  const vector<Index>& arcEdge  = graph.getArcEdge();
+  distance.assign(graph.getNumberOfNodes(),HUGE_VAL);
+  priority_queue< pair<double,Index>, vector< pair<double,Index> >,
+                  greater< pair<double,Index> > > q;
+  for(Index iN : sources) { distance[iN] = 0.0; q.push(make_pair(0.0,iN)); }
+  while(q.empty()==false) {
+    double d  = q.top().first;
+    Index  iN = q.top().second;
+    q.pop();
+    if(d>distance[iN]) continue;
+    for(Index iA=firstArc[iN];iA<firstArc[iN+1];iA++) {
+      double dA = d+edgeLength[arcEdge[iA]];
+      if(dA<distance[arcNode[iA]]) {
+        distance[arcNode[iA]] = dA;
+        q.push(make_pair(dA,arcNode[iA]));
+      }
+    }
+  }
+}
+
+// the tokens of the text, as the Tokenizer found them when it read one
+// character at a time with getc()
+void getcTokens(const string& text, vector<string>& tokens) {
+  size_t pos = 0;
+  auto getc = [&text,&pos]() -> int {
+    return (pos<text.size())?static_cast<unsigned char>(text[pos++]):EOF;
+  };
+  auto isBlank = [](const int c) {
+    return (c==' ' || c=='\t' || c=='\n' || c==',' || c=='\015');
+  };
+  tokens.clear();
+  string tkn;
+  int c;
+  for(;;) {
+    do {
+      tkn.clear();
+      while((c=getc())!=EOF)
+        if(!isBlank(c)) { tkn.push_back(static_cast<char>(c)); break; }
+      while((c=getc())!=EOF && !isBlank(c))
+        tkn.push_back(static_cast<char>(c));
+      if(tkn.size()>0 && tkn[0]=='#') {
+        if(c!='\n') tkn.push_back(static_cast<char>(c));
+        while((c=getc())!=EOF && c!='\n')
+          tkn.push_back(static_cast<char>(c));
+      }
+    } while(tkn.size()>0 && tkn[0]=='#');
+    if(tkn.empty()) break;
+    tokens.push_back(tkn);
+  }
+}
+
+// loads a VRML file containing the given text as the coordIndex field
+bool loadCoordIndex(const string& text, vector<int>& coordIndex) {
+  string wrlFile = (filesystem::temp_directory_path()/"dgpTest2c-test.wrl").string();
+  FILE* fp = fopen(wrlFile.c_str(),"w");
+  if(fp==(FILE*)0) return false;
+  fprintf(fp,"#VRML V2.0 utf8\nShape { geometry IndexedFaceSet {\n");
+  fprintf(fp,"  coord Coordinate { point [ 0 0 0 1 0 0 0 1 0 ] }\n");
+  fprintf(fp,"  coordIndex %s\n} }\n",text.c_str());
+  fclose(fp);
+  SceneGraph wrl;
+  LoaderWrl loader;
+  bool success = loader.load(wrlFile.c_str(),wrl);
+  filesystem::remove(wrlFile);
+  IndexedFaceSet* ifs = firstIndexedFaceSet(wrl);
+  if(success==false || ifs==(IndexedFaceSet*)0) return false;
+  coordIndex = ifs->getCoordIndex();
+  return true;
+}
+
+int test() {
+  cout << "dgpTest2c test {" << endl;
+  int nV; vector<int> coordIndex;
+
+  cout << "  Edges index types {" << endl;
+  {
+    Edges::IndexType indexType0 = Edges::getIndexType();
+    // the two apex vertices of the double cone have valence 1000
+    doubleCone(1000,nV,coordIndex);
+    Edges::setIndexType(Edges::LINKED_LISTS);
+    PolygonMesh lists(nV,coordIndex);
+    Edges::setIndexType(Edges::HASH_TABLE);
+    PolygonMesh table(nV,coordIndex);
+    Edges::setIndexType(indexType0);
+    check("HASH_TABLE == LINKED_LISTS, double cone",sameHalfEdges(lists,table));
+    bool found = true;
+    for(Index iE=0;iE<table.getNumberOfEdges();iE++)
+      if(table.getEdge(table.getVertex1(iE),table.getVertex0(iE))!=iE)
+        found = false;
+    check("getEdge(iV1,iV0) finds every edge",found);
+    check("getEdge() of a missing edge returns -1",
+          table.getEdge(0,1)<0 && table.getEdge(2,2)<0 && table.getEdge(0,nV)<0);
+  }
+  cout << "  }" << endl;
+
+  cout << "  HalfEdges build methods {" << endl;
+  {
+    HalfEdges::BuildMethod buildMethod0 = HalfEdges::getBuildMethod();
+    // the double cone has edges of high valence, and the torus with
+    // holes has boundary edges
+    for(int k=0;k<2;k++) {
+      if(k==0) doubleCone(100,nV,coordIndex); else torusWithHoles(32,nV,coordIndex);
+      HalfEdges::setBuildMethod(HalfEdges::INCREMENTAL);
+      HalfEdges incremental(nV,coordIndex);
+      HalfEdges::setBuildMethod(HalfEdges::SORT);
+      HalfEdges sorted(nV,coordIndex);
+      check((k==0)?"SORT == INCREMENTAL, double cone":"SORT == INCREMENTAL, torus with holes",
+            sameHalfEdges(incremental,sorted));
+    }
+    // the edges are numbered in the same order by any number of threads
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    Parallel::setNumberOfThreads(1);
+    HalfEdges serial(nV,coordIndex);
+    Parallel::setNumberOfThreads(4);
+    HalfEdges parallel(nV,coordIndex);
+    Parallel::setNumberOfThreads(nThreads0);
+    bool same = sameHalfEdges(serial,parallel);
+    for(Index iE=0;same && iE<serial.getNumberOfEdges();iE++)
+      same = (serial.getVertex0(iE)==parallel.getVertex0(iE) &&
+              serial.getVertex1(iE)==parallel.getVertex1(iE));
+    check("SORT with 4 threads == 1 thread",same);
+    HalfEdges::setBuildMethod(buildMethod0);
+  }
+  cout << "  }" << endl;
+
+  cout << "  TriangleMesh {" << endl;
+  {
+    // corner 3*iF+j of the TriangleMesh is corner 4*iF+j of the
+    // PolygonMesh
+    torusWithHoles(32,nV,coordIndex);
+    TriangleMesh tMesh(nV,coordIndex);
+    PolygonMesh  pMesh(nV,coordIndex);
+    auto corner = [](const Index iC) -> Index {
+      return (iC<0)?-1:3*(iC/4)+iC%4;
+    };
+    bool same =
+      tMesh.getNumberOfCorners()==3*pMesh.getNumberOfFaces() &&
+      tMesh.getNumberOfEdges()==pMesh.getNumberOfEdges();
+    for(Index iC=0;same && iC<pMesh.getNumberOfCorners();iC++) {
+      if(coordIndex[iC]<0) continue;
+      Index jC = corner(iC);
+      same = (tMesh.getSrc(jC)==pMesh.getSrc(iC) &&
+              tMesh.getDst(jC)==pMesh.getDst(iC) &&
+              tMesh.getFace(jC)==pMesh.getFace(iC) &&
+              tMesh.getNext(jC)==corner(pMesh.getNext(iC)) &&
+              tMesh.getTwin(jC)==corner(pMesh.getTwin(iC)) &&
+              tMesh.getNext(tMesh.getPrev(jC))==jC);
+    }
+    check("TriangleMesh == PolygonMesh half edges, torus with holes",same);
+    bool unchecked = true;
+    for(Index jC=0;jC<tMesh.getNumberOfCorners();jC++)
+      if(tMesh.faceUnchecked(jC)!=tMesh.getFace(jC) ||
+         tMesh.nextUnchecked(jC)!=tMesh.getNext(jC) ||
+         tMesh.prevUnchecked(jC)!=tMesh.getPrev(jC) ||
+         tMesh.twinUnchecked(jC)!=tMesh.getTwin(jC))
+        unchecked = false;
+    check("unchecked TriangleMesh accessors == checked ones",unchecked);
+    check("getNext() of an out of range corner == -1",
+          tMesh.getNext(-1)==-1 && tMesh.getNext(tMesh.getNumberOfCorners())==-1);
+    same = (tMesh.isRegular()==pMesh.isRegular() &&
+            tMesh.hasBoundary()==pMesh.hasBoundary());
+    for(int iV=0;same && iV<nV;iV++)
+      same = (tMesh.isBoundaryVertex(iV)==pMesh.isBoundaryVertex(iV) &&
+              tMesh.isSingularVertex(iV)==pMesh.isSingularVertex(iV));
+    check("TriangleMesh == PolygonMesh vertex classification",same);
+  }
+  cout << "  }" << endl;
+
+  cout << "  HalfEdges next and prev {" << endl;
+  {
+    // faces of 3, 4 and 5 corners
+    vector<int> polygons = { 0,1,2,3,4,-1, 0,4,5,6,-1, 6,5,7,-1 };
+    HalfEdges halfEdges(8,polygons);
+    bool inverse = true;
+    for(Index iC=0;iC<halfEdges.getNumberOfCorners();iC++) {
+      if(polygons[iC]<0) continue;
+      Index iCprev = halfEdges.getPrev(iC);
+      if(halfEdges.getNext(iCprev)!=iC || halfEdges.getPrev(halfEdges.getNext(iC))!=iC ||
+         halfEdges.getFace(iCprev)!=halfEdges.getFace(iC))
+        inverse = false;
+    }
+    check("getPrev() is the inverse of getNext()",inverse);
+  }
+  cout << "  }" << endl;
+
+  cout << "  HalfEdges layouts {" << endl;
+  {
+    HalfEdges::Layout layout0 = HalfEdges::getLayout();
+    torusQuads(32,nV,coordIndex);
+    vector<int> polygons = { 0,1,2,3,4,-1, 0,4,5,6,-1, 6,5,7,-1 };
+    for(int k=0;k<2;k++) {
+      const vector<int>& faces = (k==0)?coordIndex:polygons;
+      int nVk = (k==0)?nV:8;
+      HalfEdges::setLayout(HalfEdges::COMPACT);
+      HalfEdges compact(nVk,faces);
+      HalfEdges::setLayout(HalfEdges::FAST);
+      HalfEdges fast(nVk,faces);
+      bool same =
+        compact.getInstanceLayout()==HalfEdges::COMPACT &&
+        fast.getInstanceLayout()==HalfEdges::FAST &&
+        sameHalfEdges(compact,fast);
+      Index iF = 0;
+      for(Index iC=0;same && iC<compact.getNumberOfCorners();iC++) {
+        same = (fast.getNext(iC)==compact.getNext(iC) &&
+                fast.getPrev(iC)==compact.getPrev(iC));
+        if(same && faces[iC]>=0 && (iC==0 || faces[iC-1]<0))
+          same = (fast.getFaceFirstCorner(iF++)==iC);
+      }
+      check((k==0)?"FAST == COMPACT, torus of quads":"FAST == COMPACT, faces of 3 to 5 corners",
+            same);
+    }
+    HalfEdges::setLayout(layout0);
+  }
+  cout << "  }" << endl;
+
+  cout << "  PolygonMesh one-rings {" << endl;
+  {
+    // some faces of the third mesh are reversed, so that the rings
+    // also cross inconsistently oriented edges
+    const char* name[3] = {
+      "closed torus rings are ordered",
+      "torus with holes rings are ordered, except at singular vertices",
+      "rings are ordered across reversed faces"
+    };
+    vector<Index> corners;
+    for(int k=0;k<3;k++) {
+      if(k==1) torusWithHoles(16,nV,coordIndex); else torusGrid(16,nV,coordIndex);
+      if(k==2) reverseFaces(coordIndex,5);
+      PolygonMesh mesh(nV,coordIndex);
+      bool ordered = true;
+      for(int iV=0;ordered && iV<nV;iV++) {
+        bool isOrdered = mesh.getVertexOneRing(iV,corners);
+        ordered = (isOrdered!=mesh.isSingularVertex(iV) &&
+                   (isOrdered==false || isOrderedOneRing(mesh,iV,corners)));
+      }
+      check(name[k],ordered);
+    }
+  }
+  cout << "  }" << endl;
+
+  cout << "  ConcurrentPartition {" << endl;
+  {
+    // random joins, applied from several threads to a
+    // ConcurrentPartition, and serially to a Partition
+    int nElements = 100000;
+    int nJoins    = 90000;
+    mt19937 generator(2025);
+    uniform_int_distribution<int> distribution(0,nElements-1);
+    vector<int> pairs(2*nJoins);
+    for(int k=0;k<2*nJoins;k++) pairs[k] = distribution(generator);
+    Partition serial(nElements);
+    for(int k=0;k<nJoins;k++) serial.join(pairs[2*k],pairs[2*k+1]);
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    Parallel::setNumberOfThreads(4);
+    ConcurrentPartition concurrent(nElements);
+    Parallel::forRanges(nJoins,[&](Index /*iR*/, Index k0, Index k1) {
+      for(Index k=k0;k<k1;k++) concurrent.join(pairs[2*k],pairs[2*k+1]);
+    },1000);
+    Parallel::setNumberOfThreads(nThreads0);
+    // the ID of each part is its smallest element
+    vector<int> smallest(nElements,nElements);
+    for(int i=0;i<nElements;i++) {
+      int iR = serial.find(i);
+      if(i<smallest[iR]) smallest[iR] = i;
+    }
+    bool same = (concurrent.getNumberOfParts()==serial.getNumberOfParts());
+    for(int i=0;same && i<nElements;i++)
+      same = (concurrent.find(i)==concurrent.find(smallest[serial.find(i)]));
+    check("joins from 4 threads == serial Partition",same);
+    bool smallestId = true;
+    for(int i=0;smallestId && i<nElements;i++)
+      smallestId = (concurrent.find(i)==smallest[serial.find(i)]);
+    check("the ID of each part is its smallest element",smallestId);
+  }
+  {
+    // four tori which share their first eight vertices, so that each
+    // of those vertices has four parts
+    int n = 64, nVTorus;
+    vector<int> torusIndex;
+    torusGrid(n,nVTorus,torusIndex);
+    coordIndex.clear();
+    for(int j=0;j<4;j++)
+      for(size_t i=0;i<torusIndex.size();i++) {
+        int iV = torusIndex[i];
+        coordIndex.push_back((iV<8)?iV:iV+j*nVTorus);
+      }
+    nV = 4*nVTorus;
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    Parallel::setNumberOfThreads(1);
+    PolygonMesh serial(nV,coordIndex);
+    serial.isRegular();
+    Parallel::setNumberOfThreads(4);
+    PolygonMesh parallel(nV,coordIndex);
+    parallel.isRegular();
+    Parallel::setNumberOfThreads(nThreads0);
+    bool same = true;
+    int nSingular = 0;
+    for(Index iV=0;iV<nV;iV++) {
+      if(parallel.isSingularVertex(iV)!=serial.isSingularVertex(iV)) same = false;
+      if(parallel.isSingularVertex(iV)) nSingular++;
+    }
+    check("vertex parts counted from 4 threads == counted serially",
+          same && nSingular==8);
+  }
+  cout << "  }" << endl;
+
+  cout << "  TriangleMesh local edits {" << endl;
+  {
+    int n = 32;
+    torusGrid(n,nV,coordIndex);
+    TriangleMesh tMesh(nV,coordIndex);
+    Index nE0 = tMesh.getNumberOfEdges();
+    Index nF0 = tMesh.getNumberOfFaces();
+    int nFlips = 0;
+    for(Index iE=0;iE<nE0;iE+=7)
+      if(tMesh.flipEdge(iE)>=0) nFlips++;
+    check("flips keep the face and edge counts",
+          nFlips>0 && tMesh.getNumberOfFaces()==nF0 && tMesh.getNumberOfEdges()==nE0);
+    check("flips keep the mesh closed and manifold",isClosedManifold(tMesh));
+    int nCollapses = 0;
+    for(Index iE=0;iE<tMesh.getNumberOfEdges();iE+=53)
+      if(tMesh.collapseEdge(iE)>=0) nCollapses++;
+    tMesh.compact();
+    check("each collapse removes two faces and three edges",
+          nCollapses>0 &&
+          tMesh.getNumberOfFaces()==nF0-2*nCollapses &&
+          tMesh.getNumberOfEdges()==nE0-3*nCollapses);
+    check("collapses keep the mesh closed and manifold",isClosedManifold(tMesh));
+    vector<int> editedCoordIndex;
+    triangleCoordIndex(tMesh,editedCoordIndex);
+    TriangleMesh rebuilt(tMesh.getNumberOfVertices(),editedCoordIndex);
+    check("edited mesh == mesh rebuilt from its triangles",
+          rebuilt.getNumberOfEdges()==tMesh.getNumberOfEdges() &&
+          isClosedManifold(rebuilt));
+  }
+  cout << "  }" << endl;
+
+  cout << "  PolygonMesh topology cache {" << endl;
+  {
+    string cacheDirectory0 = PolygonMesh::getCacheDirectory();
+    torusWithHoles(32,nV,coordIndex);
+    PolygonMesh::setCacheDirectory("");
+    PolygonMesh reference(nV,coordIndex);
+    PolygonMesh::setCacheDirectory(filesystem::temp_directory_path().string());
+    string filename = PolygonMesh::getCacheFilename(nV,coordIndex);
+    remove(filename.c_str());
+    PolygonMesh cold(nV,coordIndex);
+    PolygonMesh warm(nV,coordIndex);
+    bool sameVertices = true;
+    for(Index iV=0;iV<nV;iV++)
+      if(warm.isBoundaryVertex(iV)!=reference.isBoundaryVertex(iV) ||
+         warm.isSingularVertex(iV)!=reference.isSingularVertex(iV))
+        sameVertices = false;
+    check("cold cache computes, warm cache reads the file",
+          cold.isFromCache()==false && warm.isFromCache());
+    check("mesh read from the cache == computed mesh",
+          sameHalfEdges(reference,warm) && sameVertices);
+    HalfEdges::Layout layout0 = HalfEdges::getLayout();
+    HalfEdges::setLayout((layout0==HalfEdges::FAST)?HalfEdges::COMPACT:HalfEdges::FAST);
+    PolygonMesh otherLayout(nV,coordIndex);
+    HalfEdges::setLayout(layout0);
+    check("cache written with another layout is not read",
+          otherLayout.isFromCache()==false);
+    // one flipped byte in the arrays, which keeps their sizes
+    remove(filename.c_str());
+    PolygonMesh rewritten(nV,coordIndex);
+    FILE* fp = fopen(filename.c_str(),"r+b");
+    if(fp!=(FILE*)0) {
+      fseek(fp,0,SEEK_END);
+      long offset = ftell(fp)/2;
+      fseek(fp,offset,SEEK_SET);
+      int c = fgetc(fp);
+      fseek(fp,offset,SEEK_SET);
+      fputc(c^0x01,fp);
+      fclose(fp);
+    }
+    PolygonMesh corrupted(nV,coordIndex);
+    check("corrupted cache file is not read",
+          rewritten.isFromCache()==false && corrupted.isFromCache()==false &&
+          sameHalfEdges(reference,corrupted));
+    remove(filename.c_str());
+    PolygonMesh::setCacheDirectory(cacheDirectory0);
+  }
+  cout << "  }" << endl;
+
+  cout << "  PolygonMesh vertex classification on demand {" << endl;
+  {
+    // the memory usage grows when each classification is built
+    torusWithHoles(32,nV,coordIndex);
+    PolygonMesh eager(nV,coordIndex);
+    eager.isBoundaryVertex(0);
+    eager.isRegular();
+    PolygonMesh lazy(nV,coordIndex);
+    size_t memory0 = lazy.getMemoryUsage();
+    Index nBoundaryEdges = 0;
+    for(Index iE=0;iE<lazy.getNumberOfEdges();iE++)
+      if(lazy.isBoundaryEdge(iE)) nBoundaryEdges++;
+    bool hasBoundary = lazy.hasBoundary();
+    size_t memory1 = lazy.getMemoryUsage();
+    lazy.isInternalVertex(0);
+    size_t memory2 = lazy.getMemoryUsage();
+    bool isRegular = lazy.isRegular();
+    size_t memory3 = lazy.getMemoryUsage();
+    check("edge classification does not classify the vertices",
+          hasBoundary && nBoundaryEdges>0 && memory1==memory0);
+    check("isInternalVertex() builds the boundary vertices",memory2>memory1);
+    check("isRegular() builds the vertex parts",memory3>memory2);
+    bool same = (isRegular==eager.isRegular());
+    for(Index iV=0;same && iV<nV;iV++)
+      same = (lazy.isBoundaryVertex(iV)==eager.isBoundaryVertex(iV) &&
+              lazy.isSingularVertex(iV)==eager.isSingularVertex(iV));
+    check("on demand classification == eager classification",same);
+    // the vertex corners, components, orientation and boundary loops
+    // are counted as they are built
+    lazy.getNumberOfVertexCorners(0);
+    size_t memory4 = lazy.getMemoryUsage();
+    lazy.getNumberOfComponents();
+    size_t memory5 = lazy.getMemoryUsage();
+    lazy.isReversedFace(0);
+    size_t memory6 = lazy.getMemoryUsage();
+    lazy.getNumberOfBoundaryLoops();
+    size_t memory7 = lazy.getMemoryUsage();
+    check("getMemoryUsage() counts the vertex corners",memory4>memory3);
+    check("getMemoryUsage() counts the components",memory5>memory4);
+    check("getMemoryUsage() counts the orientation",memory6>memory5);
+    check("getMemoryUsage() counts the boundary loops",memory7>memory6);
+    Index nFaces = 0;
+    for(size_t i=0;i<coordIndex.size();i++)
+      if(coordIndex[i]<0) nFaces++;
+    check("cached face count",
+          lazy.getNumberOfFaces()==nFaces && lazy.getNumberOfFaces()==nFaces);
+  }
+  cout << "  }" << endl;
+
+  cout << "  PolygonMesh components and orientation {" << endl;
+  {
+    // a torus with some faces reversed, a Moebius strip of m quads,
+    // and a consistently oriented torus, in this order
+    int n = 8, m = 8;
+    torusGrid(n,nV,coordIndex);
+    reverseFaces(coordIndex,3);
+    Index nF0 = 2*n*n;
+    for(int i=0;i<m;i++) {
+      // the last quad joins the top of the strip to the bottom
+      int iV0 = nV+2*i, iV1 = (i<m-1)?iV0+2:nV+1, iV2 = (i<m-1)?iV0+3:nV, iV3 = iV0+1;
+      coordIndex.insert(coordIndex.end(),{ iV0,iV1,iV2,iV3,-1 });
+    }
+    vector<int> torus;
+    int nVt;
+    torusGrid(n,nVt,torus);
+    for(size_t i=0;i<torus.size();i++)
+      coordIndex.push_back((torus[i]<0)?-1:torus[i]+nV+2*m);
+    nV += 2*m+nVt;
+    PolygonMesh mesh(nV,coordIndex);
+    Index nF = mesh.getNumberOfFaces();
+    check("three components, numbered by their lowest face",
+          mesh.getNumberOfComponents()==3 &&
+          mesh.getFaceComponent(0)==0 && mesh.getFaceComponent(nF0-1)==0 &&
+          mesh.getFaceComponent(nF0)==1 && mesh.getFaceComponent(nF0+m-1)==1 &&
+          mesh.getFaceComponent(nF0+m)==2 && mesh.getFaceComponent(nF-1)==2 &&
+          mesh.getFaceComponent(nF)==-1);
+    check("the Moebius strip is not orientable, and the tori are",
+          mesh.isOrientableComponent(0) && mesh.isOrientableComponent(1)==false &&
+          mesh.isOrientableComponent(2));
+    bool reversed = true;
+    for(Index iF=nF0;iF<nF;iF++)
+      if(mesh.isReversedFace(iF)) reversed = false;
+    check("faces of the strip and of the oriented torus are not reversed",reversed);
+    vector<int> oriented;
+    Index nReversed = mesh.getOrientedCoordIndex(oriented);
+    PolygonMesh orientedMesh(nV,oriented);
+    bool consistent = true;
+    for(Index iE=0;iE<orientedMesh.getNumberOfEdges();iE++)
+      if(orientedMesh.getFaceComponent(orientedMesh.getEdgeFace(iE,0))!=1 &&
+         orientedMesh.isConsistentlyOrientedEdge(iE)==false)
+        consistent = false;
+    check("oriented coordIndex makes the orientable components consistent",
+          nReversed>0 && consistent);
+  }
+  cout << "  }" << endl;
+
+  cout << "  PolygonMesh boundary loops {" << endl;
+  {
+    gridWithHoles(32,nV,coordIndex);
+    PolygonMesh grid(nV,coordIndex);
+    // 64 holes and the outer boundary
+    check("grid with holes has 65 loops",grid.getNumberOfBoundaryLoops()==65);
+    Index nBoundaryEdges = 0, nLoopEdges = 0;
+    for(Index iE=0;iE<grid.getNumberOfEdges();iE++)
+      if(grid.isBoundaryEdge(iE)) nBoundaryEdges++;
+    bool linked = true;
+    for(Index iL=0;iL<grid.getNumberOfBoundaryLoops();iL++) {
+      Index n = grid.getBoundaryLoopSize(iL);
+      for(Index j=0;j<n;j++)
+        if(grid.getNextBoundaryHalfEdge(grid.getBoundaryLoopCorner(iL,j))!=
+           grid.getBoundaryLoopCorner(iL,(j+1)%n))
+          linked = false;
+      nLoopEdges += n;
+    }
+    check("every boundary edge is in one closed loop",
+          linked && nLoopEdges==nBoundaryEdges);
+    // three triangles sharing the singular edge (0,1): one open chain
+    // of six boundary edges, from vertex 0 to vertex 1
+    vector<int> fan = { 0,1,2,-1, 1,0,3,-1, 0,1,4,-1 };
+    PolygonMesh singular(5,fan);
+    check("open chain at a singular edge is not split",
+          singular.getNumberOfBoundaryLoops()==1 &&
+          singular.getBoundaryLoopSize(0)==6);
+  }
+  cout << "  }" << endl;
+
+  cout << "  HalfEdges singular edges {" << endl;
+  {
+    // three triangles sharing the edge (0,1), with the half edges 0,
+    // 4 and 8
+    HalfEdges::BuildMethod buildMethod0 = HalfEdges::getBuildMethod();
+    vector<int> fan = { 0,1,2,-1, 1,0,3,-1, 0,1,4,-1 };
+    for(int k=0;k<2;k++) {
+      HalfEdges::setBuildMethod((k==0)?HalfEdges::INCREMENTAL:HalfEdges::SORT);
+      HalfEdges halfEdges(5,fan);
+      Index iE = halfEdges.getEdge(0,1);
+      vector<Index> edgeCorners;
+      for(Index j=0;j<halfEdges.getNumberOfEdgeHalfEdges(iE);j++)
+        edgeCorners.push_back(halfEdges.getEdgeHalfEdge(iE,j));
+      sort(edgeCorners.begin(),edgeCorners.end());
+      check((k==0)?"INCREMENTAL lists the three half edges of a singular edge":
+                   "SORT lists the three half edges of a singular edge",
+            edgeCorners==vector<Index>({ 0,4,8 }));
+    }
+    HalfEdges::setBuildMethod(buildMethod0);
+  }
+  cout << "  }" << endl;
+
+  cout << "  CsrGraph dual graph {" << endl;
+  {
+    vector<int> fan = { 0,1,2,-1, 1,0,3,-1, 0,1,4,-1 };
+    PolygonMesh singular(5,fan);
+    CsrGraph dual;
+    dual.buildDualGraph(singular);
+    Index iE01 = singular.getEdge(0,1);
+    bool complete = (dual.getNumberOfNodes()==3 && dual.getNumberOfArcs()==6);
+    for(Index iN=0;complete && iN<3;iN++)
+      complete = (dual.getNumberOfNeighbors(iN)==2 &&
+                  dual.getNeighbor(iN,0)==((iN==0)?1:0) &&
+                  dual.getNeighbor(iN,1)==((iN==2)?1:2) &&
+                  dual.getArcEdge(iN,0)==iE01 && dual.getArcEdge(iN,1)==iE01);
+    check("the faces of a singular edge are connected in pairs",complete);
+    torusGrid(32,nV,coordIndex);
+    PolygonMesh torus(nV,coordIndex);
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    Parallel::setNumberOfThreads(1);
+    CsrGraph serial;
+    serial.buildDualGraph(torus);
+    Parallel::setNumberOfThreads(4);
+    dual.buildDualGraph(torus);
+    Parallel::setNumberOfThreads(nThreads0);
+    bool threeNeighbors = (dual.getNumberOfNodes()==torus.getNumberOfFaces());
+    for(Index iN=0;threeNeighbors && iN<dual.getNumberOfNodes();iN++)
+      threeNeighbors = (dual.getNumberOfNeighbors(iN)==3);
+    check("every face of the torus has three neighbors",threeNeighbors);
+    check("dual graph with 4 threads == 1 thread",
+          dual.getFirstArc()==serial.getFirstArc() &&
+          dual.getArcNode()==serial.getArcNode() &&
+          dual.getArcEdge()==serial.getArcEdge());
+  }
+  cout << "  }" << endl;
+
+  cout << "  CsrGraph algorithms {" << endl;
+  {
+    // a random subgraph of the torus edges, with several components,
+    // and random edge lengths
+    torusGrid(64,nV,coordIndex);
+    PolygonMesh torus(nV,coordIndex);
+    mt19937 generator(2025);
+    uniform_real_distribution<double> distribution(0.0,1.0);
+    Graph graph(nV);
+    for(Index iE=0;iE<torus.getNumberOfEdges();iE++)
+      if(distribution(generator)<0.4)
+        graph.insertEdge(torus.getVertex0(iE),torus.getVertex1(iE));
+    vector<double> edgeLength(graph.getNumberOfEdges());
+    for(size_t iE=0;iE<edgeLength.size();iE++)
+      edgeLength[iE] = 0.5+distribution(generator);
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    Parallel::setNumberOfThreads(4);
+    CsrGraph csr;
+    csr.buildGraph(graph);
+    vector<Index> sources = { 0, nV/2 };
+
+    vector<Index> level,serialLevel;
+    Index nReached = csr.getBreadthFirstLevels(sources,level);
+    serialBreadthFirstLevels(csr,sources,serialLevel);
+    check("breadth first levels == serial search",
+          level==serialLevel &&
+          nReached==nV-count(serialLevel.begin(),serialLevel.end(),-1));
+
+    vector<Index> component,serialComponent;
+    Index nComponents = csr.getConnectedComponents(component);
+    Index nSerialComponents = serialConnectedComponents(csr,serialComponent);
+    check("connected components == serial Partition",
+          nComponents>1 && nComponents==nSerialComponents &&
+          component==serialComponent);
+
+    vector<Index> forestEdges;
+    double length = csr.getMinimumSpanningForest(edgeLength,forestEdges);
+    double serialLength = serialMinimumSpanningForest(csr,edgeLength);
+    bool sorted = true;
+    for(size_t k=1;k<forestEdges.size();k++)
+      if(edgeLength[forestEdges[k-1]]>edgeLength[forestEdges[k]]) sorted = false;
+    check("minimum spanning forest == serial Kruskal",
+          fabs(length-serialLength)<=1.0e-9*serialLength && sorted &&
+          static_cast<Index>(forestEdges.size())==nV-nComponents);
+
+    vector<double> distance,serialDistance;
+    vector<Index>  parent;
+    csr.getShortestPaths(edgeLength,sources,distance,parent);
+    serialShortestPaths(csr,edgeLength,sources,serialDistance);
+    bool same = true;
+    for(Index iN=0;same && iN<nV;iN++) {
+      if(serialDistance[iN]==HUGE_VAL) { same = (distance[iN]==HUGE_VAL); continue; }
+      same = (fabs(distance[iN]-serialDistance[iN])<=1.0e-9*(1.0+serialDistance[iN]));
+      // the parent is a neighbor on a shortest path
+      if(same && parent[iN]>=0) {
+        same = false;
+        for(Index j=0;j<csr.getNumberOfNeighbors(iN);j++)
+          if(csr.getNeighbor(iN,j)==parent[iN] &&
+             fabs(distance[parent[iN]]+edgeLength[csr.getArcEdge(iN,j)]-distance[iN])<=
+             1.0e-9*(1.0+distance[iN]))
+            same = true;
+      }
+    }
+    check("shortest paths == serial Dijkstra",same);
+    Parallel::setNumberOfThreads(nThreads0);
+  }
+  cout << "  }" << endl;
+
+  cout << "  ExternalHalfEdges {" << endl;
+  {
+    HalfEdges::BuildMethod buildMethod0 = HalfEdges::getBuildMethod();
+    size_t memoryBudget0 = ExternalHalfEdges::getMemoryBudget();
+    // a small budget, so that the sorts write several runs
+    ExternalHalfEdges::setMemoryBudget(static_cast<size_t>(64)<<10);
+    string tablePrefix = (filesystem::temp_directory_path()/"dgpTest2c-test").string();
+    string coordIndexFile = tablePrefix+".coordIndex";
+    gridWithHoles(64,nV,coordIndex);
+    HalfEdges::setBuildMethod(HalfEdges::SORT);
+    PolygonMesh inMemory(nV,coordIndex);
+    HalfEdges::setBuildMethod(buildMethod0);
+    Index nBoundaryEdges = 0;
+    for(Index iE=0;iE<inMemory.getNumberOfEdges();iE++)
+      if(inMemory.isBoundaryEdge(iE)) nBoundaryEdges++;
+    ExternalHalfEdges::writeCoordIndex(coordIndexFile,coordIndex);
+    {
+      ExternalHalfEdges outOfCore(coordIndexFile,tablePrefix);
+      bool same =
+        outOfCore.isValid() &&
+        outOfCore.getNumberOfCorners()==inMemory.getNumberOfCorners() &&
+        outOfCore.getNumberOfEdges()==inMemory.getNumberOfEdges() &&
+        outOfCore.getNumberOfBoundaryEdges()==nBoundaryEdges;
+      for(Index iC=0;same && iC<inMemory.getNumberOfCorners();iC++)
+        same = (outOfCore.getTwin(iC)==inMemory.getTwin(iC) &&
+                outOfCore.getFace(iC)==inMemory.getFace(iC));
+      for(Index iE=0;same && iE<inMemory.getNumberOfEdges();iE++)
+        same = (outOfCore.getVertex0(iE)==inMemory.getVertex0(iE) &&
+                outOfCore.getVertex1(iE)==inMemory.getVertex1(iE));
+      for(Index iV=0;same && iV<nV;iV++)
+        same = (outOfCore.isBoundaryVertex(iV)==inMemory.isBoundaryVertex(iV));
+      check("out of core == in memory SORT build",same);
+      check("out of core build used several runs",outOfCore.getNumberOfRuns()>1);
+    }
+    ExternalHalfEdges::removeTables(tablePrefix);
+    remove(coordIndexFile.c_str());
+    {
+      ExternalHalfEdges missing(coordIndexFile,tablePrefix);
+      check("missing coordIndex file is not valid, and leaves no tables",
+            missing.isValid()==false &&
+            filesystem::exists(tablePrefix+".twin")==false);
+    }
+    ExternalHalfEdges::setMemoryBudget(memoryBudget0);
+  }
+  cout << "  }" << endl;
+
+  cout << "  SceneGraphProcessor reordering {" << endl;
+  {
+    // the colors are bound per vertex, the normals per face, and the
+    // texture coordinates per corner; every value is computed from the
+    // coordinates of its vertices, and has to follow them
+    int n = 32;
+    SceneGraph wrl;
+    torusSceneGraph(n,wrl);
+    SceneGraphProcessor processor(wrl);
+    IndexedFaceSet* ifs = firstIndexedFaceSet(wrl);
+    ifs->editColor() = ifs->getCoord();
+    ifs->setNormalPerVertex(false);
+    {
+      const vector<float>& coord      = ifs->getCoord();
+      const vector<int>&   coordIndex = ifs->getCoordIndex();
+      vector<float>& normal        = ifs->editNormal();
+      vector<float>& texCoord      = ifs->editTexCoord();
+      vector<int>&   texCoordIndex = ifs->editTexCoordIndex();
+      float sum[3] = { 0.0f, 0.0f, 0.0f };
+      for(size_t i=0;i<coordIndex.size();i++) {
+        int iV = coordIndex[i];
+        texCoordIndex.push_back((iV<0)?-1:static_cast<int>(texCoord.size()/2));
+        if(iV<0) {
+          normal.insert(normal.end(),sum,sum+3);
+          sum[0] = sum[1] = sum[2] = 0.0f;
+          continue;
+        }
+        for(int j=0;j<3;j++) sum[j] += coord[3*iV+j];
+        texCoord.push_back(coord[3*iV]);
+        texCoord.push_back(coord[3*iV+1]);
+      }
+    }
+    // the faces, as sorted lists of vertex coordinates
+    auto faces = [ifs]() {
+      const vector<float>& coord      = ifs->getCoord();
+      const vector<int>&   coordIndex = ifs->getCoordIndex();
+      vector< vector<float> > faceCoord(1);
+      for(size_t i=0;i<coordIndex.size();i++) {
+        if(coordIndex[i]<0) { faceCoord.push_back(vector<float>()); continue; }
+        const float* x = &coord[3*coordIndex[i]];
+        faceCoord.back().insert(faceCoord.back().end(),x,x+3);
+      }
+      faceCoord.pop_back();
+      sort(faceCoord.begin(),faceCoord.end());
+      return faceCoord;
+    };
+    auto consistent = [ifs]() {
+      const vector<float>& coord         = ifs->getCoord();
+      const vector<int>&   coordIndex    = ifs->getCoordIndex();
+      const vector<float>& normal        = ifs->getNormal();
+      const vector<float>& color         = ifs->getColor();
+      const vector<float>& texCoord      = ifs->getTexCoord();
+      const vector<int>&   texCoordIndex = ifs->getTexCoordIndex();
+      if(color!=coord || texCoordIndex.size()!=coordIndex.size()) return false;
+      float sum[3] = { 0.0f, 0.0f, 0.0f };
+      size_t iF = 0;
+      for(size_t i=0;i<coordIndex.size();i++) {
+        int iV = coordIndex[i];
+        if(iV<0) {
+          for(int j=0;j<3;j++)
+            if(3*iF+j>=normal.size() || normal[3*iF+j]!=sum[j]) return false;
+          sum[0] = sum[1] = sum[2] = 0.0f;
+          iF++;
+          continue;
+        }
+        for(int j=0;j<3;j++) sum[j] += coord[3*iV+j];
+        if(texCoord[2*texCoordIndex[i]  ]!=coord[3*iV  ] ||
+           texCoord[2*texCoordIndex[i]+1]!=coord[3*iV+1]) return false;
+      }
+      return (3*iF==normal.size());
+    };
+    vector< vector<float> > faces0 = faces();
+    vector<int> coordIndex0 = ifs->getCoordIndex();
+    const char* name[3] = { "Morton", "Hilbert", "Rcm" };
+    for(int k=0;k<3;k++) {
+      if(k==0) processor.reorderVerticesMorton();
+      if(k==1) processor.reorderVerticesHilbert();
+      if(k==2) processor.reorderVerticesRcm();
+      check(string(name[k])+" order moves the attributes with the vertices",
+            consistent() && faces()==faces0);
+    }
+    processor.reorderFaces();
+    const vector<int>& coordIndex = ifs->getCoordIndex();
+    bool sorted = true;
+    for(size_t i=0,iVmin0=0;i<coordIndex.size();i++) {
+      int iVmin = coordIndex[i];
+      for(;coordIndex[i]>=0;i++) iVmin = min(iVmin,coordIndex[i]);
+      if(static_cast<size_t>(iVmin)<iVmin0) sorted = false;
+      iVmin0 = iVmin;
+    }
+    check("face order moves the attributes with the faces",
+          consistent() && faces()==faces0 && sorted && coordIndex!=coordIndex0);
+  }
+  cout << "  }" << endl;
+
+  cout << "  SceneGraphProcessor compaction {" << endl;
+  {
+    // the face 1 1 2 is left with two corners, the face 0 9 4 has an
+    // out of range vertex, the repeated corner of the face 2 3 3 4 is
+    // removed, and the last face is not terminated; vertex 1 is not
+    // referenced by the remaining faces
+    SceneGraph wrl;
+    Shape* shape = new Shape();
+    IndexedFaceSet* ifs = new IndexedFaceSet();
+    shape->setGeometry(ifs);
+    wrl.addChild(shape);
+    vector<int>& coordIndex = ifs->editCoordIndex();
+    coordIndex = { 0,2,3,-1, 1,1,2,-1, 2,3,3,4,-1, 0,9,4,-1, 0,2,5,-1, 3,4,5 };
+    vector<float>& coord = ifs->editCoord();
+    for(int iV=0;iV<6;iV++) coord.insert(coord.end(),{ (float)iV,0.0f,0.0f });
+    // normals per face, colors per corner, texture coordinates per vertex
+    ifs->setNormalPerVertex(false);
+    vector<float>& normal     = ifs->editNormal();
+    vector<float>& color      = ifs->editColor();
+    vector<int>&   colorIndex = ifs->editColorIndex();
+    vector<float>& texCoord   = ifs->editTexCoord();
+    for(int iF=0;iF<6;iF++) normal.insert(normal.end(),{ (float)iF,0.0f,1.0f });
+    for(int i=0;i<(int)coordIndex.size();i++) {
+      colorIndex.push_back((coordIndex[i]<0)?-1:i);
+      color.insert(color.end(),{ (float)i,0.0f,0.0f });
+    }
+    for(int iV=0;iV<6;iV++) texCoord.insert(texCoord.end(),{ (float)iV,0.0f });
+    SceneGraphProcessor processor(wrl);
+    processor.compact();
+    const vector<int>& compacted = ifs->getCoordIndex();
+    check("degenerate and out of range faces are removed",
+          compacted==vector<int>({ 0,1,2,-1, 1,2,3,-1, 0,1,4,-1, 2,3,4,-1 }));
+    vector<float> x,normalX,texCoordX;
+    for(size_t iV=0;iV<ifs->getCoord().size()/3;iV++)    x.push_back(ifs->getCoord()[3*iV]);
+    for(size_t iF=0;iF<ifs->getNormal().size()/3;iF++)   normalX.push_back(ifs->getNormal()[3*iF]);
+    for(size_t iV=0;iV<ifs->getTexCoord().size()/2;iV++) texCoordX.push_back(ifs->getTexCoord()[2*iV]);
+    check("unreferenced vertex is removed, with its texture coordinates",
+          x==vector<float>({ 0,2,3,4,5 }) && texCoordX==x);
+    check("normals per face follow the kept faces",
+          normalX==vector<float>({ 0,2,4,5 }));
+    check("colors per corner follow the kept corners",
+          ifs->getColorIndex()==vector<int>({ 0,1,2,-1, 8,10,11,-1, 17,18,19,-1, 21,22,23,-1 }));
+  }
+  cout << "  }" << endl;
+
+  cout << "  IndexedFaceSet face offsets {" << endl;
+  {
+    IndexedFaceSet ifs;
+    ifs.editCoordIndex() = { 0,1,2,-1, 0,2,3,4,-1, 4,3,5,-1 };
+    check("offsets of faces of 3 and 4 corners",
+          ifs.getFaceOffsets()==vector<Index>({ 0,4,9,13 }));
+    // moves the first face separator, without changing the size
+    ifs.editCoordIndex()[3] = 0;
+    ifs.editCoordIndex()[4] = -1;
+    check("offsets after an edit of the same size",
+          ifs.getFaceOffsets()==vector<Index>({ 0,5,9,13 }));
+    vector<int>& coordIndex = ifs.editCoordIndex();
+    coordIndex.insert(coordIndex.end(),{ 1,2,5,-1, 3,4 });
+    check("offsets after appending faces, ignoring an unterminated one",
+          ifs.getFaceOffsets()==vector<Index>({ 0,5,9,13,17 }) &&
+          ifs.getNumberOfFaces()==4);
+  }
+  cout << "  }" << endl;
+
+  cout << "  IndexedFaceSet change tracking {" << endl;
+  {
+    int n = 16;
+    SceneGraph wrl;
+    torusSceneGraph(n,wrl);
+    IndexedFaceSet* ifs = firstIndexedFaceSet(wrl);
+    shared_ptr<const PolygonMesh> mesh0 = SceneGraphProcessor::getPolygonMesh(*ifs);
+    uint64_t generation0 = ifs->getGeneration(IndexedFaceSet::ALL_ARRAYS_MASK);
+    vector<float> bbox0 = ifs->getBBoxCoord();
+    ifs->getCoord();
+    ifs->getCoordIndex();
+    check("const reads keep the generations and the cached mesh",
+          SceneGraphProcessor::getPolygonMesh(*ifs)==mesh0 &&
+          ifs->getGeneration(IndexedFaceSet::ALL_ARRAYS_MASK)==generation0);
+    // removes the last face
+    vector<int>& coordIndex = ifs->editCoordIndex();
+    coordIndex.resize(coordIndex.size()-4);
+    shared_ptr<const PolygonMesh> mesh1 = SceneGraphProcessor::getPolygonMesh(*ifs);
+    check("coordIndex edit rebuilds the mesh",
+          mesh1->getNumberOfFaces()==2*n*n-1 && mesh1->hasBoundary());
+    check("the old mesh outlives the edit",
+          mesh0!=mesh1 && mesh0->getNumberOfFaces()==2*n*n &&
+          mesh0->hasBoundary()==false);
+    vector<float>& coord = ifs->editCoord();
+    for(size_t i=0;i<coord.size();i++) coord[i] *= 2.0f;
+    const vector<float>& bbox1 = ifs->getBBoxCoord();
+    bool scaled = (bbox1.size()==6);
+    for(int j=0;scaled && j<6;j++) scaled = (bbox1[j]==2.0f*bbox0[j]);
+    check("coord edit recomputes the bounding box",scaled);
+    check("coord edit keeps the mesh",
+          SceneGraphProcessor::getPolygonMesh(*ifs)==mesh1);
+    typedef IndexedFaceSet::CacheValue<int> CachedInt;
+    ifs->setCacheSlot("test",IndexedFaceSet::NORMAL_MASK,make_shared<CachedInt>(7));
+    ifs->touch(IndexedFaceSet::COLOR_MASK);
+    shared_ptr<CachedInt> value = static_pointer_cast<CachedInt>(ifs->getCacheSlot("test"));
+    check("slot survives a change of another array",value && value->value==7);
+    ifs->editNormal().push_back(0.0f);
+    check("slot is invalid after a change of its input",
+          ifs->getCacheSlot("test")==nullptr && ifs->hasCacheSlot("test") &&
+          value->value==7);
+    // replacing the coordIndex array releases the node's reference, but
+    // not the one held by the cached mesh
+    {
+      IndexedFaceSet other;
+      other.editCoordIndex() = ifs->getCoordIndex();
+      other.editCoord()      = ifs->getCoord();
+      shared_ptr<const PolygonMesh> mesh2 = SceneGraphProcessor::getPolygonMesh(other);
+      other.setSharedCoordIndex(SharedArray<int>());
+      other.editCoord().clear();
+      check("the mesh outlives a replaced coordIndex",
+            mesh2->getNumberOfFaces()==2*n*n-1 &&
+            mesh2->getNumberOfEdges()==mesh1->getNumberOfEdges());
+    }
+    // the caches are filled under a lock; every thread must see the
+    // same, complete arrays
+    {
+      IndexedFaceSet other;
+      other.share(*ifs);
+      vector<const vector<Index>*> offsets(4);
+      vector<const vector<float>*> bboxes(4);
+      vector<thread> threads;
+      for(int i=0;i<4;i++)
+        threads.push_back(thread([&other,&offsets,&bboxes,i]() {
+          offsets[i] = &other.getFaceOffsets();
+          bboxes[i]  = &other.getBBoxCoord();
+        }));
+      for(size_t i=0;i<threads.size();i++) threads[i].join();
+      bool same = true;
+      for(int i=1;i<4;i++)
+        same = same && offsets[i]==offsets[0] && bboxes[i]==bboxes[0];
+      check("concurrent const queries share one cached copy",
+            same && *offsets[0]==ifs->getFaceOffsets() &&
+            *bboxes[0]==ifs->getBBoxCoord());
+    }
+  }
+  cout << "  }" << endl;
+
+  cout << "  IndexedFaceSet copy-on-write arrays {" << endl;
+  {
+    SceneGraph wrl;
+    torusSceneGraph(8,wrl);
+    IndexedFaceSet* ifs = firstIndexedFaceSet(wrl);
+    // torusSceneGraph() fills the arrays through editX() references,
+    // which the caller might still hold
+    IndexedFaceSet unsealed;
+    unsealed.share(*ifs);
+    check("share() copies the arrays edited since they were sealed",
+          unsealed.getCoord().data()!=ifs->getCoord().data() &&
+          unsealed.getCoord()==ifs->getCoord() &&
+          unsealed.getCoordIndex()==ifs->getCoordIndex());
+    ifs->seal();
+    IndexedFaceSet copy;
+    copy.share(*ifs);
+    check("share() copies no sealed array",
+          copy.getCoord().data()==ifs->getCoord().data() &&
+          copy.getCoordIndex().data()==ifs->getCoordIndex().data());
+    vector<float> coord0 = ifs->getCoord();
+    vector<float>& coord = copy.editCoord();
+    coord[0] += 1.0f;
+    check("a write to the copy detaches only the written array",
+          ifs->getCoord()==coord0 && copy.getCoord()[0]==coord0[0]+1.0f &&
+          copy.getCoordIndex().data()==ifs->getCoordIndex().data());
+    // the reference returned by editCoord() is still held
+    IndexedFaceSet other;
+    other.share(copy);
+    coord[1] += 1.0f;
+    check("a write through a reference held across share() stays in its node",
+          copy.getCoord()[1]==coord0[1]+1.0f && other.getCoord()[1]==coord0[1] &&
+          other.getCoordIndex().data()==ifs->getCoordIndex().data());
+    ifs->editCoordIndex().push_back(0);
+    check("a write to the original does not reach the copy",
+          copy.getCoordIndex().size()+1==ifs->getCoordIndex().size());
+  }
+  {
+    // the coord array of a loaded Ply is shared with its IndexedFaceSet
+    SceneGraph wrl;
+    torusSceneGraph(8,wrl);
+    string plyFile = (filesystem::temp_directory_path()/"dgpTest2c-test.ply").string();
+    SaverPly::save(plyFile.c_str(),*firstIndexedFaceSet(wrl));
+    SceneGraph loaded;
+    LoaderPly loader;
+    loader.load(plyFile.c_str(),loaded);
+    filesystem::remove(plyFile);
+    IndexedFaceSetPly* ifs = dynamic_cast<IndexedFaceSetPly*>(firstIndexedFaceSet(loaded));
+    Ply::Element::Property* coordP = (ifs!=(IndexedFaceSetPly*)0)?
+      ifs->getPly()->getElement("vertex")->getProperty("coord"):nullptr;
+    bool shared = (coordP!=nullptr &&
+                   coordP->readValue()==&ifs->getCoord() &&
+                   ifs->getPly()->getCoord()==&ifs->getCoord());
+    check("a loaded Ply shares its coord array with the IndexedFaceSet",shared);
+    if(shared) {
+      vector<float> coord0 = ifs->getCoord();
+      vector<float>* value = static_cast<vector<float>*>(coordP->getValue());
+      (*value)[0] += 1.0f;
+      check("a write through Property::getValue() does not reach the IndexedFaceSet",
+            ifs->getCoord()==coord0 && ifs->getPly()->getCoord()==value &&
+            (*value)[0]==coord0[0]+1.0f);
+    }
+  }
+  cout << "  }" << endl;
+
+  cout << "  LoaderStl binary files {" << endl;
+  {
+    int n = 16;
+    SceneGraph wrl;
+    torusSceneGraph(n,wrl);
+    SceneGraphProcessor processor(wrl);
+    processor.computeNormalPerFace();
+    string stlFile = (filesystem::temp_directory_path()/"dgpTest2c-test.stl").string();
+    SaverStl saver;
+    SaverStl::setFileType(SaverStl::FileType::BINARY);
+    saver.save(stlFile.c_str(),wrl);
+    SaverStl::setFileType(SaverStl::FileType::ASCII);
+    LoaderStl loader;
+    SceneGraph binary;
+    bool loaded = loader.load(stlFile.c_str(),binary);
+    IndexedFaceSet* ifs = firstIndexedFaceSet(binary);
+    check("binary file is loaded",
+          loaded && ifs!=(IndexedFaceSet*)0 &&
+          ifs->getNumberOfFaces()==2*n*n && ifs->getNumberOfVertices()==3*2*n*n);
+    // the size of the file still matches the number of triangles
+    FILE* fp = fopen(stlFile.c_str(),"r+b");
+    if(fp!=(FILE*)0) { fwrite("solid",1,5,fp); fclose(fp); }
+    SceneGraph solid;
+    loaded = loader.load(stlFile.c_str(),solid);
+    ifs = firstIndexedFaceSet(solid);
+    check("binary file starting with \"solid\" is loaded as binary",
+          loaded && ifs!=(IndexedFaceSet*)0 && ifs->getNumberOfFaces()==2*n*n);
+    saver.save(stlFile.c_str(),wrl);
+    SaverStl::setFileType(SaverStl::FileType::BINARY);
+    saver.save(stlFile.c_str(),wrl);
+    SaverStl::setFileType(SaverStl::FileType::ASCII);
+    filesystem::resize_file(stlFile,filesystem::file_size(stlFile)-25);
+    SceneGraph truncated;
+    loaded = loader.load(stlFile.c_str(),truncated);
+    check("truncated binary file is rejected",
+          loaded==false && firstIndexedFaceSet(truncated)==(IndexedFaceSet*)0);
+    filesystem::remove(stlFile);
+  }
+  cout << "  }" << endl;
+
+  cout << "  weldVertices and LoaderStl {" << endl;
+  {
+    int n = 32;
+    SceneGraph wrl;
+    torusSceneGraph(n,wrl);
+    SceneGraphProcessor processor(wrl);
+    processor.computeNormalPerFace();
+    string stlFile = (filesystem::temp_directory_path()/"dgpTest2c-test.stl").string();
+    SaverStl saver;
+    SaverStl::setFileType(SaverStl::FileType::BINARY);
+    saver.save(stlFile.c_str(),wrl);
+    SaverStl::setFileType(SaverStl::FileType::ASCII);
+    // the same file loaded with and without welding, which is set per
+    // loader instance
+    LoaderStl welding;
+    LoaderStl plain;
+    welding.setWeldVertices(true);
+    SceneGraph welded,soup;
+    welding.load(stlFile.c_str(),welded);
+    plain.load(stlFile.c_str(),soup);
+    filesystem::remove(stlFile);
+    IndexedFaceSet* ifsWelded = firstIndexedFaceSet(welded);
+    IndexedFaceSet* ifsSoup   = firstIndexedFaceSet(soup);
+    check("unwelded STL has three vertices per triangle",
+          ifsSoup!=(IndexedFaceSet*)0 &&
+          ifsSoup->getNumberOfVertices()==3*2*n*n);
+    bool closed = false;
+    if(ifsWelded!=(IndexedFaceSet*)0 && ifsWelded->getNumberOfVertices()==n*n) {
+      shared_ptr<const PolygonMesh> pm = SceneGraphProcessor::getPolygonMesh(*ifsWelded);
+      closed = (pm->hasBoundary()==false && pm->isRegular());
+    }
+    check("welded STL has one vertex per torus vertex, and no boundary",closed);
+    // with epsilon>0, vertices which round to the same grid point are
+    // merged, and the vertex of smallest index is kept
+    IndexedFaceSet ifs;
+    ifs.editCoord() = { 0.0f,0.0f,0.0f, 1.0f,0.0f,0.0f, 1.0e-5f,0.0f,0.0f, 1.0f,1.0f,0.0f };
+    ifs.editCoordIndex() = { 0,1,3,-1, 2,3,1,-1 };
+    SceneGraphProcessor::weldVertices(ifs,1.0e-3f);
+    check("epsilon weld merges nearby vertices",
+          ifs.getNumberOfVertices()==3 &&
+          ifs.getCoordIndex()==vector<int>({ 0,1,2,-1, 0,2,1,-1 }));
+    // NaN and infinite coordinates have no grid cell; they only weld
+    // to the same value, and not to the vertices at the clamped ends
+    // of the grid
+    const float nan = numeric_limits<float>::quiet_NaN();
+    const float inf = numeric_limits<float>::infinity();
+    ifs.editCoord() = { nan,0.0f,0.0f, 1.0f,0.0f,0.0f, nan,0.0f,0.0f,
+                        inf,0.0f,0.0f, 3.0e38f,0.0f,0.0f, 1.0f,1.0f,0.0f };
+    ifs.editCoordIndex() = { 0,1,5,-1, 2,5,1,-1, 3,4,5,-1 };
+    SceneGraphProcessor::weldVertices(ifs,1.0e-3f);
+    check("epsilon weld of NaN and infinite coordinates",
+          ifs.getNumberOfVertices()==5 &&
+          ifs.getCoordIndex()==vector<int>({ 0,1,4,-1, 0,4,1,-1, 2,3,4,-1 }));
+  }
+  cout << "  }" << endl;
+
+  cout << "  Tokenizer blocks {" << endl;
+  {
+    // tokens separated by every kind of blank, and comments, in a file
+    // several TokenizerFile blocks long
+    string text = "#VRML V2.0 utf8\n";
+    const char* blank[5] = { " ", "\t", ", ", "\r\n", "\n" };
+    for(int k=0;k<60000;k++) {
+      if(k%97==0)      text += "# a comment, with [ brackets ]";
+      else if(k%89==0) text += "#comment after a word";
+      else             text += to_string(k*7919%100003)+((k%3==0)?".5":"");
+      text += blank[k%5];
+      if(k%97==0 || k%89==0) text += "\n";
+    }
+    vector<string> expected,tokens;
+    getcTokens(text,expected);
+    string tokenFile = (filesystem::temp_directory_path()/"dgpTest2c-test.txt").string();
+    FILE* fp = fopen(tokenFile.c_str(),"wb");
+    if(fp!=(FILE*)0) {
+      fwrite(text.data(),1,text.size(),fp);
+      fclose(fp);
+    }
+    fp = fopen(tokenFile.c_str(),"rb");
+    if(fp!=(FILE*)0) {
+      TokenizerFile tkn(fp);
+      while(tkn.get()) tokens.push_back(tkn);
+      fclose(fp);
+    }
+    filesystem::remove(tokenFile);
+    check("TokenizerFile get() == getc() tokenizer",
+          text.size()>3*TokenizerFile::BLOCK_SIZE && tokens==expected);
+    TokenizerString tknString(text);
+    string_view view;
+    tokens.clear();
+    while(tknString.getView(view)) tokens.push_back(string(view));
+    check("TokenizerString getView() == getc() tokenizer",tokens==expected);
+    TokenizerString tknComment("1 #x\n2 3");
+    tokens.clear();
+    while(tknComment.get()) tokens.push_back(tknComment);
+    check("comment \"#x\" ends at the end of its line",
+          tokens==vector<string>({ "1","2","3" }));
+  }
+  cout << "  }" << endl;
+
+  cout << "  Tokenizer number parsing {" << endl;
+  {
+    float f; int i;
+    check("parseFloat overflow gives +inf",
+          Tokenizer::parseFloat("1e60",f) && f==HUGE_VALF);
+    check("parseFloat negative overflow gives -inf",
+          Tokenizer::parseFloat("-1e60",f) && f==-HUGE_VALF);
+    check("parseFloat underflow gives 0",
+          Tokenizer::parseFloat("1e-60",f) && f==0.0f);
+    check("parseFloat short decimal == strtof",
+          Tokenizer::parseFloat("+0.1234567",f) && f==strtof("0.1234567",(char**)0));
+    check("parseInt overflow is rejected",
+          Tokenizer::parseInt("99999999999",i)==false);
+    check("parseInt token which is not a number is rejected",
+          Tokenizer::parseInt("x1",i)==false);
+  }
+  cout << "  }" << endl;
+
+  cout << "  LoaderWrl number arrays {" << endl;
+  {
+    vector<int> loaded;
+    vector<int> expected = { 0,1,2,-1 };
+    check("\"2]\" closes the array",
+          loadCoordIndex("[ 0 1 2 -1]",loaded) && loaded==expected);
+    check("comments inside the array are skipped",
+          loadCoordIndex("[ 0 1 # ] 7 8\n 2 -1 ]",loaded) && loaded==expected);
+
+    // an array larger than the TokenizerFile block size, so that it
+    // crosses block boundaries, with a comment on one of them
+    string text = "[";
+    expected.clear();
+    for(int k=0;k<100000;k++) {
+      if(k==10000) text += " # a comment ] 9 9 9\n";
+      text += (k%4==3)?" -1":" 0 1 2";
+      if(k%4==3) expected.push_back(-1);
+      else { expected.push_back(0); expected.push_back(1); expected.push_back(2); }
+    }
+    text += " ]";
+    check("array across blocks, with a comment",
+          loadCoordIndex(text,loaded) && loaded==expected);
+
+    // the parallel parsing of a large array gives the same values as
+    // the serial parsing
+    Index nThreads0 = Parallel::getNumberOfThreads();
+    string numbers;
+    for(int k=0;k<200000;k++) numbers += to_string((k*7919)%100003-50000)+" ";
+    vector<int> serial,parallel;
+    Parallel::setNumberOfThreads(1);
+    bool ok1 = Tokenizer::parseInts(numbers,serial);
+    Parallel::setNumberOfThreads(4);
+    bool ok4 = Tokenizer::parseInts(numbers,parallel);
+    Parallel::setNumberOfThreads(nThreads0);
+    check("parseInts with 4 threads == 1 thread",
+          ok1 && ok4 && serial.size()==200000 && serial==parallel);
+    check("parseInts rejects a token which is not a number",
+          Tokenizer::parseInts("1 2 x 4",serial)==false);
+  }
+  cout << "  }" << endl;
+
+  cout << "  " << (_nChecks-_nFailures) << " of " << _nChecks << " checks passed" << endl;
+  cout << "} dgpTest2c test" << endl;
+  return _nFailures;
+}
+
 //////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv) {
 
@@ -105,6 +2386,18 @@ int main(int argc, char **argv) {
       D._binaryOutput = !D._binaryOutput;
     } else if(string(argv[i])=="-r" || string(argv[i])=="-removeProperties") {
       D._removeProperties = !D._removeProperties;
+    } else if(string(argv[i])=="-B" || string(argv[i])=="-benchmark") {
+      D._benchmark = !D._benchmark;
+    } else if(string(argv[i])=="-t" || string(argv[i])=="-test") {
+      D._test = !D._test;
+    } else if(string(argv[i])=="-s" || string(argv[i])=="-sortBuild") {
+      D._sortBuild = !D._sortBuild;
+    } else if(string(argv[i])=="-f" || string(argv[i])=="-fastLayout") {
+      D._fastLayout = !D._fastLayout;
+    } else if(string(argv[i])=="-c" || string(argv[i])=="-topologyCache") {
+      D._topologyCache = !D._topologyCache;
+    } else if(string(argv[i])=="-w" || string(argv[i])=="-weldStl") {
+      D._weldStl = !D._weldStl;
     } else if(string(argv[i])[0]=='-') {
       error("unknown option");
     } else if(D._inFile=="") {
@@ -114,8 +2407,34 @@ int main(int argc, char **argv) {
     }
   }
 
+  if(D._sortBuild) {
+    HalfEdges::setBuildMethod(HalfEdges::SORT);
+  }
+
+  if(D._fastLayout) {
+    HalfEdges::setLayout(HalfEdges::FAST);
+  }
+
+  // the exit status is the number of failed checks
+  int nFailures = 0;
+  if(D._test) {
+    nFailures += test();
+    if(D._inFile=="" && D._benchmark==false) return nFailures;
+  }
+
+  if(D._benchmark) {
+    nFailures += benchmark();
+    if(D._inFile=="") return nFailures;
+  }
+
   if(D._inFile =="") error("no inFile");
 
+  // the topology cache files are written next to the input file
+  if(D._topologyCache) {
+    string dir = filesystem::path(D._inFile).parent_path().string();
+    PolygonMesh::setCacheDirectory((dir=="")?".":dir);
+  }
+
   // if D._outFile is not specified then no output file will be written
   // if(D._outFile=="") error("no outFile");
 
@@ -141,6 +2460,7 @@ int main(int argc, char **argv) {
   LoaderPly* plyLoader = new LoaderPly();
   loaderFactory.registerLoader(plyLoader);
   LoaderStl* stlLoader = new LoaderStl();
+  stlLoader->setWeldVertices(D._weldStl);
   loaderFactory.registerLoader(stlLoader);
   LoaderWrl* wrlLoader = new LoaderWrl();
   loaderFactory.registerLoader(wrlLoader);
@@ -217,13 +2537,13 @@ int main(int argc, char **argv) {
       }
       
       ifs->setNormalPerVertex(true);
-      ifs->getNormal().clear();
-      ifs->getNormalIndex().clear();
+      ifs->editNormal().clear();
+      ifs->editNormalIndex().clear();
       ifs->setColorPerVertex(true);
-      ifs->getColor().clear();
-      ifs->getColorIndex().clear();
-      ifs->getTexCoord().clear();
-      ifs->getTexCoordIndex().clear();
+      ifs->editColor().clear();
+      ifs->editColorIndex().clear();
+      ifs->editTexCoord().clear();
+      ifs->editTexCoordIndex().clear();
       
       if(D._debug) {
         cout << "  after removing properties" << endl;
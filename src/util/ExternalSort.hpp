@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// ExternalSort.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+// sorts a sequence of elements which may not fit in memory; the
+// elements are added one at a time to a buffer of bounded size; every
+// time the buffer fills up it is sorted, and written to a temporary
+// run file; finish() merges the runs, and delivers the elements in
+// sorted order; if all the elements fit in the buffer no files are
+// written
+//
+// - T has to be trivially copyable, since it is written to the run
+//   files as raw bytes
+// - the run files are named runPrefix+".run<N>", and they are removed
+//   as soon as they are merged, or by the destructor
+// - at most _maxFanIn runs are merged at a time; if there are more,
+//   groups of runs are merged into longer runs first
+
+template <class T, class Less=less<T>>
+class ExternalSort {
+
+public:
+
+  // memoryBudget is the number of bytes used by the buffer
+  ExternalSort(const string& runPrefix, const size_t memoryBudget,
+               const Less& less=Less());
+  ~ExternalSort();
+
+  // returns false if a run file could not be written
+  bool   add(const T& t);
+
+  // calls f once per element, in sorted order; returns false on I/O
+  // errors; the sort cannot be reused afterwards
+  bool   finish(const function<void(const T&)>& f);
+
+  // number of run files written so far
+  size_t getNumberOfRuns() const;
+
+private:
+
+  static const size_t _maxFanIn = 64;
+
+  bool   _writeRun();
+  string _newRunName();
+  bool   _merge(const vector<string>& runs, const function<void(const T&)>& f);
+
+  string         _prefix;
+  size_t         _capacity;
+  Less           _less;
+  vector<T>      _buffer;
+  vector<string> _runs;
+  size_t         _nRuns;
+  bool           _error;
+
+};
+
+template <class T, class Less>
+ExternalSort<T,Less>::ExternalSort
+(const string& runPrefix, const size_t memoryBudget, const Less& less):
+  _prefix(runPrefix),
+  _capacity(max(memoryBudget/sizeof(T),static_cast<size_t>(1024))),
+  _less(less),
+  _buffer(),
+  _runs(),
+  _nRuns(0),
+  _error(false) {
+  _buffer.reserve(_capacity);
+}
+
+template <class T, class Less>
+ExternalSort<T,Less>::~ExternalSort() {
+  for(const string& run : _runs) remove(run.c_str());
+}
+
+template <class T, class Less>
+bool ExternalSort<T,Less>::add(const T& t) {
+  if(_error) return false;
+  _buffer.push_back(t);
+  if(_buffer.size()>=_capacity && _writeRun()==false) _error = true;
+  return !_error;
+}
+
+template <class T, class Less>
+size_t ExternalSort<T,Less>::getNumberOfRuns() const {
+  return _nRuns;
+}
+
+template <class T, class Less>
+string ExternalSort<T,Less>::_newRunName() {
+  return _prefix+".run"+to_string(_nRuns++);
+}
+
+template <class T, class Less>
+bool ExternalSort<T,Less>::_writeRun() {
+  sort(_buffer.begin(),_buffer.end(),_less);
+  string run = _newRunName();
+  FILE* fp = fopen(run.c_str(),"wb");
+  if(fp==(FILE*)0) return false;
+  _runs.push_back(run);
+  bool success = (fwrite(_buffer.data(),sizeof(T),_buffer.size(),fp)==_buffer.size());
+  success = (fclose(fp)==0) && success;
+  _buffer.clear();
+  return success;
+}
+
+template <class T, class Less>
+bool ExternalSort<T,Less>::finish(const function<void(const T&)>& f) {
+  if(_error) return false;
+  // 1) everything fits in memory
+  if(_runs.empty()) {
+    sort(_buffer.begin(),_buffer.end(),_less);
+    for(const T& t : _buffer) f(t);
+    _buffer.clear();
+    return true;
+  }
+  if(_buffer.empty()==false && _writeRun()==false) return false;
+  vector<T>().swap(_buffer);
+  // 2) merge passes, until at most _maxFanIn runs are left
+  while(_runs.size()>_maxFanIn) {
+    vector<string> group(_runs.begin(),_runs.begin()+_maxFanIn);
+    string run = _newRunName();
+    FILE* fp = fopen(run.c_str(),"wb");
+    if(fp==(FILE*)0) return false;
+    _runs.push_back(run);
+    bool success = _merge(group,[&](const T& t) {
+      if(fwrite(&t,sizeof(T),1,fp)<1) _error = true;
+    });
+    success = (fclose(fp)==0) && success && !_error;
+    for(const string& r : group) remove(r.c_str());
+    _runs.erase(_runs.begin(),_runs.begin()+_maxFanIn);
+    if(success==false) return false;
+  }
+  // 3) final merge
+  bool success = _merge(_runs,f);
+  for(const string& r : _runs) remove(r.c_str());
+  _runs.clear();
+  return success;
+}
+
+template <class T, class Less>
+bool ExternalSort<T,Less>::_merge
+(const vector<string>& runs, const function<void(const T&)>& f) {
+  size_t nRuns = runs.size();
+  // the memory budget is split among the input blocks of the runs
+  size_t blockSize = max(_capacity/nRuns,static_cast<size_t>(256));
+  vector<FILE*>     fp(nRuns,(FILE*)0);
+  vector<vector<T>> block(nRuns);
+  vector<size_t>    next(nRuns,0);
+  bool success = true;
+  auto refill = [&](const size_t i) {
+    block[i].resize(blockSize);
+    size_t n = fread(block[i].data(),sizeof(T),blockSize,fp[i]);
+    if(n<blockSize && ferror(fp[i])) success = false;
+    block[i].resize(n);
+    next[i] = 0;
+    return (n>0);
+  };
+  // the heap contains the index of the run of its first element
+  auto after = [&](const size_t i, const size_t j) {
+    return _less(block[j][next[j]],block[i][next[i]]);
+  };
+  priority_queue<size_t,vector<size_t>,decltype(after)> heap(after);
+  for(size_t i=0;i<nRuns;i++) {
+    fp[i] = fopen(runs[i].c_str(),"rb");
+    if(fp[i]==(FILE*)0) { success = false; break; }
+    if(refill(i)) heap.push(i);
+  }
+  while(success && heap.empty()==false) {
+    size_t i = heap.top();
+    heap.pop();
+    f(block[i][next[i]++]);
+    if(next[i]<block[i].size() || refill(i)) heap.push(i);
+  }
+  for(size_t i=0;i<nRuns;i++)
+    if(fp[i]!=(FILE*)0) fclose(fp[i]);
+  return success;
+}
+
+#endif // EXTERNAL_SORT_HPP
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// Hash.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#include <cstring>
+#include "Hash.hpp"
+
+static const uint64_t _prime1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t _prime2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t _prime3 = 0x165667B19E3779F9ULL;
+
+static inline uint64_t _rotl(const uint64_t x, const int r) {
+  return (x<<r)|(x>>(64-r));
+}
+
+static inline uint64_t _round(uint64_t h, const uint64_t w) {
+  h += w*_prime2;
+  h  = _rotl(h,31);
+  return h*_prime1;
+}
+
+static inline uint64_t _word(const unsigned char* p) {
+  uint64_t w;
+  memcpy(&w,p,8);
+  return w;
+}
+
+uint64_t Hash::hash64(const void* data, const size_t nBytes, const uint64_t seed) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const unsigned char* end = p+nBytes;
+  uint64_t h[4] = { seed+_prime1+_prime2, seed+_prime2, seed, seed-_prime1 };
+
+  // 1) four independent lanes, 32 bytes per iteration
+  for(;end-p>=32;p+=32) {
+    h[0] = _round(h[0],_word(p));
+    h[1] = _round(h[1],_word(p+8));
+    h[2] = _round(h[2],_word(p+16));
+    h[3] = _round(h[3],_word(p+24));
+  }
+  uint64_t x =
+    _rotl(h[0],1)+_rotl(h[1],7)+_rotl(h[2],12)+_rotl(h[3],18)+
+    static_cast<uint64_t>(nBytes);
+
+  // 2) remaining words and bytes
+  for(;end-p>=8;p+=8)
+    x = _rotl(x^_round(0,_word(p)),27)*_prime1+_prime3;
+  for(;p<end;p++)
+    x = _rotl(x^(static_cast<uint64_t>(*p)*_prime3),11)*_prime1;
+
+  // 3) final avalanche
+  x ^= x>>33; x *= _prime2;
+  x ^= x>>29; x *= _prime3;
+  x ^= x>>32;
+  return x;
+}
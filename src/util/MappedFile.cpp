@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// MappedFile.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#include <cstring>
+#include "MappedFile.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#include <system_error>
+#endif
+
+MappedFile::MappedFile(const string& filename):
+  _data((const char*)0),
+  _size(0),
+  _position(0),
+  _buffer() {
+#ifdef MAPPED_FILE_MMAP
+  int fd = open(filename.c_str(),O_RDONLY);
+  if(fd<0) return;
+  struct stat st;
+  if(fstat(fd,&st)==0 && st.st_size>0) {
+    void* p = mmap(0,static_cast<size_t>(st.st_size),PROT_READ,MAP_PRIVATE,fd,0);
+    if(p!=MAP_FAILED) {
+      _data = static_cast<const char*>(p);
+      _size = static_cast<size_t>(st.st_size);
+    }
+  }
+  close(fd);
+#else
+  // ftell() returns a long, which is 32 bits on Windows, and cannot
+  // represent the size of files larger than 2GB
+  error_code ec;
+  uintmax_t size = filesystem::file_size(filename,ec);
+  if(ec || size==0) return;
+  FILE* fp = fopen(filename.c_str(),"rb");
+  if(fp==(FILE*)0) return;
+  _buffer.resize(static_cast<size_t>(size));
+  if(fread(_buffer.data(),1,_buffer.size(),fp)==_buffer.size()) {
+    _data = _buffer.data();
+    _size = _buffer.size();
+  } else {
+    _buffer.clear();
+  }
+  fclose(fp);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef MAPPED_FILE_MMAP
+  if(_data!=(const char*)0)
+    munmap(const_cast<char*>(_data),_size);
+#endif
+}
+
+bool MappedFile::isMapped() const {
+  return (_data!=(const char*)0);
+}
+
+size_t MappedFile::getSize() const {
+  return _size;
+}
+
+const char* MappedFile::getData() const {
+  return _data;
+}
+
+size_t MappedFile::getPosition() const {
+  return _position;
+}
+
+bool MappedFile::read(void* data, const size_t nBytes) {
+  if(nBytes>_size-_position) return false;
+  memcpy(data,_data+_position,nBytes);
+  _position += nBytes;
+  return true;
+}
@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// MappedFile.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// read-only view of the contents of a binary file; on POSIX systems
+// the file is mapped into memory, so that pages are only read when
+// first accessed; elsewhere the whole file is read into a buffer
+//
+// the file can be read sequentially with read() and readArray();
+// arrays written with writeArray() are stored as a 64 bit number of
+// elements followed by the elements, padded with zeros to a multiple
+// of 8 bytes, so that all the arrays of a file which only contains
+// 8 byte aligned headers and arrays are aligned in memory as well
+
+class MappedFile {
+
+public:
+
+  // maps the file; if the file cannot be opened or mapped, isMapped()
+  // returns false, and getSize() returns 0
+              MappedFile(const string& filename);
+             ~MappedFile();
+
+  bool        isMapped()                        const;
+  size_t      getSize()                         const;
+  const char* getData()                         const;
+
+  // position of the next byte to be read
+  size_t      getPosition()                     const;
+
+  // copies the next nBytes bytes to data, and advances the position;
+  // if fewer than nBytes bytes remain, returns false and does not
+  // change the position
+  bool        read(void* data, const size_t nBytes);
+
+  // reads an array written with writeArray(); returns false, and
+  // does not change the position, if the file is too short
+  template <class T>
+  bool        readArray(vector<T>& v);
+
+  // appends the array to the file; returns false on error
+  template <class T>
+  static bool writeArray(FILE* fp, const vector<T>& v);
+
+private:
+
+  // not copyable
+              MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+
+  const char*  _data;
+  size_t       _size;
+  size_t       _position;
+  vector<char> _buffer; // only used if the file cannot be mapped
+
+};
+
+template <class T>
+bool MappedFile::readArray(vector<T>& v) {
+  uint64_t n;
+  size_t position = _position;
+  if(read(&n,sizeof(n))==false) return false;
+  size_t nBytes = static_cast<size_t>(n)*sizeof(T);
+  size_t nPadded = (nBytes+7)&~static_cast<size_t>(7);
+  if(n>_size || nPadded>_size-_position) {
+    _position = position;
+    return false;
+  }
+  const T* p = reinterpret_cast<const T*>(_data+_position);
+  v.assign(p,p+n);
+  _position += nPadded;
+  return true;
+}
+
+template <class T>
+bool MappedFile::writeArray(FILE* fp, const vector<T>& v) {
+  static const char zeros[8] = { 0,0,0,0,0,0,0,0 };
+  uint64_t n = static_cast<uint64_t>(v.size());
+  size_t nBytes = v.size()*sizeof(T);
+  size_t nPad = ((nBytes+7)&~static_cast<size_t>(7))-nBytes;
+  if(fwrite(&n,sizeof(n),1,fp)<1) return false;
+  if(nBytes>0 && fwrite(v.data(),1,nBytes,fp)<nBytes) return false;
+  if(nPad>0 && fwrite(zeros,1,nPad,fp)<nPad) return false;
+  return true;
+}
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// Parallel.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#include <thread>
+#include <vector>
+#include "Parallel.hpp"
+
+static Index _nThreads = 0; // 0 : use the number of hardware threads
+
+Index Parallel::getNumberOfThreads() {
+  if(_nThreads>0) return _nThreads;
+  Index n = static_cast<Index>(thread::hardware_concurrency());
+  return (n>0)?n:1;
+}
+
+void Parallel::setNumberOfThreads(const Index nThreads) {
+  _nThreads = (nThreads>0)?nThreads:0;
+}
+
+Index Parallel::getNumberOfRanges(const Index n, const Index minRange) {
+  if(n<=0) return 0;
+  Index nRanges = getNumberOfThreads();
+  Index maxRanges = (minRange>1)?(n/minRange):n;
+  if(nRanges>maxRanges) nRanges = maxRanges;
+  return (nRanges>1)?nRanges:1;
+}
+
+Index Parallel::forRanges
+(const Index n, const function<void(Index,Index,Index)>& f, const Index minRange) {
+  Index nRanges = getNumberOfRanges(n,minRange);
+  if(nRanges==1) {
+    f(0,0,n);
+  } else if(nRanges>1) {
+    // the calling thread processes the last range
+    vector<thread> threads;
+    for(Index iR=0;iR<nRanges-1;iR++) {
+      Index i0 = static_cast<Index>((static_cast<long long>(n)*(iR  ))/nRanges);
+      Index i1 = static_cast<Index>((static_cast<long long>(n)*(iR+1))/nRanges);
+      threads.push_back(thread(f,iR,i0,i1));
+    }
+    Index i0 = static_cast<Index>((static_cast<long long>(n)*(nRanges-1))/nRanges);
+    f(nRanges-1,i0,n);
+    for(size_t i=0;i<threads.size();i++)
+      threads[i].join();
+  }
+  return nRanges;
+}
@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// Parallel.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <functional>
+#include "Index.hpp"
+
+using namespace std;
+
+namespace Parallel {
+
+  // number of threads used by the parallel algorithms; the default
+  // value is the number of hardware threads; a value of 1 makes all
+  // the algorithms run serially in the calling thread
+  Index getNumberOfThreads();
+  void  setNumberOfThreads(const Index nThreads);
+
+  // splits the range 0<=i<n into at most getNumberOfThreads()
+  // contiguous ranges i0<=i<i1 of at least minRange elements each,
+  // and calls f(iRange,i0,i1) for each range from a different thread;
+  // returns the number of ranges after all the calls have returned;
+  // ranges are numbered in increasing order of i0
+  Index forRanges(const Index n, const function<void(Index,Index,Index)>& f,
+                  const Index minRange=4096);
+
+  // returns the number of ranges that forRanges(n,f,minRange) would
+  // use; can be used to allocate per range storage in advance
+  Index getNumberOfRanges(const Index n, const Index minRange=4096);
+
+};
+
+#endif // PARALLEL_HPP
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2025-10-16 11:20:05 taubin>
+//------------------------------------------------------------------------
+//
+// SharedArray.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//     * Redistributions of source code must retain the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials
+//       provided with the distribution.
+//     * Neither the name of the Brown University nor the names of its
+//       contributors may be used to endorse or promote products
+//       derived from this software without specific prior written
+//       permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GABRIEL
+// TAUBIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+
+#ifndef _SHARED_ARRAY_HPP_
+#define _SHARED_ARRAY_HPP_
+
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// reference counted copy-on-write array; copies of a SharedArray share
+// the same vector, which is only duplicated by write() when more than
+// one SharedArray refers to it
+//
+// - the const accessors never copy the vector
+// - a reference returned by write() is only valid until the
+//   SharedArray is assigned another vector
+// - after write() the caller may still hold a writable reference, so
+//   copies of the SharedArray get their own vector until seal() is
+//   called, which asserts that no such reference is left
+// - the reference count is updated atomically, but concurrent writes
+//   to the same SharedArray have to be synchronized by the caller
+
+template <class T>
+class SharedArray {
+
+public:
+
+  SharedArray():
+    _vector(make_shared<vector<T>>()),
+    _written(false) {
+  }
+
+  // adopts a vector which may also be referenced by other owners, such
+  // as the property values of a Ply
+  explicit SharedArray(const shared_ptr<vector<T>>& v):
+    _vector((v)?v:make_shared<vector<T>>()),
+    _written(false) {
+  }
+
+  SharedArray(const SharedArray& a):
+    _vector(a._share()),
+    _written(false) {
+  }
+
+  SharedArray& operator=(const SharedArray& a) {
+    if(&a!=this) {
+      _vector  = a._share();
+      _written = false;
+    }
+    return *this;
+  }
+
+  const vector<T>& read() const {
+    return *_vector;
+  }
+
+  vector<T>& write() {
+    if(_vector.use_count()>1)
+      _vector = make_shared<vector<T>>(*_vector);
+    _written = true;
+    return *_vector;
+  }
+
+  // the references returned by write() are no longer used
+  void seal() {
+    _written = false;
+  }
+
+  // releases the shared vector without copying it
+  void clear() {
+    if(_vector.use_count()>1) {
+      _vector  = make_shared<vector<T>>();
+      _written = false;
+    } else {
+      _vector->clear();
+    }
+  }
+
+  bool     isShared()                  const { return _vector.use_count()>1; }
+  bool     isSealed()                  const { return          !_written; }
+  size_t   size()                      const { return        _vector->size(); }
+  bool     empty()                     const { return       _vector->empty(); }
+  const T* data()                      const { return        _vector->data(); }
+  const T& operator[](const size_t i)  const { return         (*_vector)[i]; }
+
+private:
+
+  shared_ptr<vector<T>> _vector;
+  // write() was called since the last seal()
+  bool                  _written;
+
+  shared_ptr<vector<T>> _share() const {
+    return (_written)?make_shared<vector<T>>(*_vector):_vector;
+  }
+
+};
+
+#endif // _SHARED_ARRAY_HPP_
@@ -145,7 +145,7 @@ void Group::appendBBoxCoord(vector<float>& coord) {
   }
 }
 
-void Group::updateBBox(vector<float>& coord) {
+void Group::updateBBox(const vector<float>& coord) {
   if(coord.size()>=3) {
     if(hasEmptyBBox()) {
         _bboxCenter.x = coord[0];
@@ -204,12 +204,13 @@ void Group::updateBBox() {
       node = shape->getGeometry();
       if(node!=(Node*)0 && node->isIndexedFaceSet()) {
         IndexedFaceSet* pIfs = (IndexedFaceSet*)node;
-        vector<float> &coord = pIfs->getCoord();    
+        // the corners of the cached bounding box of the coordinates
+        const vector<float> &coord = pIfs->getBBoxCoord();
         // update this group bounding box
         updateBBox(coord);
       } else if(node!=(Node*)0 && node->isIndexedLineSet()) {
         IndexedLineSet* pIls = (IndexedLineSet*)node;
-        vector<float> &coord = pIls->getCoord();    
+        const vector<float> &coord = pIls->getCoord();
         // update this group bounding box
         updateBBox(coord);
       }
@@ -76,7 +76,7 @@ public:
   void                  clearBBox();
   bool                  hasEmptyBBox() const;
   void                  appendBBoxCoord(vector<float>& coord);
-  void                  updateBBox(vector<float>& coord);
+  void                  updateBBox(const vector<float>& coord);
   virtual void          updateBBox();
 
   virtual bool          isGroup() const { return    true; };
@@ -34,7 +34,9 @@
 
 #include <iostream>
 #include "util/CastMacros.hpp"
+#include "util/Parallel.hpp"
 #include "IndexedFaceSet.hpp"
+#include <atomic>
 
 // VRML'97
 //
@@ -59,14 +61,38 @@
 //   field         MFInt32 texCoordIndex     []        # [-1,)
 // }
 
+// shared by all the instances, so that generations are never reused
+static atomic<uint64_t> s_generation(0);
+
+IndexedFaceSet::Mutation::Mutation(IndexedFaceSet& ifs, const unsigned arrays):
+  _ifs(ifs),
+  _arrays(arrays) {
+}
+
+IndexedFaceSet::Mutation::~Mutation() {
+  _ifs.touch(_arrays);
+  _ifs.seal(_arrays);
+}
+
 IndexedFaceSet::IndexedFaceSet():
   _ccw(true),
   _convex(true),
   _creaseAngle(0),
   _solid(true),
   _normalPerVertex(true),
-  _colorPerVertex(true)
-{}
+  _colorPerVertex(true),
+  _faceOffsets(),
+  _faceOffsetsGeneration(0),
+  _faceOffsetsData((const int*)0),
+  _faceOffsetsSize(0),
+  _cacheSlots(),
+  _cacheMutex() {
+  touch(ALL_ARRAYS_MASK);
+}
+
+IndexedFaceSet::~IndexedFaceSet() {
+  clearCacheSlots();
+}
 
 void IndexedFaceSet::clear() {
   _ccw             = true;
@@ -83,22 +109,174 @@ void IndexedFaceSet::clear() {
   _colorIndex.clear();
   _texCoord.clear();
   _texCoordIndex.clear();
+  _faceOffsets.clear();
+  clearCacheSlots();
+  touch(ALL_ARRAYS_MASK);
 }
 
 bool&          IndexedFaceSet::getCcw()              { return _ccw;                }
 bool&          IndexedFaceSet::getConvex()           { return _convex;             }
 float&         IndexedFaceSet::getCreaseangle()      { return _creaseAngle;        }
 bool&          IndexedFaceSet::getSolid()            { return _solid;              }
-bool&          IndexedFaceSet::getNormalPerVertex()  { return _normalPerVertex;    }
-bool&          IndexedFaceSet::getColorPerVertex()   { return _colorPerVertex;     }
-vector<float>& IndexedFaceSet::getCoord()            { return _coord;              }
-vector<int>&   IndexedFaceSet::getCoordIndex()       { return _coordIndex;         }
-vector<float>& IndexedFaceSet::getNormal()           { return _normal;             }
-vector<int>&   IndexedFaceSet::getNormalIndex()      { return _normalIndex;        }
-vector<float>& IndexedFaceSet::getColor()            { return _color;              }
-vector<int>&   IndexedFaceSet::getColorIndex()       { return _colorIndex;         }
-vector<float>& IndexedFaceSet::getTexCoord()         { return _texCoord;           }
-vector<int>&   IndexedFaceSet::getTexCoordIndex()    { return _texCoordIndex;      }
+bool           IndexedFaceSet::getNormalPerVertex() const { return _normalPerVertex; }
+bool           IndexedFaceSet::getColorPerVertex()  const { return _colorPerVertex;  }
+
+// the caller may modify the array; the binding of the normals or
+// colors depends on the xPerVertex fields
+bool&          IndexedFaceSet::editNormalPerVertex() { touch(NORMAL_MASK); return _normalPerVertex; }
+bool&          IndexedFaceSet::editColorPerVertex()  { touch(COLOR_MASK);  return _colorPerVertex;  }
+vector<float>& IndexedFaceSet::editCoord()           { touch(COORD_MASK);           return _coord.write();         }
+vector<float>& IndexedFaceSet::editNormal()          { touch(NORMAL_MASK);          return _normal.write();        }
+vector<int>&   IndexedFaceSet::editNormalIndex()     { touch(NORMAL_INDEX_MASK);    return _normalIndex.write();   }
+vector<float>& IndexedFaceSet::editColor()           { touch(COLOR_MASK);           return _color.write();         }
+vector<int>&   IndexedFaceSet::editColorIndex()      { touch(COLOR_INDEX_MASK);     return _colorIndex.write();    }
+vector<float>& IndexedFaceSet::editTexCoord()        { touch(TEX_COORD_MASK);       return _texCoord.write();      }
+vector<int>&   IndexedFaceSet::editTexCoordIndex()   { touch(TEX_COORD_INDEX_MASK); return _texCoordIndex.write(); }
+
+const vector<float>& IndexedFaceSet::getCoord()         const { return _coord.read();         }
+const vector<float>& IndexedFaceSet::getNormal()        const { return _normal.read();        }
+const vector<int>&   IndexedFaceSet::getNormalIndex()   const { return _normalIndex.read();   }
+const vector<float>& IndexedFaceSet::getColor()         const { return _color.read();         }
+const vector<int>&   IndexedFaceSet::getColorIndex()    const { return _colorIndex.read();    }
+const vector<float>& IndexedFaceSet::getTexCoord()      const { return _texCoord.read();      }
+const vector<int>&   IndexedFaceSet::getTexCoordIndex() const { return _texCoordIndex.read(); }
+
+void IndexedFaceSet::setSharedCoord(const SharedArray<float>& coord) {
+  touch(COORD_MASK); _coord = coord;
+}
+void IndexedFaceSet::setSharedCoordIndex(const SharedArray<int>& coordIndex) {
+  touch(COORD_INDEX_MASK); _coordIndex = coordIndex;
+}
+void IndexedFaceSet::setSharedNormal(const SharedArray<float>& normal) {
+  touch(NORMAL_MASK); _normal = normal;
+}
+void IndexedFaceSet::setSharedNormalIndex(const SharedArray<int>& normalIndex) {
+  touch(NORMAL_INDEX_MASK); _normalIndex = normalIndex;
+}
+void IndexedFaceSet::setSharedColor(const SharedArray<float>& color) {
+  touch(COLOR_MASK); _color = color;
+}
+void IndexedFaceSet::setSharedColorIndex(const SharedArray<int>& colorIndex) {
+  touch(COLOR_INDEX_MASK); _colorIndex = colorIndex;
+}
+void IndexedFaceSet::setSharedTexCoord(const SharedArray<float>& texCoord) {
+  touch(TEX_COORD_MASK); _texCoord = texCoord;
+}
+void IndexedFaceSet::setSharedTexCoordIndex(const SharedArray<int>& texCoordIndex) {
+  touch(TEX_COORD_INDEX_MASK); _texCoordIndex = texCoordIndex;
+}
+
+void IndexedFaceSet::share(const IndexedFaceSet& ifs) {
+  if(&ifs==this) return;
+  _ccw             = ifs._ccw;
+  _convex          = ifs._convex;
+  _creaseAngle     = ifs._creaseAngle;
+  _solid           = ifs._solid;
+  _normalPerVertex = ifs._normalPerVertex;
+  _colorPerVertex  = ifs._colorPerVertex;
+  _coord           = ifs._coord;
+  _coordIndex      = ifs._coordIndex;
+  _normal          = ifs._normal;
+  _normalIndex     = ifs._normalIndex;
+  _color           = ifs._color;
+  _colorIndex      = ifs._colorIndex;
+  _texCoord        = ifs._texCoord;
+  _texCoordIndex   = ifs._texCoordIndex;
+  clearCacheSlots();
+  touch(ALL_ARRAYS_MASK);
+}
+
+void IndexedFaceSet::seal(const unsigned arrays) {
+  if(arrays&COORD_MASK)           _coord.seal();
+  if(arrays&COORD_INDEX_MASK)     _coordIndex.seal();
+  if(arrays&NORMAL_MASK)          _normal.seal();
+  if(arrays&NORMAL_INDEX_MASK)    _normalIndex.seal();
+  if(arrays&COLOR_MASK)           _color.seal();
+  if(arrays&COLOR_INDEX_MASK)     _colorIndex.seal();
+  if(arrays&TEX_COORD_MASK)       _texCoord.seal();
+  if(arrays&TEX_COORD_INDEX_MASK) _texCoordIndex.seal();
+}
+
+uint64_t IndexedFaceSet::getGeneration(const unsigned arrays) const {
+  uint64_t generation = 0;
+  for(int a=0;a<NUMBER_OF_ARRAYS;a++)
+    if((arrays&(1u<<a))!=0 && _generation[a]>generation)
+      generation = _generation[a];
+  return generation;
+}
+
+void IndexedFaceSet::touch(const unsigned arrays) {
+  uint64_t generation = ++s_generation;
+  for(int a=0;a<NUMBER_OF_ARRAYS;a++)
+    if((arrays&(1u<<a))!=0)
+      _generation[a] = generation;
+}
+
+shared_ptr<IndexedFaceSet::CacheSlot>
+IndexedFaceSet::getCacheSlot(const string& name) const {
+  lock_guard<mutex> lock(_cacheMutex);
+  return _getCacheSlot(name);
+}
+
+bool IndexedFaceSet::hasCacheSlot(const string& name) const {
+  lock_guard<mutex> lock(_cacheMutex);
+  return (_cacheSlots.find(name)!=_cacheSlots.end());
+}
+
+void IndexedFaceSet::setCacheSlot
+(const string& name, const unsigned inputs,
+ const shared_ptr<CacheSlot>& artifact) const {
+  lock_guard<mutex> lock(_cacheMutex);
+  _setCacheSlot(name,inputs,artifact);
+}
+
+void IndexedFaceSet::clearCacheSlots() const {
+  lock_guard<mutex> lock(_cacheMutex);
+  _cacheSlots.clear();
+}
+
+shared_ptr<IndexedFaceSet::CacheSlot>
+IndexedFaceSet::_getCacheSlot(const string& name) const {
+  map<string,_Slot>::iterator i = _cacheSlots.find(name);
+  if(i==_cacheSlots.end()) return shared_ptr<CacheSlot>();
+  _Slot& slot = i->second;
+  if(slot.generation!=getGeneration(slot.inputs))
+    slot.artifact.reset();
+  return slot.artifact;
+}
+
+void IndexedFaceSet::_setCacheSlot
+(const string& name, const unsigned inputs,
+ const shared_ptr<CacheSlot>& artifact) const {
+  _Slot& slot = _cacheSlots[name];
+  slot.inputs     = inputs;
+  slot.generation = getGeneration(inputs);
+  slot.artifact   = artifact;
+}
+
+const vector<float>& IndexedFaceSet::getBBoxCoord() const {
+  typedef CacheValue<vector<float>> CachedBBox;
+  lock_guard<mutex> lock(_cacheMutex);
+  shared_ptr<CachedBBox> bbox = static_pointer_cast<CachedBBox>(_getCacheSlot("bbox"));
+  if(!bbox) {
+    bbox = make_shared<CachedBBox>();
+    int nV = static_cast<int>(_coord.size()/3);
+    if(nV>0) {
+      float min[3] = { _coord[0], _coord[1], _coord[2] };
+      float max[3] = { _coord[0], _coord[1], _coord[2] };
+      for(int iV=1;iV<nV;iV++)
+        for(int j=0;j<3;j++) {
+          float x = _coord[3*iV+j];
+          if(x<min[j]) min[j] = x; else if(x>max[j]) max[j] = x;
+        }
+      bbox->value.insert(bbox->value.end(),min,min+3);
+      bbox->value.insert(bbox->value.end(),max,max+3);
+    }
+    _setCacheSlot("bbox",COORD_MASK,bbox);
+  }
+  // the slot keeps the artifact alive until the coord array changes
+  return bbox->value;
+}
 
 int IndexedFaceSet::getNumberOfCoord() {
   return static_cast<int>(_coord.size()/3);
@@ -120,28 +298,69 @@ int IndexedFaceSet::getNumberOfTexCoord() {
   return static_cast<int>(_texCoord.size()/2);
 }
 
+// the caller may modify the array
+vector<int>& IndexedFaceSet::editCoordIndex() {
+  touch(COORD_INDEX_MASK);
+  return _coordIndex.write();
+}
+
+const vector<int>& IndexedFaceSet::getCoordIndex() const {
+  return _coordIndex.read();
+}
+
+const vector<Index>& IndexedFaceSet::getFaceOffsets() const {
+  lock_guard<mutex> lock(_cacheMutex);
+  if(_faceOffsetsGeneration!=_generation[COORD_INDEX] ||
+     _faceOffsetsData!=_coordIndex.data() ||
+     _faceOffsetsSize!=_coordIndex.size())
+    _buildFaceOffsets();
+  return _faceOffsets;
+}
+
+void IndexedFaceSet::_buildFaceOffsets() const {
+  const int* coordIndex = _coordIndex.data();
+  Index nCI = static_cast<Index>(_coordIndex.size());
+
+  // 1) count the separators within each range; the loop has no
+  //    branches, so that the compiler can vectorize it
+  Index nRanges = Parallel::getNumberOfRanges(nCI);
+  vector<Index> firstFace(nRanges+1,0);
+  Parallel::forRanges(nCI,[&](Index iR, Index i0, Index i1) {
+    Index nF = 0;
+    for(Index i=i0;i<i1;i++)
+      nF += (coordIndex[i]<0);
+    firstFace[iR+1] = nF;
+  });
+  for(Index iR=0;iR<nRanges;iR++)
+    firstFace[iR+1] += firstFace[iR];
+  Index nF = firstFace[nRanges];
+
+  // 2) the position after each separator is the first corner of the
+  //    next face
+  _faceOffsets.resize(nF+1);
+  _faceOffsets[0] = 0;
+  Parallel::forRanges(nCI,[&](Index iR, Index i0, Index i1) {
+    Index iF = firstFace[iR];
+    for(Index i=i0;i<i1;i++)
+      if(coordIndex[i]<0) _faceOffsets[++iF] = i+1;
+  });
+
+  _faceOffsetsGeneration = _generation[COORD_INDEX];
+  _faceOffsetsData       = _coordIndex.data();
+  _faceOffsetsSize       = _coordIndex.size();
+}
+
 bool IndexedFaceSet::isTriangleMesh() {
-  bool value = true;
-  int i0,i1,nFi;
-  for(i0=i1=0;i1<(int)_coordIndex.size();i1++) {
-    if(_coordIndex[i1]<0) {
-      nFi = i1-i0;
-      if(nFi!=3) {
-        value = false;
-        break;
-      }
-      i0 = i1+1;
-    }
-  }
-  return value;
+  const vector<Index>& faceOffsets = getFaceOffsets();
+  Index nF = static_cast<Index>(faceOffsets.size())-1;
+  for(Index iF=0;iF<nF;iF++)
+    if(faceOffsets[iF+1]-faceOffsets[iF]!=4)
+      return false;
+  return true;
 }
 
 int IndexedFaceSet::getNumberOfFaces()   {
-  int nFaces = 0;
-  for(int i=0;i<(int)_coordIndex.size();i++)
-    if(_coordIndex[i]<0)
-      nFaces++;
-  return nFaces;
+  return static_cast<int>(getFaceOffsets().size())-1;
 }
 
 int IndexedFaceSet::getNumberOfCorners() {
@@ -326,10 +545,12 @@ bool IndexedFaceSet::hasTexCoord() {
 }
 
 void IndexedFaceSet::setNormalPerVertex(bool value) {
+  if(_normalPerVertex!=value) touch(NORMAL_MASK);
   _normalPerVertex = value;
 }
 
 void IndexedFaceSet::setColorPerVertex(bool value) {
+  if(_colorPerVertex!=value) touch(COLOR_MASK);
   _colorPerVertex = value;
 }
 
@@ -59,12 +59,92 @@
 // }
 
 #include "Node.hpp"
+#include "util/SharedArray.hpp"
+#include "util/Index.hpp"
 #include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
 
 using namespace std;
 
 class IndexedFaceSet : public Node {
 
+public:
+
+  // change tracking
+  // - every array has a generation number, drawn from a counter shared
+  //   by all the IndexedFaceSet instances, so that generation numbers
+  //   are never reused, not even after an instance is deleted
+  // - the getX() methods are const, and never change a generation;
+  //   the editX() methods assume that the caller is going to modify
+  //   the array, and advance its generation
+  // - callers that keep the references returned by the editX()
+  //   methods while they compute derived data should modify the
+  //   arrays within the scope of a Mutation
+  //
+  // threads
+  // - the const methods may be called concurrently on the same node;
+  //   the ones which fill the caches (getBBoxCoord, getFaceOffsets,
+  //   and the cache slot methods) serialize on an internal mutex
+  // - every other method modifies the node, and must not run
+  //   concurrently with any other method on the same node
+  // - the references returned by the const methods remain valid until
+  //   the node is next modified; artifacts obtained from getCacheSlot
+  //   remain valid for as long as the caller holds them
+
+  enum Array {
+    COORD = 0,
+    COORD_INDEX,
+    NORMAL,
+    NORMAL_INDEX,
+    COLOR,
+    COLOR_INDEX,
+    TEX_COORD,
+    TEX_COORD_INDEX,
+    NUMBER_OF_ARRAYS
+  };
+
+  static const unsigned COORD_MASK           = 1u<<COORD;
+  static const unsigned COORD_INDEX_MASK     = 1u<<COORD_INDEX;
+  static const unsigned NORMAL_MASK          = 1u<<NORMAL;
+  static const unsigned NORMAL_INDEX_MASK    = 1u<<NORMAL_INDEX;
+  static const unsigned COLOR_MASK           = 1u<<COLOR;
+  static const unsigned COLOR_INDEX_MASK     = 1u<<COLOR_INDEX;
+  static const unsigned TEX_COORD_MASK       = 1u<<TEX_COORD;
+  static const unsigned TEX_COORD_INDEX_MASK = 1u<<TEX_COORD_INDEX;
+  static const unsigned ALL_ARRAYS_MASK      = (1u<<NUMBER_OF_ARRAYS)-1u;
+
+  // advances the generations of the arrays in the mask, and seals
+  // them, when it goes out of scope
+  class Mutation {
+  public:
+    Mutation(IndexedFaceSet& ifs, const unsigned arrays);
+    ~Mutation();
+  private:
+    IndexedFaceSet& _ifs;
+    unsigned        _arrays;
+  };
+
+  // base class of the data derived from the arrays, stored in named
+  // cache slots; a slot is valid until the generation of one of its
+  // input arrays changes; the artifacts are reference counted, so that
+  // a caller holding one keeps it alive after the slot drops it
+  class CacheSlot {
+  public:
+    virtual ~CacheSlot() {}
+  };
+
+  template<class T>
+  class CacheValue : public CacheSlot {
+  public:
+    template<class... A> CacheValue(A&&... a):value(std::forward<A>(a)...) {}
+    T value;
+  };
+
 private:
 
   bool           _ccw;
@@ -72,39 +152,153 @@ private:
   float          _creaseAngle;
   bool           _solid;
 
-  vector<float>  _coord;
-  vector<int>    _coordIndex;
+  // copy-on-write storage, shared with other nodes until written
+  SharedArray<float> _coord;
+  SharedArray<int>   _coordIndex;
+
+  bool               _normalPerVertex;
+  SharedArray<float> _normal;
+  SharedArray<int>   _normalIndex;
+
+  bool               _colorPerVertex;
+  SharedArray<float> _color;
+  SharedArray<int>   _colorIndex;
 
-  bool           _normalPerVertex;
-  vector<float>  _normal;
-  vector<int>    _normalIndex;
+  SharedArray<float> _texCoord;
+  SharedArray<int>   _texCoordIndex;
 
-  bool           _colorPerVertex;
-  vector<float>  _color;
-  vector<int>    _colorIndex;
+  uint64_t       _generation[NUMBER_OF_ARRAYS];
 
-  vector<float>  _texCoord;
-  vector<int>    _texCoordIndex;
+  // cached by getFaceOffsets(), together with the generation, address,
+  // and size of the _coordIndex array it was computed from
+  mutable vector<Index> _faceOffsets;
+  mutable uint64_t     _faceOffsetsGeneration;
+  mutable const int*   _faceOffsetsData;
+  mutable size_t       _faceOffsetsSize;
+
+  struct _Slot {
+    unsigned              inputs;
+    uint64_t              generation;
+    shared_ptr<CacheSlot> artifact;
+  };
+
+  mutable map<string,_Slot> _cacheSlots;
+
+  // serializes the const methods which fill the caches
+  mutable mutex  _cacheMutex;
+
+  void           _buildFaceOffsets() const;
+  // the cache slot methods, called with _cacheMutex held
+  shared_ptr<CacheSlot> _getCacheSlot(const string& name) const;
+  void           _setCacheSlot(const string& name, const unsigned inputs,
+                               const shared_ptr<CacheSlot>& artifact) const;
+
+  // not copyable, since the cache slots own their artifacts; use
+  // share() instead
+  IndexedFaceSet(const IndexedFaceSet&);
+  IndexedFaceSet& operator=(const IndexedFaceSet&);
 
 public:
   
   IndexedFaceSet();
+  virtual ~IndexedFaceSet();
 
   void            clear();
   bool&           getCcw();
   bool&           getConvex();
   float&          getCreaseangle();
   bool&           getSolid();
-  bool&           getNormalPerVertex();
-  bool&           getColorPerVertex();
-  vector<float>&  getCoord();
-  vector<int>&    getCoordIndex();
-  vector<float>&  getNormal();
-  vector<int>&    getNormalIndex();
-  vector<float>&  getColor();
-  vector<int>&    getColorIndex();
-  vector<float>&  getTexCoord();
-  vector<int>&    getTexCoordIndex();
+  bool            getNormalPerVertex() const;
+  bool            getColorPerVertex() const;
+  const vector<float>& getCoord() const;
+  const vector<int>& getCoordIndex() const;
+  const vector<float>& getNormal() const;
+  const vector<int>& getNormalIndex() const;
+  const vector<float>& getColor() const;
+  const vector<int>& getColorIndex() const;
+  const vector<float>& getTexCoord() const;
+  const vector<int>& getTexCoordIndex() const;
+
+  // the editX() methods return writable references, and advance the
+  // generation of the array; the reference is valid until the array
+  // is shared, replaced, or the node is deleted
+  bool&           editNormalPerVertex();
+  bool&           editColorPerVertex();
+  vector<float>&  editCoord();
+  vector<int>&    editCoordIndex();
+  vector<float>&  editNormal();
+  vector<int>&    editNormalIndex();
+  vector<float>&  editColor();
+  vector<int>&    editColorIndex();
+  vector<float>&  editTexCoord();
+  vector<int>&    editTexCoordIndex();
+
+  // the arrays are stored as copy-on-write SharedArrays; the editX()
+  // methods copy an array only if it is shared with another node, so
+  // that several nodes, or a node and the Ply it was loaded from, can
+  // refer to the same memory until one of them modifies it; the
+  // getSharedX() arrays are copied when they are shared if they were
+  // edited since they were last sealed
+  const SharedArray<float>& getSharedCoord()         const { return _coord;         }
+  const SharedArray<int>&   getSharedCoordIndex()    const { return _coordIndex;    }
+  const SharedArray<float>& getSharedNormal()        const { return _normal;        }
+  const SharedArray<int>&   getSharedNormalIndex()   const { return _normalIndex;   }
+  const SharedArray<float>& getSharedColor()         const { return _color;         }
+  const SharedArray<int>&   getSharedColorIndex()    const { return _colorIndex;    }
+  const SharedArray<float>& getSharedTexCoord()      const { return _texCoord;      }
+  const SharedArray<int>&   getSharedTexCoordIndex() const { return _texCoordIndex; }
+
+  void            setSharedCoord(const SharedArray<float>& coord);
+  void            setSharedCoordIndex(const SharedArray<int>& coordIndex);
+  void            setSharedNormal(const SharedArray<float>& normal);
+  void            setSharedNormalIndex(const SharedArray<int>& normalIndex);
+  void            setSharedColor(const SharedArray<float>& color);
+  void            setSharedColorIndex(const SharedArray<int>& colorIndex);
+  void            setSharedTexCoord(const SharedArray<float>& texCoord);
+  void            setSharedTexCoordIndex(const SharedArray<int>& texCoordIndex);
+
+  // makes this node a shallow copy of ifs : the fields are copied,
+  // and the arrays are shared until either node modifies them; an
+  // array edited since it was last sealed is copied instead, since
+  // the editX() reference may still be used to write it
+  void            share(const IndexedFaceSet& ifs);
+  // asserts that no reference returned by the editX() methods for the
+  // arrays in the mask is used any more, so that they can be shared
+  void            seal(const unsigned arrays = ALL_ARRAYS_MASK);
+
+  // largest generation of the arrays in the mask; it changes if and
+  // only if one of those arrays may have been modified
+  uint64_t        getGeneration(const unsigned arrays) const;
+  // advances the generations of the arrays in the mask
+  void            touch(const unsigned arrays);
+
+  // returns the artifact stored in the slot if it is still valid;
+  // otherwise releases the stale artifact, and returns a null pointer
+  shared_ptr<CacheSlot> getCacheSlot(const string& name) const;
+  // true if the slot exists, whether it is still valid or not
+  bool            hasCacheSlot(const string& name) const;
+  // stores the artifact, which is computed from the current contents
+  // of the input arrays
+  void            setCacheSlot(const string& name, const unsigned inputs,
+                               const shared_ptr<CacheSlot>& artifact) const;
+  void            clearCacheSlots() const;
+
+  // min and max corners of the bounding box of the coord array, or an
+  // empty array if there are no coordinates; cached until the coord
+  // array changes
+  const vector<float>& getBBoxCoord() const;
+
+  // index of the first corner of each face in coordIndex, followed
+  // by the position after the last face separator; face iF occupies
+  // the positions faceOffsets[iF]<=i<faceOffsets[iF+1]-1, and its
+  // separator is at faceOffsets[iF+1]-1; corners after the last
+  // separator do not belong to any face
+  // - the offsets are Index values, so that they can describe a
+  //   coordIndex array with more than INT_MAX entries
+  // - the array is computed with a parallel scan the first time it is
+  //   requested, and cached until the generation of the coordIndex
+  //   array changes, or the array is reallocated
+  const vector<Index>& getFaceOffsets() const;
 
   bool            isTriangleMesh();
   int             getNumberOfFaces();
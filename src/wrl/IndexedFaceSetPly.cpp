@@ -59,15 +59,6 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
 
     int iF,i,i0,i1;
 
-    vector<float>& coord         = getCoord();
-    vector<int>&   coordIndex    = getCoordIndex();
-    vector<float>& normal        = getNormal();
-    vector<int>&   normalIndex   = getNormalIndex();
-    vector<float>& color         = getColor();
-    vector<int>&   colorIndex    = getColorIndex();
-    vector<float>& texCoord      = getTexCoord();
-    vector<int>&   texCoordIndex = getTexCoordIndex();
-
     Ply::Element*  vertex        = ply->getElement("vertex");
     int            nVertices     = ply->getNumberOfElementRecords("vertex");
     // Ply::Element*  edge          = ply->getElement("edge");
@@ -116,12 +107,13 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
     // vertex coordinates
     if(_ply->getWrlMode()) {
 
+      // the properties already have the layout of the IndexedFaceSet
+      // arrays, which share them with the Ply instead of copying them
+
       Ply::Element::Property* coordP = vertex->getProperty("coord");
       if(coordP==nullptr)
         throw new StrException("  ply does not have vertex coordinates");
-      vector<float>* coordV =
-        static_cast<vector<float>*>(coordP->getValue());
-      coord.insert(coord.end(),coordV->begin(),coordV->end());
+      setSharedCoord(_sharedFloat(coordP));
     
       // normals per vertex
       Ply::Element::Property* normalP = vertex->getProperty("normal");
@@ -130,11 +122,8 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
         // APP->log(QString("%1  has normals per vertex").arg(indent.c_str()));
 
         setNormalPerVertex(true);
-        normal.clear();
-        normalIndex.clear();
-        vector<float>* normalV =
-          static_cast<vector<float>*>(normalP->getValue());
-        normal.insert(normal.end(),normalV->begin(),normalV->end());
+        setSharedNormal(_sharedFloat(normalP));
+        editNormalIndex().clear();
 
         // APP->log(QString("%1  nNormals = %2")
         //          .arg(indent.c_str()).arg(normal.size()/3));
@@ -150,11 +139,8 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
         // APP->log(QString("%1  has colors per vertex").arg(indent.c_str()));
 
         setColorPerVertex(true);
-        color.clear();
-        colorIndex.clear();
-        vector<float>* colorV =
-          static_cast<vector<float>*>(colorP->getValue());
-        color.insert(color.end(),colorV->begin(),colorV->end());
+        setSharedColor(_sharedFloat(colorP));
+        editColorIndex().clear();
 
         // APP->log(QString("%1  nColors = %2")
         //          .arg(indent.c_str()).arg(color.size()/3));
@@ -170,11 +156,8 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
         // APP->log(QString("%1  has texture coordinates per vertex")
         //          .arg(indent.c_str()));
 
-        texCoord.clear();
-        texCoordIndex.clear();
-        vector<float>* texCoordV =
-          static_cast<vector<float>*>(texCoordP->getValue());
-        texCoord.insert(texCoord.end(),texCoordV->begin(),texCoordV->end());
+        setSharedTexCoord(_sharedFloat(texCoordP));
+        editTexCoordIndex().clear();
 
         // APP->log(QString("%1  nTexCoord = %2")
         //          .arg(indent.c_str()).arg(texCoord.size()/2));
@@ -189,9 +172,9 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
         // APP->log(QString("%1  has faces").arg(indent.c_str()));
       
         Ply::Element::Property* coordIndexP = face->getProperty("coordIndex");
-        vector<int>* coordIndexV =
-          static_cast<vector<int>*>(coordIndexP->getValue());
-        coordIndex.insert(coordIndex.end(),coordIndexV->begin(),coordIndexV->end());
+        setSharedCoordIndex
+          (SharedArray<int>(static_pointer_cast<vector<int>>
+                            (coordIndexP->getSharedValue())));
     
         // normals per face
         Ply::Element::Property* normalP = face->getProperty("normal");
@@ -200,11 +183,8 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
           // APP->log(QString("%1  has normals per face").arg(indent.c_str()));
 
           setNormalPerVertex(false);
-          normal.clear();
-          normalIndex.clear();
-          vector<float>* normalV =
-            static_cast<vector<float>*>(normalP->getValue());
-          normal.insert(normal.end(),normalV->begin(),normalV->end());
+          setSharedNormal(_sharedFloat(normalP));
+          editNormalIndex().clear();
 
           // APP->log(QString("%1  nNormals = %2")
           //          .arg(indent.c_str()).arg(normal.size()/3));
@@ -220,11 +200,8 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
           // APP->log(QString("%1  has colors per face").arg(indent.c_str()));
 
           setColorPerVertex(false);
-          color.clear();
-          colorIndex.clear();
-          vector<float>* colorV =
-            static_cast<vector<float>*>(colorP->getValue());
-          color.insert(color.end(),colorV->begin(),colorV->end());
+          setSharedColor(_sharedFloat(colorP));
+          editColorIndex().clear();
 
           // APP->log(QString("%1  nColors = %2")
           //          .arg(indent.c_str()).arg(color.size()/3));
@@ -239,6 +216,15 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
 
     } else {
 
+      vector<float>& coord         = editCoord();
+      vector<int>&   coordIndex    = editCoordIndex();
+      vector<float>& normal        = editNormal();
+      vector<int>&   normalIndex   = editNormalIndex();
+      vector<float>& color         = editColor();
+      vector<int>&   colorIndex    = editColorIndex();
+      vector<float>& texCoord      = editTexCoord();
+      vector<int>&   texCoordIndex = editTexCoordIndex();
+
       Ply::Element::Property* xP = vertex->getProperty("x");
       Ply::Element::Property* yP = vertex->getProperty("y");
       Ply::Element::Property* zP = vertex->getProperty("z");
@@ -430,10 +416,15 @@ IndexedFaceSetPly::IndexedFaceSetPly(Ply * ply, const string indent):
     // APP->log(QString("%1  EXCEPTION | ").arg(indent.c_str()).arg(e->what()));
     delete e;
   }
+  seal();
   
   // APP->log(QString("%1}").arg(indent.c_str()));
 }
 
+SharedArray<float> IndexedFaceSetPly::_sharedFloat(Ply::Element::Property* p) {
+  return SharedArray<float>(static_pointer_cast<vector<float>>(p->getSharedValue()));
+}
+
 IndexedFaceSetPly::~IndexedFaceSetPly() {
   if(_ply) delete _ply;
 }
@@ -53,6 +53,8 @@ protected:
 
   Ply* _ply;
 
+  static SharedArray<float> _sharedFloat(Ply::Element::Property* p);
+
 public:
   
   IndexedFaceSetPly(Ply * ply = nullptr, const string indent="");
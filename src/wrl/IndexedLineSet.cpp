@@ -59,11 +59,11 @@ void IndexedLineSet::clear() {
   _colorPerVertex  = true;
 }
 
-bool&          IndexedLineSet::getColorPerVertex()   { return _colorPerVertex;     }
-vector<float>& IndexedLineSet::getCoord()            { return _coord;              }
-vector<int>&   IndexedLineSet::getCoordIndex()       { return _coordIndex;         }
-vector<float>& IndexedLineSet::getColor()            { return _color;              }
-vector<int>&   IndexedLineSet::getColorIndex()       { return _colorIndex;         }
+bool&          IndexedLineSet::editColorPerVertex()  { return _colorPerVertex;     }
+vector<float>& IndexedLineSet::editCoord()           { return _coord.write();      }
+vector<int>&   IndexedLineSet::editCoordIndex()      { return _coordIndex.write(); }
+vector<float>& IndexedLineSet::editColor()           { return _color.write();      }
+vector<int>&   IndexedLineSet::editColorIndex()      { return _colorIndex.write(); }
 
 int            IndexedLineSet::getNumberOfCoord()    { return (int)(_coord.size()/3);    }
 int            IndexedLineSet::getNumberOfColor()    { return (int)(_color.size()/3);    }
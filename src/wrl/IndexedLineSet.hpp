@@ -48,6 +48,7 @@
 // }
 
 #include "Node.hpp"
+#include "util/SharedArray.hpp"
 #include <vector>
 
 using namespace std;
@@ -56,22 +57,42 @@ class IndexedLineSet : public Node {
 
 private:
 
-  vector<float> _coord;
-  vector<int>   _coordIndex;
-  vector<float> _color;
-  vector<int>   _colorIndex;
-  bool          _colorPerVertex;
+  // copy-on-write storage, shared with other nodes until written
+  SharedArray<float> _coord;
+  SharedArray<int>   _coordIndex;
+  SharedArray<float> _color;
+  SharedArray<int>   _colorIndex;
+  bool               _colorPerVertex;
 
 public:
   
   IndexedLineSet();
 
   void           clear();
-  bool&          getColorPerVertex();
-  vector<float>& getCoord();
-  vector<int>&   getCoordIndex();
-  vector<float>& getColor();
-  vector<int>&   getColorIndex();
+  bool           getColorPerVertex()  const { return _colorPerVertex;     }
+  const vector<float>& getCoord()      const { return _coord.read();      }
+  const vector<int>&   getCoordIndex() const { return _coordIndex.read(); }
+  const vector<float>& getColor()      const { return _color.read();      }
+  const vector<int>&   getColorIndex() const { return _colorIndex.read(); }
+
+  // writable references; see IndexedFaceSet
+  bool&          editColorPerVertex();
+  vector<float>& editCoord();
+  vector<int>&   editCoordIndex();
+  vector<float>& editColor();
+  vector<int>&   editColorIndex();
+
+  // the editX() methods copy an array only if it is shared with
+  // another node; see IndexedFaceSet
+  const SharedArray<float>& getSharedCoord()      const { return _coord;      }
+  const SharedArray<int>&   getSharedCoordIndex() const { return _coordIndex; }
+  const SharedArray<float>& getSharedColor()      const { return _color;      }
+  const SharedArray<int>&   getSharedColorIndex() const { return _colorIndex; }
+
+  void           setSharedCoord(const SharedArray<float>& coord)    { _coord      = coord; }
+  void           setSharedCoordIndex(const SharedArray<int>& index) { _coordIndex = index; }
+  void           setSharedColor(const SharedArray<float>& color)    { _color      = color; }
+  void           setSharedColorIndex(const SharedArray<int>& index) { _colorIndex = index; }
 
   int            getNumberOfPolylines();
 
@@ -351,7 +351,7 @@ void Ply::logInfo(ostream & ostr, const string indent) {
     Ply::Element::Property* property;
     Ply::Element::Property::Type propertyType;
     Ply::Element::Property::Type listType;
-    void* propertyValue;
+    const void* propertyValue;
     int iElement,i0,i1;
     int iProperty,iRecord,nElements,nProperties,nRecords,propertySize;
     string elementName,propertyName;
@@ -437,7 +437,7 @@ void Ply::logInfo(ostream & ostr, const string indent) {
         property      = element->getProperty(iProperty);
         propertyName  = property->getName();
         propertyType  = property->getPropertyType();
-        propertyValue = property->getValue(); 
+        propertyValue = property->readValue();
 
         if(property->isList()==true) {
 
@@ -465,44 +465,44 @@ void Ply::logInfo(ostream & ostr, const string indent) {
           case Ply::Element::Property::Type::CHAR:
           case Ply::Element::Property::Type::INT8:
             propertySize =
-              I(static_cast<vector<char>*>(propertyValue)->size());
+              I(static_cast<const vector<char>*>(propertyValue)->size());
             break;
           case Ply::Element::Property::Type::UCHAR:
           case Ply::Element::Property::Type::UINT8:
             propertySize =
-              I(static_cast<vector<unsigned char>*>(propertyValue)->size());
+              I(static_cast<const vector<unsigned char>*>(propertyValue)->size());
             break;
           case Ply::Element::Property::Type::SHORT:
           case Ply::Element::Property::Type::INT16:
             propertySize =
-              I(static_cast<vector<short>*>(propertyValue)->size());
+              I(static_cast<const vector<short>*>(propertyValue)->size());
             break;
           case Ply::Element::Property::Type::USHORT:
           case Ply::Element::Property::Type::UINT16:
             propertySize =
-              I(static_cast<vector<unsigned short>*>(propertyValue)->size());
+              I(static_cast<const vector<unsigned short>*>(propertyValue)->size());
             break;
           case Ply::Element::Property::Type::INT:
           case Ply::Element::Property::Type::INT32:
             propertySize =
-              I(static_cast<vector<int>*>(propertyValue)->size());
+              I(static_cast<const vector<int>*>(propertyValue)->size());
             break;
           case Ply::Element::Property::Type::UINT:
           case Ply::Element::Property::Type::UINT32:
             propertySize =
-              I(static_cast<vector<unsigned int>*>(propertyValue)->size());
+              I(static_cast<const vector<unsigned int>*>(propertyValue)->size());
             break;
           case Ply::Element::Property::Type::FLOAT:
           case Ply::Element::Property::Type::FLOAT32:
           case Ply::Element::Property::Type::FLOAT32_2:
           case Ply::Element::Property::Type::FLOAT32_3:
             propertySize =
-              I(static_cast<vector<float>*>(propertyValue)->size());
+              I(static_cast<const vector<float>*>(propertyValue)->size());
             break;
           case Ply::Element::Property::Type::DOUBLE:
           case Ply::Element::Property::Type::FLOAT64:
             propertySize =
-              I(static_cast<vector<double>*>(propertyValue)->size());
+              I(static_cast<const vector<double>*>(propertyValue)->size());
             break;
 
           case Ply::Element::Property::Type::NONE:
@@ -828,6 +828,7 @@ Ply::Element::Property::Property
 (const string& name, const bool list,
  const Type listType, const Type type, Element& element):
   _name(name),
+  _shared(),
   _value(nullptr),
   _first(),
   _type(type),
@@ -837,41 +838,42 @@ Ply::Element::Property::Property
   switch(type) {
   case CHAR:
   case INT8:
-    _value = static_cast<void*>(new vector<char>());
+    _shared = make_shared<vector<char>>();
     break;
   case UCHAR:
   case UINT8:
-    _value = static_cast<void*>(new vector<unsigned char>());
+    _shared = make_shared<vector<unsigned char>>();
     break;
   case SHORT:
   case INT16:
-    _value = static_cast<void*>(new vector<short>());
+    _shared = make_shared<vector<short>>();
     break;
   case USHORT:
   case UINT16:
-    _value = static_cast<void*>(new vector<unsigned short>());
+    _shared = make_shared<vector<unsigned short>>();
     break;
   case INT:
   case INT32:
-    _value = static_cast<void*>(new vector<int>());
+    _shared = make_shared<vector<int>>();
     break;
   case UINT:
   case UINT32:
-    _value = static_cast<void*>(new vector<unsigned int>());
+    _shared = make_shared<vector<unsigned int>>();
     break;
   case FLOAT:
   case FLOAT32:
   case FLOAT32_2:
   case FLOAT32_3:
-    _value = static_cast<void*>(new vector<float>());
+    _shared = make_shared<vector<float>>();
     break;
   case DOUBLE:
   case FLOAT64:
-    _value = static_cast<void*>(new vector<double>());
+    _shared = make_shared<vector<double>>();
     break;
   case NONE:
     throw new StrException("unexpected Property type");
   }
+  _value = _shared.get();
 
   if(list) {
     _listType = listType;
@@ -879,60 +881,85 @@ Ply::Element::Property::Property
   }
 }
 
+// the vector is deleted by _shared, unless it is still shared
 Ply::Element::Property::~Property() {
+}
+
+void Ply::Element::Property::swap(Property& p) {
+  string name     =     _name; _name     =     p._name; p._name     =      name;
+  void*  value    =    _value; _value    =    p._value; p._value    =     value;
+  _shared.swap(p._shared);
+  Type   type     =     _type; _type     =     p._type; p._type     =      type;
+  Type   listType = _listType; _listType = p._listType; p._listType =  listType;
+  _first.swap(p._first);
+}
+
+string& Ply::Element::Property::getName() {
+  return _name;
+}
+void* Ply::Element::Property::getValue() {
+  if(_shared.use_count()>1) _unshare();
+  return _value;
+}
+const void* Ply::Element::Property::readValue() {
+  return _value;
+}
+
+// replaces the shared vector by a private copy, and updates the
+// wrlMode pointers of the Ply which refer to it
+void Ply::Element::Property::_unshare() {
   switch(_type) {
   case CHAR:
   case INT8:
-    delete static_cast<vector<char>*>(_value);
+    _shared = make_shared<vector<char>>(*static_cast<vector<char>*>(_value));
     break;
   case UCHAR:
   case UINT8:
-    delete static_cast<vector<unsigned char>*>(_value);
+    _shared = make_shared<vector<unsigned char>>
+      (*static_cast<vector<unsigned char>*>(_value));
     break;
   case SHORT:
   case INT16:
-    delete static_cast<vector<short>*>(_value);
+    _shared = make_shared<vector<short>>(*static_cast<vector<short>*>(_value));
     break;
   case USHORT:
   case UINT16:
-    delete static_cast<vector<unsigned short>*>(_value);
+    _shared = make_shared<vector<unsigned short>>
+      (*static_cast<vector<unsigned short>*>(_value));
     break;
   case INT:
   case INT32:
-    delete static_cast<vector<int>*>(_value);
+    _shared = make_shared<vector<int>>(*static_cast<vector<int>*>(_value));
     break;
   case UINT:
   case UINT32:
-    delete static_cast<vector<unsigned int>*>(_value);
+    _shared = make_shared<vector<unsigned int>>
+      (*static_cast<vector<unsigned int>*>(_value));
     break;
   case FLOAT:
   case FLOAT32:
   case FLOAT32_2:
   case FLOAT32_3:
-    delete static_cast<vector<float>*>(_value);
+    _shared = make_shared<vector<float>>(*static_cast<vector<float>*>(_value));
     break;
   case DOUBLE:
   case FLOAT64:
-    delete static_cast<vector<double>*>(_value);
+    _shared = make_shared<vector<double>>(*static_cast<vector<double>*>(_value));
     break;
   case NONE:
     break;
   }
-}
-
-void Ply::Element::Property::swap(Property& p) {
-  string name     =     _name; _name     =     p._name; p._name     =      name;
-  void*  value    =    _value; _value    =    p._value; p._value    =     value;
-  Type   type     =     _type; _type     =     p._type; p._type     =      type;
-  Type   listType = _listType; _listType = p._listType; p._listType =  listType;
-  _first.swap(p._first);
-}
-
-string& Ply::Element::Property::getName() {
-  return _name;
-}
-void* Ply::Element::Property::getValue() {
-  return _value;
+  void* value = _value;
+  _value = _shared.get();
+  Ply& ply = _element.ply();
+  if(ply._coord     ==value) ply._coord      = static_cast<vector<float>*>(_value);
+  if(ply._coordIndex==value) ply._coordIndex = static_cast<vector<int>*>(_value);
+  if(ply._normal    ==value) ply._normal     = static_cast<vector<float>*>(_value);
+  if(ply._color     ==value) ply._color      = static_cast<vector<float>*>(_value);
+  if(ply._texCoord  ==value) ply._texCoord   = static_cast<vector<float>*>(_value);
+}
+shared_ptr<void> Ply::Element::Property::getSharedValue() {
+  return _shared;
 }
 bool Ply::Element::Property::isList() {
   return (_first.size()>0);
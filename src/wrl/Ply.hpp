@@ -44,6 +44,7 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 
 using namespace std;
 
@@ -102,7 +103,15 @@ public:
       
       void             swap(Property& p);
       string&          getName();
+      // the vector which stores the values, for writing; if it is
+      // shared with other owners, it is copied first
       void*            getValue();
+      // the vector which stores the values, for reading; never copied
+      const void*      readValue();
+      // the vector which stores the values, which other owners may
+      // keep after the Ply is deleted, such as the copy-on-write
+      // arrays of an IndexedFaceSet
+      shared_ptr<void> getSharedValue();
       bool             isList();
       Type             getListType();
       const string     getListTypeName();
@@ -116,7 +125,10 @@ public:
 
     private:
 
+      void            _unshare();
+
       string          _name;
+      shared_ptr<void> _shared;
       void*           _value;
       vector<int>     _first;
       Type            _type;
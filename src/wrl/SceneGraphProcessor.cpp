@@ -34,6 +34,12 @@
 
 #include <math.h>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
 #include "SceneGraphProcessor.hpp"
 #include "SceneGraphTraversal.hpp"
 #include "Shape.hpp"
@@ -41,6 +47,22 @@
 #include "IndexedLineSet.hpp"
 #include "Appearance.hpp"
 #include "Material.hpp"
+#include "IndexedFaceSetPly.hpp"
+#include "util/BBox.hpp"
+#include "util/Parallel.hpp"
+#include "core/Graph.hpp"
+#include "core/CsrGraph.hpp"
+#include "core/PolygonMesh.hpp"
+
+float SceneGraphProcessor::_weldEpsilon = 0.0f;
+
+void SceneGraphProcessor::setWeldEpsilon(const float epsilon) {
+  _weldEpsilon = (epsilon>0.0f)?epsilon:0.0f;
+}
+
+float SceneGraphProcessor::getWeldEpsilon() {
+  return _weldEpsilon;
+}
 
 SceneGraphProcessor::SceneGraphProcessor(SceneGraph& wrl):
   _wrl(wrl) {
@@ -69,6 +91,34 @@ void SceneGraphProcessor::computeNormalPerCorner() {
   _applyToIndexedFaceSet(_computeNormalPerCorner);
 }
 
+// the PolygonMesh keeps a reference to the coordIndex array it is
+// built from, so the artifact also holds a share of that array; if the
+// node later edits or replaces its coordIndex, the mesh keeps reading
+// the old contents
+namespace {
+struct CachedPolygonMesh : public IndexedFaceSet::CacheSlot {
+  SharedArray<int> coordIndex;
+  PolygonMesh      mesh;
+  CachedPolygonMesh(const int nV, const SharedArray<int>& sharedCoordIndex):
+    coordIndex(sharedCoordIndex),
+    mesh(nV,coordIndex.read()) {
+  }
+};
+}
+
+shared_ptr<const PolygonMesh>
+SceneGraphProcessor::getPolygonMesh(const IndexedFaceSet& ifs) {
+  int nV = static_cast<int>(ifs.getCoord().size()/3);
+  shared_ptr<CachedPolygonMesh> cached =
+    static_pointer_cast<CachedPolygonMesh>(ifs.getCacheSlot("PolygonMesh"));
+  if(!cached || cached->mesh.getNumberOfVertices()!=nV) {
+    cached = make_shared<CachedPolygonMesh>(nV,ifs.getSharedCoordIndex());
+    ifs.setCacheSlot("PolygonMesh",IndexedFaceSet::COORD_INDEX_MASK,cached);
+  }
+  // shares the ownership of the artifact
+  return shared_ptr<const PolygonMesh>(cached,&cached->mesh);
+}
+
 void SceneGraphProcessor::_applyToIndexedFaceSet(IndexedFaceSet::Operator o) {
   SceneGraphTraversal traversal(_wrl);
   traversal.start();
@@ -86,21 +136,39 @@ void SceneGraphProcessor::_applyToIndexedFaceSet(IndexedFaceSet::Operator o) {
 }
 
 void SceneGraphProcessor::_normalClear(IndexedFaceSet& ifs) {
-  vector<float>& normal      = ifs.getNormal();
-  vector<int>&   normalIndex = ifs.getNormalIndex();
+  vector<float>& normal      = ifs.editNormal();
+  vector<int>&   normalIndex = ifs.editNormalIndex();
   ifs.setNormalPerVertex(true);
   normal.clear();
   normalIndex.clear();
 }
 
 void SceneGraphProcessor::_normalInvert(IndexedFaceSet& ifs) {
-  vector<float>& normal = ifs.getNormal();
+  vector<float>& normal = ifs.editNormal();
   for(int i=0;i<(int)normal.size();i++)
     normal[i] = -normal[i];
 }
 
+// the normals computed by this class are registered in the "normal"
+// cache slot, with the coord and coordIndex arrays as inputs, and are
+// recomputed if those arrays change; normals which were not computed
+// here, such as the normals loaded from a file, are never replaced by
+// computed normals of the same binding
+bool SceneGraphProcessor::_hasCurrentNormal
+(IndexedFaceSet& ifs, IndexedFaceSet::Binding binding) {
+  if(ifs.getNormalBinding()!=binding) return false;
+  if(ifs.hasCacheSlot("normal")==false) return true;
+  return (ifs.getCacheSlot("normal")!=nullptr);
+}
+
+void SceneGraphProcessor::_setComputedNormal(IndexedFaceSet& ifs) {
+  ifs.setCacheSlot("normal",
+                   IndexedFaceSet::COORD_MASK|IndexedFaceSet::COORD_INDEX_MASK,
+                   make_shared<IndexedFaceSet::CacheSlot>());
+}
+
 void SceneGraphProcessor::_computeFaceNormal
-(vector<float>& coord, vector<int>& coordIndex,
+(const vector<float>& coord, const vector<int>& coordIndex,
  int i0, int i1, Vec3f& n, bool normalize) {
   int niF,iV,i;
   Vec3f p,pi,ni,v1,v2;
@@ -188,57 +256,57 @@ void SceneGraphProcessor::_computeFaceNormal
 }
 
 void SceneGraphProcessor::_computeNormalPerFace(IndexedFaceSet& ifs) {
-  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_FACE) return;
-  vector<float>& coord       = ifs.getCoord();
-  vector<int>&   coordIndex  = ifs.getCoordIndex();
-  vector<float>& normal      = ifs.getNormal();
-  vector<int>&   normalIndex = ifs.getNormalIndex();
+  if(_hasCurrentNormal(ifs,IndexedFaceSet::PB_PER_FACE)) return;
+  const vector<float>& coord       = ifs.getCoord();
+  const vector<int>&   coordIndex  = ifs.getCoordIndex();
+  const vector<Index>& faceOffsets = ifs.getFaceOffsets();
+  vector<float>&       normal      = ifs.editNormal();
+  vector<int>&         normalIndex = ifs.editNormalIndex();
   ifs.setNormalPerVertex(false);
   normal.clear();
   normalIndex.clear();
   Vec3f n;
-  int /*iF,*/ i0,i1;
-  for(i0=i1=0;i1<(int)coordIndex.size();i1++) {
-    if(coordIndex[i1]<0) {
-      _computeFaceNormal(coord,coordIndex,i0,i1,n,true);
-      normal.push_back((float)(n[0]));
-      normal.push_back((float)(n[1]));
-      normal.push_back((float)(n[2]));
-      i0=i1+1; /* iF++; */
-    }
+  int iF,nF = (int)faceOffsets.size()-1;
+  for(iF=0;iF<nF;iF++) {
+    _computeFaceNormal(coord,coordIndex,faceOffsets[iF],faceOffsets[iF+1]-1,n,true);
+    normal.push_back((float)(n[0]));
+    normal.push_back((float)(n[1]));
+    normal.push_back((float)(n[2]));
   }
+  _setComputedNormal(ifs);
 }
 
 void SceneGraphProcessor::_computeNormalPerVertex(IndexedFaceSet& ifs) {
-  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_VERTEX) return;
-  vector<float>& coord       = ifs.getCoord();
-  vector<int>&   coordIndex  = ifs.getCoordIndex();
-  vector<float>& normal      = ifs.getNormal();
-  vector<int>&   normalIndex = ifs.getNormalIndex();
+  if(_hasCurrentNormal(ifs,IndexedFaceSet::PB_PER_VERTEX)) return;
+  const vector<float>& coord       = ifs.getCoord();
+  const vector<int>&   coordIndex  = ifs.getCoordIndex();
+  const vector<Index>& faceOffsets = ifs.getFaceOffsets();
+  vector<float>&       normal      = ifs.editNormal();
+  vector<int>&         normalIndex = ifs.editNormalIndex();
   ifs.setNormalPerVertex(true);
   normal.clear();
   normalIndex.clear();
   Vec3f n;
-  int /*iF,*/ nV,i,i0,i1,iV;
+  int iF,nF,nV,i,i0,i1,iV;
   float x0,x1,x2;
   nV = (int)(coord.size()/3);
+  nF = (int)faceOffsets.size()-1;
   // initialize accumulators
   normal.insert(normal.end(),coord.size(),0.0f);
   // accumulate face normals
-  for(i0=i1=0;i1<(int)coordIndex.size();i1++) {
-    if(coordIndex[i1]<0) {
-      _computeFaceNormal(coord,coordIndex,i0,i1,n,false);
-      // accumulate
-      for(i=i0;i<i1;i++) {
-        iV = coordIndex[i];
-        x0 = normal[3*iV  ];
-        x1 = normal[3*iV+1];
-        x2 = normal[3*iV+2];
-        normal[3*iV  ] = x0+((float)(n[0]));
-        normal[3*iV+1] = x1+((float)(n[1]));
-        normal[3*iV+2] = x2+((float)(n[2]));
-      }
-      i0=i1+1; /* iF++; */
+  for(iF=0;iF<nF;iF++) {
+    i0 = faceOffsets[iF];
+    i1 = faceOffsets[iF+1]-1;
+    _computeFaceNormal(coord,coordIndex,i0,i1,n,false);
+    // accumulate
+    for(i=i0;i<i1;i++) {
+      iV = coordIndex[i];
+      x0 = normal[3*iV  ];
+      x1 = normal[3*iV+1];
+      x2 = normal[3*iV+2];
+      normal[3*iV  ] = x0+((float)(n[0]));
+      normal[3*iV+1] = x1+((float)(n[1]));
+      normal[3*iV+2] = x2+((float)(n[2]));
     }
   }
   for(iV=0;iV<nV;iV++) {
@@ -254,84 +322,655 @@ void SceneGraphProcessor::_computeNormalPerVertex(IndexedFaceSet& ifs) {
     normal[3*iV+1] = n[1];
     normal[3*iV+2] = n[2];
   }
+  _setComputedNormal(ifs);
 }
 
 void SceneGraphProcessor::_computeNormalPerCorner(IndexedFaceSet& ifs) {
-  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_CORNER) return;
+  if(_hasCurrentNormal(ifs,IndexedFaceSet::PB_PER_CORNER)) return;
 
-  vector<float>& coord       = ifs.getCoord();
-  vector<int>&   coordIndex  = ifs.getCoordIndex();
-  vector<float>& normal      = ifs.getNormal();
-  vector<int>&   normalIndex = ifs.getNormalIndex();
+  const vector<float>& coord       = ifs.getCoord();
+  const vector<int>&   coordIndex  = ifs.getCoordIndex();
+  const vector<Index>& faceOffsets = ifs.getFaceOffsets();
+  vector<float>&       normal      = ifs.editNormal();
+  vector<int>&         normalIndex = ifs.editNormalIndex();
   ifs.setNormalPerVertex(true);
   normal.clear();
   normalIndex.clear();
 
   Vec3f pP,p0,pN,vP,vN,n;
-  int iF,i,i0,i1,ip,in,nFC,iN,iVp/*,iV0,iVn*/;
-  for(iF=i0=i1=0;i1<(int)coordIndex.size();i1++) {
-    if(coordIndex[i1]<0) {
-      nFC = i1-i0; // number of face corners
+  int iF,nF,i,i0,i1,ip,in,nFC,iN,iVp/*,iV0,iVn*/;
+  nF = (int)faceOffsets.size()-1;
+  for(iF=0;iF<nF;iF++) {
+    i0 = faceOffsets[iF];
+    i1 = faceOffsets[iF+1]-1;
+    nFC = i1-i0; // number of face corners
+    // n << 0,0,0;
+    n[0]=n[1]=n[2]=0.0f;
+    if(nFC>=3) { // polygon
+      for(i=i0;i<i1;i++) {
+        if((ip=i-1)< i0) ip=i1-1;
+        if((in=i+1)==i1) in=i0  ;
+
+        iVp = coordIndex[ip];
+        // iV0 = coordIndex[i ];
+        // iVn = coordIndex[in];
+
+        // pP << coord[3*iVp  ],coord[3*iVp+1],coord[3*iVp+2];
+        pP[0] = coord[3*iVp  ]; pP[1] = coord[3*iVp+1]; pP[2] = coord[3*iVp+2];
+        // p0 << coord[3*iVp  ],coord[3*iVp+1],coord[3*iVp+2];
+        p0[0] = coord[3*iVp  ]; p0[1] = coord[3*iVp+1]; p0[2] = coord[3*iVp+2];
+        // pN << coord[3*iVp  ],coord[3*iVp+1],coord[3*iVp+2];
+        pN[0] = coord[3*iVp  ]; pN[1] = coord[3*iVp+1]; pN[2] = coord[3*iVp+2];
+        // vP = pP-p0;
+        vP[0] = pP[0]-p0[0]; vP[1] = pP[1]-p0[1]; vP[2] = pP[2]-p0[2];
+        // vN = pN-p0;
+        vN[0] = pN[0]-p0[0]; vN[1] = pN[1]-p0[1]; vN[2] = pN[2]-p0[2];
+
+        // n = vN.cross(vP);
+        n[0] = vN[1]*vP[2]-vN[2]*vP[1];
+        n[1] = vN[2]*vP[0]-vN[0]*vP[2];
+        n[2] = vN[0]*vP[1]-vN[1]*vP[0];
+
+        // n.normalize();
+        float nn = n[0]*n[0]+n[1]*n[1]+n[2]*n[2];
+        if(nn>0.0f) {
+          nn = (float)sqrt(nn);
+          n[0] /= nn; n[1] /= nn; n[2] /= nn;
+        }
+
+        iN = (int)(normal.size()/3);
+        normal.push_back(n[0]);
+        normal.push_back(n[1]);
+        normal.push_back(n[2]);
+        normalIndex.push_back(iN);
+
+      }
+      normalIndex.push_back(-1);
+
+    } else /* if(nFC<3) */{ // face with less than 3 vertices
+      // throw exception ?
       // n << 0,0,0;
       n[0]=n[1]=n[2]=0.0f;
-      if(nFC>=3) { // polygon
-        for(i=i0;i<i1;i++) {
-          if((ip=i-1)< i0) ip=i1-1;
-          if((in=i+1)==i1) in=i0  ;
-
-          iVp = coordIndex[ip];
-          // iV0 = coordIndex[i ];
-          // iVn = coordIndex[in];
-
-          // pP << coord[3*iVp  ],coord[3*iVp+1],coord[3*iVp+2];
-          pP[0] = coord[3*iVp  ]; pP[1] = coord[3*iVp+1]; pP[2] = coord[3*iVp+2];
-          // p0 << coord[3*iVp  ],coord[3*iVp+1],coord[3*iVp+2];
-          p0[0] = coord[3*iVp  ]; p0[1] = coord[3*iVp+1]; p0[2] = coord[3*iVp+2];
-          // pN << coord[3*iVp  ],coord[3*iVp+1],coord[3*iVp+2];
-          pN[0] = coord[3*iVp  ]; pN[1] = coord[3*iVp+1]; pN[2] = coord[3*iVp+2];
-          // vP = pP-p0;
-          vP[0] = pP[0]-p0[0]; vP[1] = pP[1]-p0[1]; vP[2] = pP[2]-p0[2];
-          // vN = pN-p0;
-          vN[0] = pN[0]-p0[0]; vN[1] = pN[1]-p0[1]; vN[2] = pN[2]-p0[2];
-
-          // n = vN.cross(vP);
-          n[0] = vN[1]*vP[2]-vN[2]*vP[1];
-          n[1] = vN[2]*vP[0]-vN[0]*vP[2];
-          n[2] = vN[0]*vP[1]-vN[1]*vP[0];
-
-          // n.normalize();
-          float nn = n[0]*n[0]+n[1]*n[1]+n[2]*n[2];
-          if(nn>0.0f) {
-            nn = (float)sqrt(nn);
-            n[0] /= nn; n[1] /= nn; n[2] /= nn;
-          }
+      for(i=i0;i<i1;i++) {
+        iN = (int)(normal.size()/3);
+        normal.push_back(n[0]);
+        normal.push_back(n[1]);
+        normal.push_back(n[2]);
+        normalIndex.push_back(iN);
+      }
+      normalIndex.push_back(-1);
+    }
+  }
+  _setComputedNormal(ifs);
+}
 
-          iN = (int)(normal.size()/3);
-          normal.push_back(n[0]);
-          normal.push_back(n[1]);
-          normal.push_back(n[2]);
-          normalIndex.push_back(iN);
+void SceneGraphProcessor::reorderVerticesMorton() {
+  _applyToIndexedFaceSet(_reorderVerticesMorton);
+}
 
+void SceneGraphProcessor::reorderVerticesHilbert() {
+  _applyToIndexedFaceSet(_reorderVerticesHilbert);
+}
+
+void SceneGraphProcessor::reorderVerticesRcm() {
+  _applyToIndexedFaceSet(_reorderVerticesRcm);
+}
+
+void SceneGraphProcessor::reorderFaces() {
+  _applyToIndexedFaceSet(_reorderFaces);
+}
+
+void SceneGraphProcessor::compact() {
+  _applyToIndexedFaceSet(_compact);
+}
+
+void SceneGraphProcessor::weldVertices() {
+  _applyToIndexedFaceSet(_weldVertices);
+}
+
+// x[k*dim],...,x[k*dim+dim-1] <- x[order[k]*dim],...,x[order[k]*dim+dim-1]
+// for 0<=k<order.size(); order can also select a subset of the records
+template<class T>
+static void _permute(vector<T>& x, const int dim, const vector<int>& order) {
+  vector<T> y(order.size()*dim);
+  int k,j,n = static_cast<int>(order.size());
+  for(k=0;k<n;k++)
+    for(j=0;j<dim;j++)
+      y[k*dim+j] = x[order[k]*dim+j];
+  x.swap(y);
+}
+
+// number of bits per coordinate of the space-filling curve keys
+static const int _curveBits = 21;
+
+static uint64_t _interleave(const uint32_t x[3]) {
+  uint64_t key = 0;
+  for(int b=_curveBits-1;b>=0;b--)
+    for(int j=0;j<3;j++)
+      key = (key<<1)|((x[j]>>b)&1);
+  return key;
+}
+
+static uint64_t _mortonKey(uint32_t x[3]) {
+  return _interleave(x);
+}
+
+// J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707
+// (2004); the coordinates are transformed in place into the
+// transposed Hilbert index, whose bits are then interleaved
+static uint64_t _hilbertKey(uint32_t x[3]) {
+  uint32_t M = 1u<<(_curveBits-1);
+  uint32_t P,Q,t;
+  int j;
+  // inverse undo
+  for(Q=M;Q>1;Q>>=1) {
+    P = Q-1;
+    for(j=0;j<3;j++) {
+      if(x[j]&Q) {
+        x[0] ^= P;
+      } else {
+        t = (x[0]^x[j])&P; x[0] ^= t; x[j] ^= t;
+      }
+    }
+  }
+  // Gray encode
+  for(j=1;j<3;j++)
+    x[j] ^= x[j-1];
+  t = 0;
+  for(Q=M;Q>1;Q>>=1)
+    if(x[2]&Q) t ^= Q-1;
+  for(j=0;j<3;j++)
+    x[j] ^= t;
+  return _interleave(x);
+}
+
+// the Ply elements would also have to be modified
+bool SceneGraphProcessor::_hasPly(IndexedFaceSet& ifs) {
+  return (ifs.getType()=="IndexedFaceSetPly" &&
+          ((IndexedFaceSetPly&)ifs).getPly()!=(Ply*)0);
+}
+
+void SceneGraphProcessor::_spaceFillingCurveOrder
+(IndexedFaceSet& ifs, bool hilbert, vector<int>& vertexOrder) {
+  const vector<float>& coord = ifs.getCoord();
+  int   nV    = ifs.getNumberOfVertices();
+  BBox  bbox(3,coord,true);
+  float side  = bbox.getMaxSide();
+  float qMax  = static_cast<float>((1u<<_curveBits)-1);
+  float scale = (side>0.0f)?qMax/side:0.0f;
+  vector< pair<uint64_t,int> > key(nV);
+  uint32_t x[3];
+  int iV,j;
+  for(iV=0;iV<nV;iV++) {
+    for(j=0;j<3;j++) {
+      float q = (coord[3*iV+j]-bbox.getMin(j))*scale;
+      x[j] = (q<=0.0f)?0u:(q>=qMax)?(1u<<_curveBits)-1:static_cast<uint32_t>(q);
+    }
+    key[iV] = make_pair((hilbert)?_hilbertKey(x):_mortonKey(x),iV);
+  }
+  sort(key.begin(),key.end());
+  vertexOrder.resize(nV);
+  for(iV=0;iV<nV;iV++)
+    vertexOrder[iV] = key[iV].second;
+}
+
+void SceneGraphProcessor::_reorderVerticesMorton(IndexedFaceSet& ifs) {
+  if(_hasPly(ifs)) return;
+  vector<int> vertexOrder;
+  _spaceFillingCurveOrder(ifs,false,vertexOrder);
+  _reorderVertices(ifs,vertexOrder);
+}
+
+void SceneGraphProcessor::_reorderVerticesHilbert(IndexedFaceSet& ifs) {
+  if(_hasPly(ifs)) return;
+  vector<int> vertexOrder;
+  _spaceFillingCurveOrder(ifs,true,vertexOrder);
+  _reorderVertices(ifs,vertexOrder);
+}
+
+void SceneGraphProcessor::_reorderVerticesRcm(IndexedFaceSet& ifs) {
+  if(_hasPly(ifs)) return;
+  const vector<int>& coordIndex = ifs.getCoordIndex();
+  int nV = ifs.getNumberOfVertices();
+
+  // graph of mesh edges; out of range and repeated vertex indices
+  // are rejected by Graph::insertEdge()
+  Graph graph(nV);
+  int i,i0,i1;
+  for(i0=i1=0;i1<(int)coordIndex.size();i1++) {
+    if(coordIndex[i1]<0) {
+      for(i=i0;i<i1;i++)
+        graph.insertEdge(coordIndex[i],coordIndex[(i+1<i1)?i+1:i0]);
+      i0=i1+1;
+    }
+  }
+  CsrGraph csr;
+  csr.buildGraph(graph);
+  auto byDegree = [&csr](const int iV0, const int iV1) {
+    return (csr.getNumberOfNeighbors(iV0)<csr.getNumberOfNeighbors(iV1));
+  };
+
+  // one Cuthill-McKee traversal per connected component, starting
+  // from the unvisited vertex of smallest degree; the vertexOrder
+  // array is used as the breadth-first search queue
+  vector<int> start(nV);
+  for(int iV=0;iV<nV;iV++) start[iV] = iV;
+  stable_sort(start.begin(),start.end(),byDegree);
+  vector<int>  vertexOrder;
+  vector<int>  neighbor;
+  vector<bool> visited(nV,false);
+  vertexOrder.reserve(nV);
+  for(int iS=0;iS<nV;iS++) {
+    if(visited[start[iS]]) continue;
+    size_t head = vertexOrder.size();
+    visited[start[iS]] = true;
+    vertexOrder.push_back(start[iS]);
+    while(head<vertexOrder.size()) {
+      int iV = vertexOrder[head++];
+      int nN = static_cast<int>(csr.getNumberOfNeighbors(iV));
+      neighbor.clear();
+      for(int j=0;j<nN;j++) {
+        int iN = static_cast<int>(csr.getNeighbor(iV,j));
+        if(visited[iN]==false) {
+          visited[iN] = true;
+          neighbor.push_back(iN);
         }
-        normalIndex.push_back(-1);
-
-      } else /* if(nFC<3) */{ // face with less than 3 vertices
-        // throw exception ?
-        // n << 0,0,0;
-        n[0]=n[1]=n[2]=0.0f;
-        for(i=i0;i<i1;i++) {
-          iN = (int)(normal.size()/3);
-          normal.push_back(n[0]);
-          normal.push_back(n[1]);
-          normal.push_back(n[2]);
-          normalIndex.push_back(iN);
-        }
-        normalIndex.push_back(-1);
       }
+      stable_sort(neighbor.begin(),neighbor.end(),byDegree);
+      vertexOrder.insert(vertexOrder.end(),neighbor.begin(),neighbor.end());
+    }
+  }
+  reverse(vertexOrder.begin(),vertexOrder.end());
+  _reorderVertices(ifs,vertexOrder);
+}
 
-      i0=i1+1; iF++;
+void SceneGraphProcessor::_reorderVertices
+(IndexedFaceSet& ifs, const vector<int>& vertexOrder) {
+  int nV = ifs.getNumberOfVertices();
+  if((int)vertexOrder.size()!=nV) return;
+  vector<int> newIndex(nV);
+  for(int iV=0;iV<nV;iV++)
+    newIndex[vertexOrder[iV]] = iV;
+  vector<int>& coordIndex = ifs.editCoordIndex();
+  for(int i=0;i<(int)coordIndex.size();i++) {
+    int iV = coordIndex[i];
+    if(0<=iV && iV<nV) coordIndex[i] = newIndex[iV];
+  }
+  _permute(ifs.editCoord(),3,vertexOrder);
+  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfNormal()==nV)
+    _permute(ifs.editNormal(),3,vertexOrder);
+  if(ifs.getColorBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfColor()==nV)
+    _permute(ifs.editColor(),3,vertexOrder);
+  if(ifs.getTexCoordBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfTexCoord()==nV)
+    _permute(ifs.editTexCoord(),2,vertexOrder);
+}
+
+void SceneGraphProcessor::_reorderFaces(IndexedFaceSet& ifs) {
+  if(_hasPly(ifs)) return;
+  // the face offsets are read while the arrays are modified
+  IndexedFaceSet::Mutation mutation(ifs,IndexedFaceSet::ALL_ARRAYS_MASK);
+  const vector<Index>& faceFirst = ifs.getFaceOffsets();
+  vector<int>& coordIndex = ifs.editCoordIndex();
+  int nCI = static_cast<int>(coordIndex.size());
+
+  // faceFirst[iF] is the position of the first corner of face iF in
+  // coordIndex; corners after the last face separator stay at the end
+  int nF = static_cast<int>(faceFirst.size())-1;
+  vector<int> faceKey(nF,INT_MAX);
+  for(int iF=0;iF<nF;iF++)
+    for(int i=faceFirst[iF];i<faceFirst[iF+1]-1;i++)
+      if(coordIndex[i]<faceKey[iF]) faceKey[iF] = coordIndex[i];
+  vector<int> faceOrder(nF);
+  for(int iF=0;iF<nF;iF++) faceOrder[iF] = iF;
+  stable_sort(faceOrder.begin(),faceOrder.end(),
+              [&faceKey](const int iF0, const int iF1) {
+                return (faceKey[iF0]<faceKey[iF1]);
+              });
+
+  // arrays with the same face structure as coordIndex
+  auto reorderCorners = [&](vector<int>& index) {
+    if((int)index.size()!=nCI) return;
+    vector<int> reordered;
+    reordered.reserve(nCI);
+    for(int iF=0;iF<nF;iF++) {
+      int jF = faceOrder[iF];
+      reordered.insert(reordered.end(),
+                       index.begin()+faceFirst[jF],index.begin()+faceFirst[jF+1]);
     }
+    reordered.insert(reordered.end(),index.begin()+faceFirst[nF],index.end());
+    index.swap(reordered);
+  };
+
+  switch(ifs.getNormalBinding()) {
+  case IndexedFaceSet::PB_PER_FACE:
+    if(ifs.getNumberOfNormal()==nF) _permute(ifs.editNormal(),3,faceOrder);
+    break;
+  case IndexedFaceSet::PB_PER_FACE_INDEXED:
+    if((int)ifs.getNormalIndex().size()==nF)
+      _permute(ifs.editNormalIndex(),1,faceOrder);
+    break;
+  case IndexedFaceSet::PB_PER_CORNER:
+    reorderCorners(ifs.editNormalIndex());
+    break;
+  default:
+    break;
+  }
+  switch(ifs.getColorBinding()) {
+  case IndexedFaceSet::PB_PER_FACE:
+    if(ifs.getNumberOfColor()==nF) _permute(ifs.editColor(),3,faceOrder);
+    break;
+  case IndexedFaceSet::PB_PER_FACE_INDEXED:
+    if((int)ifs.getColorIndex().size()==nF)
+      _permute(ifs.editColorIndex(),1,faceOrder);
+    break;
+  case IndexedFaceSet::PB_PER_CORNER:
+    reorderCorners(ifs.editColorIndex());
+    break;
+  default:
+    break;
   }
+  if(ifs.getTexCoordBinding()==IndexedFaceSet::PB_PER_CORNER)
+    reorderCorners(ifs.editTexCoordIndex());
+  reorderCorners(coordIndex);
+}
+
+void SceneGraphProcessor::_compact(IndexedFaceSet& ifs) {
+  if(_hasPly(ifs)) return;
+  vector<int>& coordIndex = ifs.editCoordIndex();
+  int nV  = ifs.getNumberOfVertices();
+  int nCI = static_cast<int>(coordIndex.size());
+
+  // 1) parallel reduction : largest vertex index, and number of face
+  //    separators within each range of coordIndex
+  int nRanges = static_cast<int>(Parallel::getNumberOfRanges(nCI));
+  vector<int> firstFace(nRanges+1,0);
+  vector<int> maxVertex(nRanges,-1);
+  Parallel::forRanges(nCI,[&](Index iR, Index i0, Index i1) {
+    int nF = 0, iVmax = -1;
+    for(Index i=i0;i<i1;i++) {
+      if(coordIndex[i]<0)          nF++;
+      else if(coordIndex[i]>iVmax) iVmax = coordIndex[i];
+    }
+    firstFace[iR+1] = nF;
+    maxVertex[iR]   = iVmax;
+  });
+  int iVmax = -1;
+  for(int iR=0;iR<nRanges;iR++) {
+    firstFace[iR+1] += firstFace[iR];
+    if(maxVertex[iR]>iVmax) iVmax = maxVertex[iR];
+  }
+  // vertex indices are only checked per corner if some are too large
+  bool checkRange = (iVmax>=nV);
+  // the last face may not be terminated by a separator
+  bool lastOpen = (nCI>0 && coordIndex[nCI-1]>=0);
+  int  nF = firstFace[nRanges]+((lastOpen)?1:0);
+
+  // 2) face iF occupies the positions faceEnd[iF]<i<faceEnd[iF+1] of
+  //    coordIndex
+  vector<int> faceEnd(nF+1);
+  faceEnd[0] = -1;
+  if(lastOpen) faceEnd[nF] = nCI;
+  Parallel::forRanges(nCI,[&](Index iR, Index i0, Index i1) {
+    int iF = firstFace[iR];
+    for(Index i=i0;i<i1;i++)
+      if(coordIndex[i]<0) faceEnd[++iF] = static_cast<int>(i);
+  });
+
+  // a corner is kept if its vertex is different from the vertex of
+  // the next corner of the face
+  auto keepCorner = [&coordIndex](const int i, const int i0, const int i1) {
+    return (coordIndex[i]!=coordIndex[(i+1<i1)?i+1:i0]);
+  };
+
+  // 3) number of kept corners of each face, or 0 if the face is
+  //    removed, and number of kept faces and of output positions
+  //    within each range of faces
+  int nFRanges = static_cast<int>(Parallel::getNumberOfRanges(nF));
+  vector<int> faceSize(nF);
+  vector<int> firstKeptFace(nFRanges+1,0);
+  vector<int> firstOut(nFRanges+1,0);
+  Parallel::forRanges(nF,[&](Index iR, Index iF0, Index iF1) {
+    int nKept = 0, nOut = 0;
+    for(Index iF=iF0;iF<iF1;iF++) {
+      int  i0 = faceEnd[iF]+1, i1 = faceEnd[iF+1];
+      int  nCF = 0;
+      bool valid = true;
+      for(int i=i0;i<i1;i++) {
+        if(checkRange && coordIndex[i]>=nV) valid = false;
+        if(keepCorner(i,i0,i1)) nCF++;
+      }
+      faceSize[iF] = (valid && nCF>=3)?nCF:0;
+      if(faceSize[iF]>0) {
+        nKept++;
+        nOut += faceSize[iF]+1;
+      }
+    }
+    firstKeptFace[iR+1] = nKept;
+    firstOut[iR+1]      = nOut;
+  });
+  for(int iR=0;iR<nFRanges;iR++) {
+    firstKeptFace[iR+1] += firstKeptFace[iR];
+    firstOut[iR+1]      += firstOut[iR];
+  }
+
+  // arrays with the same face structure as coordIndex
+  vector<vector<int>*> cornerArray(1,&coordIndex);
+  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_CORNER &&
+     (int)ifs.getNormalIndex().size()==nCI)
+    cornerArray.push_back(&ifs.editNormalIndex());
+  if(ifs.getColorBinding()==IndexedFaceSet::PB_PER_CORNER &&
+     (int)ifs.getColorIndex().size()==nCI)
+    cornerArray.push_back(&ifs.editColorIndex());
+  if(ifs.getTexCoordBinding()==IndexedFaceSet::PB_PER_CORNER &&
+     (int)ifs.getTexCoordIndex().size()==nCI)
+    cornerArray.push_back(&ifs.editTexCoordIndex());
+  int nArrays = static_cast<int>(cornerArray.size());
+
+  // 4) copy the kept corners, and mark the referenced vertices
+  vector< vector<int> > out(nArrays,vector<int>(firstOut[nFRanges]));
+  vector<int> keptFace(firstKeptFace[nFRanges]);
+  vector<atomic<char>> referenced(nV);
+  for(int iV=0;iV<nV;iV++) referenced[iV].store(0,memory_order_relaxed);
+  Parallel::forRanges(nF,[&](Index iR, Index iF0, Index iF1) {
+    int iOut = firstOut[iR];
+    int jF   = firstKeptFace[iR];
+    for(Index iF=iF0;iF<iF1;iF++) {
+      if(faceSize[iF]==0) continue;
+      int i0 = faceEnd[iF]+1, i1 = faceEnd[iF+1];
+      for(int i=i0;i<i1;i++) {
+        if(keepCorner(i,i0,i1)==false) continue;
+        for(int a=0;a<nArrays;a++)
+          out[a][iOut] = (*cornerArray[a])[i];
+        referenced[coordIndex[i]].store(1,memory_order_relaxed);
+        iOut++;
+      }
+      for(int a=0;a<nArrays;a++)
+        out[a][iOut] = -1;
+      iOut++;
+      keptFace[jF++] = static_cast<int>(iF);
+    }
+  });
+  for(int a=0;a<nArrays;a++)
+    cornerArray[a]->swap(out[a]);
+
+  // data bound per face
+  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_FACE &&
+     ifs.getNumberOfNormal()==nF)
+    _permute(ifs.editNormal(),3,keptFace);
+  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_FACE_INDEXED &&
+     (int)ifs.getNormalIndex().size()==nF)
+    _permute(ifs.editNormalIndex(),1,keptFace);
+  if(ifs.getColorBinding()==IndexedFaceSet::PB_PER_FACE &&
+     ifs.getNumberOfColor()==nF)
+    _permute(ifs.editColor(),3,keptFace);
+  if(ifs.getColorBinding()==IndexedFaceSet::PB_PER_FACE_INDEXED &&
+     (int)ifs.getColorIndex().size()==nF)
+    _permute(ifs.editColorIndex(),1,keptFace);
+
+  // 5) number the referenced vertices in their original order, and
+  //    remap coordIndex and the data bound per vertex
+  vector<int> newIndex(nV,-1);
+  vector<int> keptVertex;
+  for(int iV=0;iV<nV;iV++) {
+    if(referenced[iV].load(memory_order_relaxed)==0) continue;
+    newIndex[iV] = static_cast<int>(keptVertex.size());
+    keptVertex.push_back(iV);
+  }
+  if((int)keptVertex.size()==nV) return;
+  Parallel::forRanges(static_cast<Index>(coordIndex.size()),
+                      [&](Index /*iR*/, Index i0, Index i1) {
+    for(Index i=i0;i<i1;i++)
+      if(coordIndex[i]>=0) coordIndex[i] = newIndex[coordIndex[i]];
+  });
+  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfNormal()==nV)
+    _permute(ifs.editNormal(),3,keptVertex);
+  if(ifs.getColorBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfColor()==nV)
+    _permute(ifs.editColor(),3,keptVertex);
+  if(ifs.getTexCoordBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfTexCoord()==nV)
+    _permute(ifs.editTexCoord(),2,keptVertex);
+  _permute(ifs.editCoord(),3,keptVertex);
+}
+
+// grid cell of a vertex; with epsilon==0 the cell is the bit pattern
+// of the coordinates, with -0 replaced by +0; with epsilon>0 a NaN or
+// infinite coordinate has no grid cell, and its bit pattern is offset
+// below the clamped grid range, so that it only welds to the same
+// non-finite value
+struct _WeldCell {
+  int64_t x[3];
+  bool operator==(const _WeldCell& c) const {
+    return (x[0]==c.x[0] && x[1]==c.x[1] && x[2]==c.x[2]);
+  }
+};
+
+struct _WeldCellHash {
+  size_t operator()(const _WeldCell& c) const {
+    uint64_t h = 0x9e3779b97f4a7c15ull;
+    for(int j=0;j<3;j++) {
+      h ^= static_cast<uint64_t>(c.x[j]);
+      h *= 0xff51afd7ed558ccdull;
+      h ^= h>>33;
+    }
+    return static_cast<size_t>(h);
+  }
+};
+
+static _WeldCell _weldCell(const float* p, const float epsilon) {
+  _WeldCell c;
+  for(int j=0;j<3;j++) {
+    if(epsilon>0.0f && isfinite(p[j])) {
+      double q = floor(static_cast<double>(p[j])/epsilon+0.5);
+      if(q> 9.0e18) q =  9.0e18;
+      if(q<-9.0e18) q = -9.0e18;
+      c.x[j] = static_cast<int64_t>(q);
+    } else {
+      float f = (p[j]==0.0f)?0.0f:p[j];
+      int32_t b;
+      memcpy(&b,&f,4);
+      c.x[j] = b;
+      if(epsilon>0.0f)
+        c.x[j] = INT64_MIN+static_cast<int64_t>(static_cast<uint32_t>(b));
+    }
+  }
+  return c;
+}
+
+void SceneGraphProcessor::_weldVertices(IndexedFaceSet& ifs) {
+  weldVertices(ifs,_weldEpsilon);
+}
+
+void SceneGraphProcessor::weldVertices(IndexedFaceSet& ifs, const float epsilon) {
+  if(_hasPly(ifs)) return;
+  const vector<float>& coord = ifs.getCoord();
+  int nV = ifs.getNumberOfVertices();
+  if(nV<=1) return;
+
+  // 1) cell and hash value of every vertex, and number of vertices of
+  //    each range in each hash partition
+  int nParts = static_cast<int>(Parallel::getNumberOfRanges(nV));
+  vector<_WeldCell> cell(nV);
+  vector<int>       part(nV);
+  vector<int>       count(static_cast<size_t>(nParts)*nParts,0);
+  _WeldCellHash     hash;
+  Parallel::forRanges(nV,[&](Index iR, Index i0, Index i1) {
+    int* countR = &count[static_cast<size_t>(iR)*nParts];
+    for(Index iV=i0;iV<i1;iV++) {
+      cell[iV] = _weldCell(&coord[3*iV],epsilon);
+      part[iV] = static_cast<int>(hash(cell[iV])%nParts);
+      countR[part[iV]]++;
+    }
+  });
+
+  // 2) scatter the vertices by partition; within a partition the
+  //    vertices stay sorted by index
+  vector<int> partFirst(nParts+1,0);
+  vector<int> offset(static_cast<size_t>(nParts)*nParts);
+  for(int iP=0,n=0;iP<nParts;iP++) {
+    partFirst[iP] = n;
+    for(int iR=0;iR<nParts;iR++) {
+      offset[static_cast<size_t>(iR)*nParts+iP] = n;
+      n += count[static_cast<size_t>(iR)*nParts+iP];
+    }
+    partFirst[iP+1] = n;
+  }
+  vector<int> partVertex(nV);
+  Parallel::forRanges(nV,[&](Index iR, Index i0, Index i1) {
+    int* offsetR = &offset[static_cast<size_t>(iR)*nParts];
+    for(Index iV=i0;iV<i1;iV++)
+      partVertex[offsetR[part[iV]]++] = static_cast<int>(iV);
+  });
+
+  // 3) each partition is hashed independently; the representative of
+  //    a cell is its vertex of smallest index, so that the result does
+  //    not depend on the number of threads
+  vector<int> rep(nV);
+  Parallel::forRanges(nParts,[&](Index /*iR*/, Index iP0, Index iP1) {
+    unordered_map<_WeldCell,int,_WeldCellHash> first;
+    for(Index iP=iP0;iP<iP1;iP++) {
+      first.clear();
+      first.reserve(partFirst[iP+1]-partFirst[iP]);
+      for(int k=partFirst[iP];k<partFirst[iP+1];k++) {
+        int iV = partVertex[k];
+        rep[iV] = first.emplace(cell[iV],iV).first->second;
+      }
+    }
+  });
+
+  // 4) the representatives keep their relative order
+  vector<int> newIndex(nV,-1);
+  vector<int> keptVertex;
+  for(int iV=0;iV<nV;iV++)
+    if(rep[iV]==iV) {
+      newIndex[iV] = static_cast<int>(keptVertex.size());
+      keptVertex.push_back(iV);
+    }
+  if((int)keptVertex.size()==nV) return;
+  for(int iV=0;iV<nV;iV++)
+    newIndex[iV] = newIndex[rep[iV]];
+
+  vector<int>& coordIndex = ifs.editCoordIndex();
+  Parallel::forRanges(static_cast<Index>(coordIndex.size()),
+                      [&](Index /*iR*/, Index i0, Index i1) {
+    for(Index i=i0;i<i1;i++)
+      if(0<=coordIndex[i] && coordIndex[i]<nV)
+        coordIndex[i] = newIndex[coordIndex[i]];
+  });
+  if(ifs.getNormalBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfNormal()==nV)
+    _permute(ifs.editNormal(),3,keptVertex);
+  if(ifs.getColorBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfColor()==nV)
+    _permute(ifs.editColor(),3,keptVertex);
+  if(ifs.getTexCoordBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+     ifs.getNumberOfTexCoord()==nV)
+    _permute(ifs.editTexCoord(),2,keptVertex);
+  _permute(ifs.editCoord(),3,keptVertex);
 }
 
 void SceneGraphProcessor::bboxAdd
@@ -365,10 +1004,10 @@ void SceneGraphProcessor::bboxAdd
   }
   if(ils==(IndexedLineSet*)0) { /* throw exception ??? */ return; }
 
-  vector<float>& coord      = ils->getCoord();
-  vector<int>&   coordIndex = ils->getCoordIndex();
-  vector<float>& color      = ils->getColor();
-  vector<int>&   colorIndex = ils->getColorIndex();
+  vector<float>& coord      = ils->editCoord();
+  vector<int>&   coordIndex = ils->editCoordIndex();
+  vector<float>& color      = ils->editColor();
+  vector<int>&   colorIndex = ils->editColorIndex();
   coord.clear();
   coordIndex.clear();
   color.clear();
@@ -540,34 +1179,27 @@ void SceneGraphProcessor::edgesAdd() {
 
         ils->clear();
 
-        vector<float>& coordIfs      = ifs->getCoord();
-        vector<int>&   coordIndexIfs = ifs->getCoordIndex();
-
-        vector<float>& coordIls      = ils->getCoord();
-        vector<int>&   coordIndexIls = ils->getCoordIndex();
-
-        coordIls.insert(coordIls.end(),
-                        coordIfs.begin(),coordIfs.end());
-
-        int i,i0,i1,nV,iV,iV0,iV1,iF;
-        nV = static_cast<int>(coordIfs.size()/3);
-        for(iV=0;iV<nV;iV++) {
-          coordIls.push_back(coordIfs[3*iV  ]);
-          coordIls.push_back(coordIfs[3*iV+1]);
-          coordIls.push_back(coordIfs[3*iV+2]);
-        }
-
-        for(iF=i0=i1=0;i1<(int)coordIndexIfs.size();i1++) {
-          if(coordIndexIfs[i1]<0) {
-            iV0 = coordIndexIfs[i1-1];
-            for(i=i0;i<i1;i++) {
-              iV1 = coordIndexIfs[i];
-              coordIndexIls.push_back(iV0);
-              coordIndexIls.push_back(iV1);
-              coordIndexIls.push_back(-1);
-              iV0 = iV1;
-            }
-            iF++; i0 = i1+1;
+        const vector<int>&   coordIndexIfs = ifs->getCoordIndex();
+        const vector<Index>& faceOffsets   = ifs->getFaceOffsets();
+
+        // the IndexedLineSet shares the coord array of the
+        // IndexedFaceSet, until one of them modifies it
+        ils->setSharedCoord(ifs->getSharedCoord());
+        vector<int>&   coordIndexIls = ils->editCoordIndex();
+
+        int i,i0,i1,iV0,iV1,iF;
+
+        int nF = static_cast<int>(faceOffsets.size())-1;
+        for(iF=0;iF<nF;iF++) {
+          i0 = faceOffsets[iF];
+          i1 = faceOffsets[iF+1]-1;
+          iV0 = coordIndexIfs[i1-1];
+          for(i=i0;i<i1;i++) {
+            iV1 = coordIndexIfs[i];
+            coordIndexIls.push_back(iV0);
+            coordIndexIls.push_back(iV1);
+            coordIndexIls.push_back(-1);
+            iV0 = iV1;
           }
         }
 
@@ -801,12 +1433,12 @@ bool SceneGraphProcessor::hasIndexedFaceSetNormalPerCorner() {
 // Material shall be used to draw the lines.
 
  bool SceneGraphProcessor::_hasColorNone(IndexedLineSet& ils) {
-  vector<float>& color         = ils.getColor();
+  const vector<float>& color         = ils.getColor();
   return (color.size()==0);
 }
 
  bool SceneGraphProcessor::_hasColorPerVertex(IndexedLineSet& ils) {
-  vector<float>& color         = ils.getColor();
+  const vector<float>& color         = ils.getColor();
   // vector<int>&   colorIndex    = ils.getColorIndex();
   bool           colorPerVerex = ils.getColorPerVertex();
   // not testing for errors, but
@@ -818,7 +1450,7 @@ bool SceneGraphProcessor::hasIndexedFaceSetNormalPerCorner() {
 }
 
  bool SceneGraphProcessor::_hasColorPerPolyline(IndexedLineSet& ils) {
-  vector<float>& color         = ils.getColor();
+  const vector<float>& color         = ils.getColor();
   // vector<int>&   colorIndex    = ils.getColorIndex();
   bool           colorPerVerex = ils.getColorPerVertex();
   // not testing for errors, but
@@ -36,10 +36,13 @@
 #define _SceneGraphProcessor_hpp_
 
 #include <iostream>
+#include <memory>
 #include "SceneGraph.hpp"
 #include "Shape.hpp"
 #include "IndexedFaceSet.hpp"
 #include "IndexedLineSet.hpp"
+
+class PolygonMesh;
 
 class SceneGraphProcessor {
 
@@ -54,6 +57,46 @@ public:
   void computeNormalPerVertex();
   void computeNormalPerCorner();
 
+  // renumber the vertices of every IndexedFaceSet to improve the
+  // locality of the coord accesses, remapping coordIndex and the
+  // normal, color and texCoord arrays bound per vertex
+  // - Morton and Hilbert : along a space-filling curve traversing
+  //   the bounding box of the vertex coordinates
+  // - Rcm : reverse Cuthill-McKee order over the graph of mesh edges
+  // IndexedFaceSetPly nodes attached to a Ply are not modified
+  void reorderVerticesMorton();
+  void reorderVerticesHilbert();
+  void reorderVerticesRcm();
+
+  // sort the faces of every IndexedFaceSet by their smallest vertex
+  // index, preserving the relative order of faces with equal keys,
+  // and moving the normal, color and texCoord data bound per face or
+  // per corner along with the faces
+  void reorderFaces();
+
+  // validate and compact every IndexedFaceSet: corners repeating the
+  // vertex of the next corner of the face are removed, faces left
+  // with less than three corners or with out of range vertex indices
+  // are removed, and the vertices not referenced by any remaining
+  // face are removed; the normal, color and texCoord data bound per
+  // vertex, per face or per corner are updated accordingly, and the
+  // last face is always terminated by a -1 separator
+  // IndexedFaceSetPly nodes attached to a Ply are not modified
+  void compact();
+
+  // merge the coincident vertices of every IndexedFaceSet, such as
+  // the three separate vertices per triangle of an STL file; vertices
+  // are merged if their coordinates round to the same point of a grid
+  // of side epsilon, or, if epsilon==0, if their coordinates are
+  // equal; the vertex of smallest index of each group is kept, and
+  // the data bound per vertex is taken from it; faces which become
+  // degenerate are not removed, see compact()
+  // IndexedFaceSetPly nodes attached to a Ply are not modified
+  void weldVertices();
+  static void  weldVertices(IndexedFaceSet& ifs, const float epsilon);
+  static void  setWeldEpsilon(const float epsilon);
+  static float getWeldEpsilon();
+
   void bboxAdd(int depth=0, float scale=1.0f, bool isCube=true);
   void bboxRemove();
   bool hasBBox();
@@ -86,11 +129,21 @@ public:
   void pointsRemove();
   void surfaceRemove();
 
+  // PolygonMesh of the IndexedFaceSet, stored in one of its cache
+  // slots, and rebuilt only after the coordIndex array, or the number
+  // of vertices, change
+  // - the returned pointer keeps the mesh, and the coordIndex array it
+  //   was built from, alive after the node changes or is deleted
+  // - the mesh computes some of its tables on first use, so threads
+  //   sharing it must not issue their first queries concurrently
+  static shared_ptr<const PolygonMesh> getPolygonMesh(const IndexedFaceSet& ifs);
 
 private:
 
   SceneGraph&    _wrl;
 
+  static float   _weldEpsilon;
+
   void        _applyToIndexedFaceSet(IndexedFaceSet::Operator p);
 
   // IndexedFaceSet::Operator
@@ -100,10 +153,27 @@ private:
   static void _computeNormalPerVertex(IndexedFaceSet& ifs);
   static void _computeNormalPerCorner(IndexedFaceSet& ifs);
 
+  static bool _hasCurrentNormal
+              (IndexedFaceSet& ifs, IndexedFaceSet::Binding binding);
+  static void _setComputedNormal(IndexedFaceSet& ifs);
   static void _computeFaceNormal
-              (vector<float>& coord, vector<int>&   coordIndex,
+              (const vector<float>& coord, const vector<int>& coordIndex,
                int i0, int i1, Vec3f& n, bool normalize);
 
+  static void _reorderVerticesMorton(IndexedFaceSet& ifs);
+  static void _reorderVerticesHilbert(IndexedFaceSet& ifs);
+  static void _reorderVerticesRcm(IndexedFaceSet& ifs);
+  static void _reorderFaces(IndexedFaceSet& ifs);
+
+  static void _compact(IndexedFaceSet& ifs);
+  static void _weldVertices(IndexedFaceSet& ifs);
+
+  static bool _hasPly(IndexedFaceSet& ifs);
+  static void _spaceFillingCurveOrder
+              (IndexedFaceSet& ifs, bool hilbert, vector<int>& vertexOrder);
+  static void _reorderVertices
+              (IndexedFaceSet& ifs, const vector<int>& vertexOrder);
+
   bool        _hasShapeProperty(Shape::Property p);
   bool        _hasIndexedFaceSetProperty(IndexedFaceSet::Property p);
   bool        _hasIndexedLineSetProperty(IndexedLineSet::Property p);